@@ -19,10 +19,25 @@ Please see the license file at the root of this repository, or at:
 #include <iostream>
 #include <stdexcept>
 
+#include "field_io.h"
+
 void print_usage() {
   std::printf("Usage: apptest_cmp file_gold file abs_eps [rel_eps=abs_eps]\n");
+  std::printf("Files are either text files of 'gid value' lines, GMV files\n"
+              "or binary field files.\n");
 }
 
+// field values of a text file, in file order
+struct text_field_t {
+  std::vector<int> gids;
+  std::vector<double> values;
+
+  std::size_t size() const { return gids.size(); }
+  int gid(std::size_t i) const { return gids[i]; }
+  int matid(std::size_t) const { return 0; }
+  double value(std::size_t i) const { return values[i]; }
+};
+
 void load_field(std::iostream &s, std::vector<int> &gid,
                 std::vector<double> &values) {
   int g;
@@ -62,63 +77,80 @@ void load_gmv_field(std::iostream &s, std::vector<int> &gid,
 }
 
 
-int main(int argc, char** argv) {
-  if (argc < 4 || argc > 5) {
-    print_usage();
-    return 1;
-  }
-  double abs_eps = std::stod(argv[3]);
-  double rel_eps = (argc == 5) ? std::stod(argv[4]) : abs_eps;
-
-  std::fstream f1(argv[1]), f2(argv[2]);
-  if (!f1) throw std::runtime_error("First file cannot be opened.");
-  if (!f2) throw std::runtime_error("Second file cannot be opened.");
+// compare two fields entry by entry
+template<class Field>
+void compare(Field const& field1, Field const& field2,
+             double abs_eps, double rel_eps) {
 
-  std::vector<int> gid1, gid2;
-  std::vector<double> values1, values2;
-  std::string file_name = argv[1];
-  if (file_name.find(".gmv") != std::string::npos) {
-    load_gmv_field(f1, gid1, values1);
-    load_gmv_field(f2, gid2, values2);
-  }
-  else {
-    load_field(f1, gid1, values1);
-    load_field(f2, gid2, values2);
-  }
-
-  std::cout << std::scientific;
-  std::cout.precision(17);
-  std::cout << "Comparing files: " << argv[1] << " " << argv[2] << std::endl;
-  std::cout << "Absolute Epsilon: " << abs_eps << std::endl;
-  std::cout << "Relative Epsilon: " << rel_eps << std::endl;
-  std::cout << "Field sizes: " << gid1.size() << " " << gid2.size() <<
+  std::cout << "Field sizes: " << field1.size() << " " << field2.size() <<
     std::endl;
-  if (gid1.size() != gid2.size()) {
+  if (field1.size() != field2.size()) {
     throw std::runtime_error("The field sizes do not match.");
   }
   double delta, maxval;
-  int const nb_gids = gid1.size();
+  int const nb_gids = field1.size();
 
   for (int i=0; i < nb_gids; i++) {
-    if (gid1[i] != gid2[i]) {
-      std::cout << i << " " << gid1[i] << " " << gid2[i] << std::endl;
+    if (field1.gid(i) != field2.gid(i) || field1.matid(i) != field2.matid(i)) {
+      std::cout << i << " " << field1.gid(i) << " " << field2.gid(i) << std::endl;
       throw std::runtime_error("The field global IDs do not match.");
     }
+    double const value1 = field1.value(i);
+    double const value2 = field2.value(i);
     // Test absolute tolerance
-    delta = std::abs(values1[i] - values2[i]);
+    delta = std::abs(value1 - value2);
     if (delta <= abs_eps)
       continue;
     // Still might be the same if within the relative tolerance
-    maxval = (std::abs(values1[i]) > std::abs(values2[i])) ?
-      values1[i] : values2[i];
+    maxval = (std::abs(value1) > std::abs(value2)) ? value1 : value2;
     if ((delta / std::abs(maxval)) <= rel_eps)
       continue;
     // Fails -- abort
-    std::cout << i << " " << values1[i] << " " << values2[i]
+    std::cout << i << " " << value1 << " " << value2
               << " Abs Err: " << delta
               << " Rel Err: " << delta/std::abs(maxval) << std::endl;
     throw std::runtime_error("The field values do not match.");
   }
+}
+
+
+int main(int argc, char** argv) {
+  if (argc < 4 || argc > 5) {
+    print_usage();
+    return 1;
+  }
+  double abs_eps = std::stod(argv[3]);
+  double rel_eps = (argc == 5) ? std::stod(argv[4]) : abs_eps;
+
+  std::fstream f1(argv[1]), f2(argv[2]);
+  if (!f1) throw std::runtime_error("First file cannot be opened.");
+  if (!f2) throw std::runtime_error("Second file cannot be opened.");
+
+  std::cout << std::scientific;
+  std::cout.precision(17);
+  std::cout << "Comparing files: " << argv[1] << " " << argv[2] << std::endl;
+  std::cout << "Absolute Epsilon: " << abs_eps << std::endl;
+  std::cout << "Relative Epsilon: " << rel_eps << std::endl;
+
+  // binary files are mapped and already sorted by global id
+  if (field_io::is_binary_file(argv[1]) || field_io::is_binary_file(argv[2])) {
+    field_io::sorted_field_t const field1(argv[1], false), field2(argv[2], false);
+    compare(field1, field2, abs_eps, rel_eps);
+    return 0;
+  }
+
+  text_field_t field1, field2;
+  std::string file_name = argv[1];
+  if (file_name.find(".gmv") != std::string::npos) {
+    load_gmv_field(f1, field1.gids, field1.values);
+    load_gmv_field(f2, field2.gids, field2.values);
+  }
+  else {
+    load_field(f1, field1.gids, field1.values);
+    load_field(f2, field2.gids, field2.values);
+  }
+
+  compare(field1, field2, abs_eps, rel_eps);
 
   return 0;
 }
@@ -21,3 +21,11 @@ $APPDIR/apptest_cmp field1.txt field1.txt 1e-12
 $APPDIR/apptest_cmp field1.txt field2.txt 2
 (! $APPDIR/apptest_cmp field1.txt field3.txt 1e-12)
 (! $APPDIR/apptest_cmp field1.txt field4.txt 1e-12)
+
+# binary field files, compared with each other or with text files
+./field_io_test field1.txt field1.bin
+./field_io_test field2.txt field2.bin
+$APPDIR/apptest_cmp field1.bin field1.bin 1e-12
+$APPDIR/apptest_cmp field1.txt field1.bin 1e-12
+(! $APPDIR/apptest_cmp field1.bin field2.bin 1e-12)
+$APPDIR/apptest_cmp field1.bin field2.bin 2
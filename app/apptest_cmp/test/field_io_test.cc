@@ -0,0 +1,123 @@
+/*
+This file is part of the Ristra portage project.
+Please see the license file at the root of this repository, or at:
+    https://github.com/laristra/portage/blob/master/LICENSE
+*/
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "field_io.h"
+
+// Checks of the binary field format, used by the comparison tool tests.
+//
+// Without arguments, a field is written and read back through both
+// mapped_field_t and sorted_field_t, and malformed text files are checked
+// to be rejected. With arguments, a text file of 'gid [matid] value' lines
+// is converted to a binary file for the comparison tools to read.
+
+void print_usage() {
+  std::printf("Usage: field_io_test [file.txt file.bin [matids=0|1]]\n");
+}
+
+void check(bool condition, std::string const& what) {
+  if (not condition)
+    throw std::runtime_error("field_io_test: " + what);
+}
+
+// write unsorted entries and check that they are read back sorted
+void check_round_trip(bool with_matids) {
+  std::string const filename = "field_io_test.bin";
+  std::vector<int> const gids = { 5, 2, 9, 2, 0 };
+  std::vector<int> const matids = { 1, 3, 0, 1, 2 };
+  std::vector<double> const values = { 0.5, -2.25, 9.0, 1.e-300, 3.0 };
+
+  // expected order by (gid, matid) or by gid only
+  std::vector<int> const order = with_matids ? std::vector<int>{ 4, 3, 1, 0, 2 }
+                                             : std::vector<int>{ 4, 1, 3, 0, 2 };
+
+  field_io::write(filename, gids, with_matids ? matids : std::vector<int>(), values);
+  check(field_io::is_binary_file(filename), "binary file not recognized");
+
+  field_io::mapped_field_t const mapped(filename);
+  check(mapped.size() == gids.size(), "wrong mapped size");
+  check(mapped.has_matids() == with_matids, "wrong mapped material ids");
+
+  field_io::sorted_field_t const sorted(filename, false);
+  check(sorted.size() == gids.size(), "wrong sorted size");
+
+  for (std::size_t i = 0; i < gids.size(); ++i) {
+    int const k = order[i];
+    check(mapped.gids()[i] == gids[k], "wrong mapped global id");
+    check(mapped.values()[i] == values[k], "wrong mapped value");
+    check(sorted.gid(i) == gids[k], "wrong sorted global id");
+    check(sorted.value(i) == values[k], "wrong sorted value");
+    if (with_matids) {
+      check(mapped.matids()[i] == matids[k], "wrong mapped material id");
+      check(sorted.matid(i) == matids[k], "wrong sorted material id");
+    }
+  }
+
+  if (with_matids)
+    check(sorted.lower_bound(2, 2) == 2, "wrong lower bound");
+
+  std::remove(filename.c_str());
+}
+
+// check that a text file is parsed, or rejected if malformed
+void check_text(std::string const& contents, bool valid) {
+  std::string const filename = "field_io_test.txt";
+  std::ofstream(filename) << contents;
+
+  bool rejected = false;
+  try {
+    field_io::sorted_field_t const field(filename, true);
+    check(field.size() == 2, "wrong text size");
+    check(field.gid(0) == 1 and field.matid(0) == 0, "text entries not sorted");
+  } catch (field_io::read_error const&) {
+    rejected = true;
+  }
+  check(rejected != valid, "text file '" + contents + "' not handled");
+
+  std::remove(filename.c_str());
+}
+
+int main(int argc, char** argv) {
+
+  if (argc == 3 or argc == 4) {
+    bool const with_matids = argc == 4 and std::string(argv[3]) == "1";
+    field_io::sorted_field_t const text(argv[1], with_matids);
+
+    std::vector<int> gids, matids;
+    std::vector<double> values;
+    for (std::size_t i = 0; i < text.size(); ++i) {
+      gids.push_back(text.gid(i));
+      values.push_back(text.value(i));
+      if (with_matids)
+        matids.push_back(text.matid(i));
+    }
+    field_io::write(argv[2], gids, matids, values);
+    return 0;
+  }
+
+  if (argc != 1) {
+    print_usage();
+    return 1;
+  }
+
+  check_round_trip(false);
+  check_round_trip(true);
+
+  check_text("2 0 1.5\n1 0 2.5\n", true);
+  check_text("2 0 1.5\n1 0 2.5", true);
+  check_text("2 0 1.5\n1 0 abc\n", false);
+  check_text("2 0 1.5\n1 0\n", false);
+  check_text("2 0 1.5\n1 0 2.5\nx\n", false);
+
+  std::cout << "Success!" << std::endl;
+  return 0;
+}
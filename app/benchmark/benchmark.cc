@@ -0,0 +1,1263 @@
+/*
+This file is part of the Ristra portage project.
+Please see the license file at the root of this repository, or at:
+    https://github.com/laristra/portage/blob/master/LICENSE
+*/
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifdef PORTAGE_ENABLE_MPI
+  #include <mpi.h>
+#endif
+
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
+
+// wonton includes
+#include "wonton/support/wonton.h"
+#include "wonton/support/Point.h"
+#include "wonton/mesh/simple/simple_mesh.h"
+#include "wonton/mesh/simple/simple_mesh_wrapper.h"
+#include "wonton/mesh/flat/flat_mesh_wrapper.h"
+#include "wonton/state/state_vector_uni.h"
+#include "wonton/state/state_vector_multi.h"
+#include "wonton/state/simple/simple_state_mm_wrapper.h"
+#include "wonton/state/flat/flat_state_mm_wrapper.h"
+
+// portage includes
+#include "portage/support/portage.h"
+#include "portage/support/timer.h"
+#include "portage/support/perf_counters.h"
+#include "portage/support/mesh_geometry_cache.h"
+#include "portage/search/search_kdtree.h"
+#include "portage/intersect/intersect_r2d.h"
+#include "portage/intersect/intersect_r3d.h"
+#include "portage/interpolate/interpolate_1st_order.h"
+#include "portage/interpolate/interpolate_2nd_order.h"
+#include "portage/driver/coredriver.h"
+#include "portage/driver/mmdriver.h"
+
+#ifdef PORTAGE_ENABLE_MPI
+  #include "portage/distributed/mpi_bounding_boxes.h"
+#endif
+
+#include "regression.h"
+
+#ifdef HAVE_TANGRAM
+  #include "tangram/driver/driver.h"
+  #include "tangram/reconstruct/MOF.h"
+  #include "tangram/intersect/split_r2d.h"
+  #include "tangram/intersect/split_r3d.h"
+#endif
+
+/*!
+  @file benchmark.cc
+  @brief End-to-end scaling benchmark of portage on synthetic meshes.
+
+  Unlike timingapp, this benchmark only relies on Wonton's Simple_Mesh
+  so that it builds on any box, with or without MPI, Jali or FleCSI.
+  Each rank generates a slab of a structured mesh of the unit square or
+  cube, which is converted into a flat mesh with globally consistent IDs
+  so that it can be redistributed like any distributed mesh. The source
+  mesh may be randomly perturbed, the target mesh may be swirled about the
+  center of the domain, and the source cells may be filled with several
+  materials when Tangram is available.
+
+  The remap is either driven phase by phase through the core driver, which
+  gives a breakdown of the elapsed time per remap step, or end-to-end
+  through MMDriver. Every run appends one line per configuration to a data
+  file from which a strong or weak scaling table is printed, so that the
+  results of several 'mpirun -np N' invocations are gathered in one table.
+
+  Given a baseline file, the phase timings and workload counters of each
+  configuration are either recorded into it, or compared against it to
+  flag performance regressions per phase (see regression.h).
+ */
+
+//////////////////////////////////////////////////////////////////////
+
+/**
+ * @struct Params
+ * @brief Benchmark parameters.
+ */
+struct Params {
+  int dim = 2;                     // spatial dimension
+  int nsource = 64;                // cells per axis on source mesh
+  int ntarget = 80;                // cells per axis on target mesh
+  int order = 1;                   // remap order
+  int nmats = 1;                   // number of materials
+  int nfields = 1;                 // number of mesh fields to remap
+  int repeat = 3;                  // runs per configuration
+  double perturbation = 0.2;       // node perturbation (fraction of cell size)
+  double angle = 0.5;              // swirl angle at domain center (radians)
+  std::string mesh = "regular";    // regular|perturbed|rotated
+  std::string scaling = "strong";  // strong|weak
+  std::string driver = "core";     // core|mmdriver
+  std::string output = "benchmark.dat";
+  std::string baseline = "";       // baseline file for regression checks
+  bool update_baseline = false;    // record runs into baseline
+  bool perf_counters = false;      // sample hardware counters per phase
+  bool sfc_reorder = false;        // renumber redistributed source along a curve
+  bool geometry_cache = false;     // serve source geometry from a cache
+  std::vector<int> threads {1};    // thread counts to sweep
+  regression::Thresholds thresholds;
+};
+
+/**
+ * @brief Split a comma-separated list of integers.
+ *
+ * @param list: the string to parse.
+ * @return the parsed values.
+ */
+std::vector<int> parse_list(std::string const& list) {
+  std::vector<int> values;
+  std::stringstream stream(list);
+  std::string token;
+  while (std::getline(stream, token, ','))
+    if (not token.empty())
+      values.push_back(std::stoi(token));
+  return values;
+}
+
+int print_usage() {
+  std::cout << std::endl;
+  std::cout << "Usage: benchmark " <<
+      "--dim=2|3 --nsourcecells=N --ntargetcells=M \n" <<
+      "--mesh=regular|perturbed|rotated --remap_order=1|2 --nmats=K \n" <<
+      "--nfields=F --threads=1,2,4 --scaling=strong|weak \n" <<
+      "--driver=core|mmdriver --repeat=R --output=file \n" <<
+      "--baseline=file.json --update_baseline=y|n --tolerance=T --noise=K\n" <<
+      "--perf_counters=y|n --sfc_reorder=y|n --geometry_cache=y|n\n\n";
+
+  std::cout << "--dim (default = 2): spatial dimension of mesh\n\n";
+  std::cout << "--nsourcecells (default = 64): cells per axis on source mesh\n";
+  std::cout << "--ntargetcells (default = 80): cells per axis on target mesh\n";
+  std::cout << "  with weak scaling, these are the counts for a single worker\n\n";
+
+  std::cout << "--mesh (default = regular): synthetic mesh variant\n";
+  std::cout << "  'perturbed' randomly moves interior source nodes\n";
+  std::cout << "  'rotated' swirls target nodes about the domain center\n";
+  std::cout << "--perturbation (default = 0.2): node displacement ratio\n";
+  std::cout << "--angle (default = 0.5): swirl angle in radians\n\n";
+
+  std::cout << "--remap_order (default = 1): order of accuracy of interpolation\n";
+  std::cout << "--nmats (default = 1): number of materials (requires Tangram)\n";
+  std::cout << "--nfields (default = 1): number of mesh fields to remap\n\n";
+
+  std::cout << "--threads (default = 1): comma-separated thread counts to sweep\n";
+  std::cout << "--scaling (default = strong): scaling study type [strong|weak]\n";
+  std::cout << "--driver (default = core): 'core' reports a per-phase breakdown,\n";
+  std::cout << "  'mmdriver' times MMDriver::run end-to-end\n";
+  std::cout << "--repeat (default = 3): runs per configuration, median is kept\n";
+  std::cout << "--output (default = benchmark.dat): file the timings are appended to\n\n";
+
+  std::cout << "--baseline (default = none): JSON file of reference timings\n";
+  std::cout << "  configurations missing from it are recorded, others are compared\n";
+  std::cout << "  and the app fails if any phase regressed\n";
+  std::cout << "--update_baseline (default = n): if 'y', overwrite baseline entries\n";
+  std::cout << "--tolerance (default = 0.05): relative slowdown tolerated per phase\n";
+  std::cout << "--noise (default = 3): slowdown tolerated in units of run-to-run noise\n\n";
+
+  std::cout << "--perf_counters (default = n): if 'y', report cycles, instructions,\n";
+  std::cout << "  cache and branch misses of each phase and thread on rank 0, summed\n";
+  std::cout << "  over runs (Linux only, see /proc/sys/kernel/perf_event_paranoid)\n\n";
+
+  std::cout << "--sfc_reorder (default = n): if 'y', renumber the redistributed\n";
+  std::cout << "  source entities along a Hilbert curve (core driver only)\n\n";
+
+  std::cout << "--geometry_cache (default = n): if 'y', run the core driver on a\n";
+  std::cout << "  MeshGeometryCache of the redistributed source mesh\n\n";
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Parse command-line arguments.
+ *
+ * @param argc, argv: arguments.
+ * @param params: parsed parameters.
+ * @return true if arguments are valid.
+ */
+bool parse(int argc, char** argv, Params& params) {
+
+  for (int i = 1; i < argc; ++i) {
+    std::string const arg(argv[i]);
+    std::size_t const len = arg.length();
+    std::size_t const keyword_beg = 2;
+    std::size_t const keyword_end = arg.find_first_of('=');
+    if (arg.compare(0, 2, "--") != 0 or keyword_end == std::string::npos) {
+      std::cerr << "Unrecognized argument: " << arg << std::endl;
+      return false;
+    }
+
+    std::string const keyword = arg.substr(keyword_beg, keyword_end - keyword_beg);
+    std::string const valueword = arg.substr(keyword_end + 1, len - keyword_end);
+
+    if (keyword == "dim")
+      params.dim = std::stoi(valueword);
+    else if (keyword == "nsourcecells")
+      params.nsource = std::stoi(valueword);
+    else if (keyword == "ntargetcells")
+      params.ntarget = std::stoi(valueword);
+    else if (keyword == "remap_order")
+      params.order = std::stoi(valueword);
+    else if (keyword == "nmats")
+      params.nmats = std::stoi(valueword);
+    else if (keyword == "nfields")
+      params.nfields = std::stoi(valueword);
+    else if (keyword == "repeat")
+      params.repeat = std::stoi(valueword);
+    else if (keyword == "perturbation")
+      params.perturbation = std::stod(valueword);
+    else if (keyword == "angle")
+      params.angle = std::stod(valueword);
+    else if (keyword == "mesh")
+      params.mesh = valueword;
+    else if (keyword == "scaling")
+      params.scaling = valueword;
+    else if (keyword == "driver")
+      params.driver = valueword;
+    else if (keyword == "output")
+      params.output = valueword;
+    else if (keyword == "baseline")
+      params.baseline = valueword;
+    else if (keyword == "update_baseline")
+      params.update_baseline = (valueword == "y");
+    else if (keyword == "perf_counters")
+      params.perf_counters = (valueword == "y");
+    else if (keyword == "sfc_reorder")
+      params.sfc_reorder = (valueword == "y");
+    else if (keyword == "geometry_cache")
+      params.geometry_cache = (valueword == "y");
+    else if (keyword == "tolerance")
+      params.thresholds.relative = std::stod(valueword);
+    else if (keyword == "noise")
+      params.thresholds.noise = std::stod(valueword);
+    else if (keyword == "threads")
+      params.threads = parse_list(valueword);
+    else {
+      std::cerr << "Unrecognized option: " << keyword << std::endl;
+      return false;
+    }
+  }
+
+  if (params.dim != 2 and params.dim != 3) {
+    std::cerr << "Invalid dimension: " << params.dim << std::endl;
+    return false;
+  }
+  if (params.order != 1 and params.order != 2) {
+    std::cerr << "Invalid remap order: " << params.order << std::endl;
+    return false;
+  }
+  if (params.mesh != "regular" and params.mesh != "perturbed"
+      and params.mesh != "rotated") {
+    std::cerr << "Invalid mesh variant: " << params.mesh << std::endl;
+    return false;
+  }
+  if (params.scaling != "strong" and params.scaling != "weak") {
+    std::cerr << "Invalid scaling type: " << params.scaling << std::endl;
+    return false;
+  }
+  if (params.driver != "core" and params.driver != "mmdriver") {
+    std::cerr << "Invalid driver: " << params.driver << std::endl;
+    return false;
+  }
+  if (params.nsource < 1 or params.ntarget < 1 or params.nfields < 1
+      or params.repeat < 1 or params.nmats < 1 or params.threads.empty()) {
+    std::cerr << "Invalid mesh, field, material or run counts" << std::endl;
+    return false;
+  }
+#ifndef HAVE_TANGRAM
+  if (params.nmats > 1) {
+    std::cerr << "Multi-material runs require Tangram" << std::endl;
+    return false;
+  }
+#endif
+#ifndef _OPENMP
+  if (params.threads.size() > 1 or params.threads[0] > 1) {
+    std::cerr << "Built without OpenMP: running single-threaded" << std::endl;
+    params.threads = {1};
+  }
+#endif
+  return true;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Synthetic meshes
+
+/**
+ * @brief Key of an entity of a structured mesh of the unit domain.
+ *
+ * Centroids of cells, faces and nodes of a structured mesh with 'n' cells
+ * per axis all fall on a lattice of spacing h/2. Their index on that
+ * lattice is unique and independent of the mesh partitioning, hence can
+ * be used as a global ID.
+ *
+ * @param p: entity centroid on the unperturbed mesh.
+ * @param n: number of cells per axis.
+ * @return the entity key.
+ */
+template<int D>
+Wonton::GID_t lattice_key(Wonton::Point<D> const& p, int n) {
+  Wonton::GID_t key = 0;
+  Wonton::GID_t stride = 1;
+  for (int d = 0; d < D; ++d) {
+    key += static_cast<Wonton::GID_t>(std::lround(2. * n * p[d])) * stride;
+    stride *= 2 * n + 1;
+  }
+  return key;
+}
+
+/**
+ * @brief Deterministic pseudo-random number in [-1,1].
+ *
+ * Based on splitmix64 so that a node shared by several ranks is displaced
+ * by the same amount everywhere.
+ *
+ * @param key: the node global ID.
+ * @param d: the coordinate index.
+ * @return a pseudo-random number in [-1,1].
+ */
+double hash_unit(Wonton::GID_t key, int d) {
+  uint64_t z = static_cast<uint64_t>(key) * 3 + d + 0x9e3779b97f4a7c15ULL;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  z = z ^ (z >> 31);
+  return 2. * (static_cast<double>(z >> 11) / 9007199254740992.) - 1.;
+}
+
+/**
+ * @brief Create the local slab of a structured mesh of the unit domain.
+ *
+ * The domain is split along the x-axis into one slab per rank. The slab is
+ * generated as a Simple_Mesh then copied into a flat mesh whose global IDs
+ * are set from the lattice keys of its entities.
+ *
+ * @param dim: mesh dimension.
+ * @param n: number of cells per axis of the global mesh.
+ * @param rank, nranks: rank and number of ranks.
+ * @param mesh: the flat mesh to initialize.
+ */
+template<int D>
+void create_slab(int n, int rank, int nranks, Wonton::Flat_Mesh_Wrapper<>& mesh) {
+
+  int const ibeg = static_cast<int>((static_cast<long>(n) * rank) / nranks);
+  int const iend = static_cast<int>((static_cast<long>(n) * (rank + 1)) / nranks);
+  if (iend <= ibeg)
+    throw std::runtime_error("more ranks than cells along the x-axis");
+
+  double const h = 1. / n;
+  double const xbeg = ibeg * h;
+  double const xend = (rank == nranks - 1 ? 1. : iend * h);
+
+  // Intel 18.0.1 does not recognize std::make_unique even with -std=c++14 flag *ugh*
+  std::unique_ptr<Wonton::Simple_Mesh> slab(
+    D == 2 ? new Wonton::Simple_Mesh(xbeg, 0., xend, 1., iend - ibeg, n)
+           : new Wonton::Simple_Mesh(xbeg, 0., 0., xend, 1., 1., iend - ibeg, n, n)
+  );
+
+  Wonton::Simple_Mesh_Wrapper slab_wrapper(*slab);
+  mesh.initialize(slab_wrapper);
+
+  // set global IDs so that redistribution merges shared entities
+  int const ncells = mesh.num_owned_cells() + mesh.num_ghost_cells();
+  int const nnodes = mesh.num_owned_nodes() + mesh.num_ghost_nodes();
+
+  auto& cell_gids = mesh.get_global_cell_ids();
+  auto& node_gids = mesh.get_global_node_ids();
+
+  for (int c = 0; c < ncells; ++c) {
+    Wonton::Point<D> centroid;
+    mesh.cell_centroid(c, &centroid);
+    cell_gids[c] = lattice_key<D>(centroid, n);
+  }
+
+  for (int i = 0; i < nnodes; ++i) {
+    Wonton::Point<D> coords;
+    mesh.node_get_coordinates(i, &coords);
+    node_gids[i] = lattice_key<D>(coords, n);
+  }
+
+  if (D == 3) {
+    int const nfaces = mesh.num_owned_faces() + mesh.num_ghost_faces();
+    auto& face_gids = mesh.get_global_face_ids();
+
+    for (int f = 0; f < nfaces; ++f) {
+      std::vector<int> nodes;
+      mesh.face_get_nodes(f, &nodes);
+      Wonton::Point<D> centroid;
+      for (auto const& i : nodes) {
+        Wonton::Point<D> coords;
+        mesh.node_get_coordinates(i, &coords);
+        centroid += coords;
+      }
+      centroid /= nodes.size();
+      face_gids[f] = lattice_key<D>(centroid, n);
+    }
+  }
+}
+
+/**
+ * @brief Randomly displace interior nodes of a flat mesh.
+ *
+ * Boundary nodes only slide along the boundary so that the domain is
+ * preserved. Connectivity is untouched, only coordinates are updated.
+ *
+ * @param n: number of cells per axis of the global mesh.
+ * @param ratio: maximal displacement as a fraction of the cell size.
+ * @param mesh: the flat mesh to perturb.
+ */
+template<int D>
+void perturb(int n, double ratio, Wonton::Flat_Mesh_Wrapper<>& mesh) {
+
+  double const tol = 1.E-12;
+  double const shift = 0.5 * ratio / n;
+  int const nnodes = mesh.num_owned_nodes() + mesh.num_ghost_nodes();
+  auto const& node_gids = mesh.get_global_node_ids();
+  auto& coords = mesh.get_coords();
+
+  for (int i = 0; i < nnodes; ++i) {
+    for (int d = 0; d < D; ++d) {
+      double& x = coords[D * i + d];
+      if (x > tol and x < 1. - tol)
+        x += shift * hash_unit(node_gids[i], d);
+    }
+  }
+}
+
+/**
+ * @brief Swirl the nodes of a flat mesh in the xy-plane.
+ *
+ * Nodes are rotated about the center of the domain by an angle decaying
+ * quadratically from 'angle' at the center to zero at a distance of 0.5,
+ * so that the boundary is preserved and cells stay valid.
+ *
+ * @param angle: rotation angle at the center of the domain.
+ * @param mesh: the flat mesh to swirl.
+ */
+template<int D>
+void swirl(double angle, Wonton::Flat_Mesh_Wrapper<>& mesh) {
+
+  int const nnodes = mesh.num_owned_nodes() + mesh.num_ghost_nodes();
+  auto& coords = mesh.get_coords();
+
+  for (int i = 0; i < nnodes; ++i) {
+    double const x = coords[D * i] - 0.5;
+    double const y = coords[D * i + 1] - 0.5;
+    double const r = std::sqrt(x * x + y * y);
+    if (r < 0.5) {
+      double const theta = angle * (1. - 2. * r) * (1. - 2. * r);
+      double const cos_theta = std::cos(theta);
+      double const sin_theta = std::sin(theta);
+      coords[D * i]     = 0.5 + cos_theta * x - sin_theta * y;
+      coords[D * i + 1] = 0.5 + sin_theta * x + cos_theta * y;
+    }
+  }
+}
+
+/**
+ * @brief Analytic fields used for remap.
+ *
+ * Both are linear so that second-order remap reproduces them exactly.
+ */
+template<int D>
+double mesh_field(Wonton::Point<D> const& p, int k) {
+  double value = 1.;
+  for (int d = 0; d < D; ++d)
+    value += (d + 1) * p[d];
+  return (k + 1) * value;
+}
+
+template<int D>
+double material_field(Wonton::Point<D> const& p, int m) {
+  double value = m + 1.;
+  for (int d = 0; d < D; ++d)
+    value += p[d];
+  return value;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Benchmark
+
+/**
+ * @class Benchmark
+ * @brief Generate meshes and states then time their remap.
+ *
+ * @tparam D: mesh dimension.
+ * @tparam Intersect: mesh-mesh intersection kernel.
+ * @tparam InterfaceReconstructor: interface reconstruction method.
+ * @tparam Matpoly_Splitter: material polytope splitter.
+ * @tparam Matpoly_Clipper: material polytope clipper.
+ */
+template<int D,
+         template <Wonton::Entity_kind, class, class, class,
+                   template <class, int, class, class> class,
+                   class, class> class Intersect,
+         template <class, int, class, class> class InterfaceReconstructor,
+         class Matpoly_Splitter, class Matpoly_Clipper>
+class Benchmark {
+
+  using Mesh = Wonton::Flat_Mesh_Wrapper<>;
+  using CachedMesh = Portage::MeshGeometryCache<D, Mesh>;
+  using State = Wonton::Simple_State_Wrapper<Mesh>;
+  using FlatState = Wonton::Flat_State_Wrapper<Mesh>;
+
+public:
+  /**
+   * @brief Create a benchmark instance.
+   *
+   * @param params: benchmark parameters.
+   * @param rank, nranks: rank and number of ranks.
+   * @param executor: MPI executor if distributed, null otherwise.
+   */
+  Benchmark(Params const& params, int rank, int nranks,
+            Wonton::Executor_type const* executor)
+    : params_(params), rank_(rank), nranks_(nranks), executor_(executor) {}
+
+  /**
+   * @brief Generate meshes and remap fields once.
+   *
+   * @param nsource: cells per axis on source mesh.
+   * @param ntarget: cells per axis on target mesh.
+   * @param profiler: per-phase elapsed times.
+   * @param counters: workload counters on this rank.
+   * @param hw: hardware counters sampled with timers, if any.
+   */
+  void run(int nsource, int ntarget, Profiler& profiler,
+           std::map<std::string, long>& counters,
+           Portage::PerfCounters* hw = nullptr) const {
+
+    auto tic = timer::now();
+    if (hw)
+      hw->start();
+
+    Mesh source_mesh;
+    Mesh target_mesh;
+    create_slab<D>(nsource, rank_, nranks_, source_mesh);
+    create_slab<D>(ntarget, rank_, nranks_, target_mesh);
+
+    if (params_.mesh == "perturbed")
+      perturb<D>(nsource, params_.perturbation, source_mesh);
+    else if (params_.mesh == "rotated")
+      swirl<D>(params_.angle, target_mesh);
+
+    std::unique_ptr<State> source_state;
+    std::unique_ptr<State> target_state;
+    create_states(source_mesh, target_mesh, source_state, target_state);
+
+    profiler.time.mesh_init = timer::elapsed(tic, true);
+    if (hw) hw->checkpoint("mesh_init");
+
+    counters["source_cells"] = source_mesh.num_owned_cells();
+    counters["target_cells"] = target_mesh.num_owned_cells();
+
+    if (params_.order == 1) {
+      if (params_.driver == "core")
+        remap_core<Portage::Interpolate_1stOrder>(source_mesh, *source_state,
+                                                  target_mesh, *target_state,
+                                                  profiler, counters, hw);
+      else
+        remap_mmdriver<Portage::Interpolate_1stOrder>(source_mesh, *source_state,
+                                                      target_mesh, *target_state,
+                                                      profiler, hw);
+    } else {
+      if (params_.driver == "core")
+        remap_core<Portage::Interpolate_2ndOrder>(source_mesh, *source_state,
+                                                  target_mesh, *target_state,
+                                                  profiler, counters, hw);
+      else
+        remap_mmdriver<Portage::Interpolate_2ndOrder>(source_mesh, *source_state,
+                                                      target_mesh, *target_state,
+                                                      profiler, hw);
+    }
+
+    profiler.time.total = profiler.time.mesh_init + profiler.time.redistrib
+                          + profiler.time.remap;
+  }
+
+private:
+  /**
+   * @brief Create source and target states.
+   *
+   * Materials are laid out as slabs along the x-axis whose interfaces do
+   * not match mesh lines. Volume fractions and centroids are computed from
+   * the overlap of each cell bounding box with each slab, which is exact
+   * on unperturbed meshes.
+   */
+  void create_states(Mesh const& source_mesh, Mesh const& target_mesh,
+                     std::unique_ptr<State>& source_state,
+                     std::unique_ptr<State>& target_state) const {
+
+    int const nmats = params_.nmats;
+    int const nsource_cells = source_mesh.num_owned_cells();
+    int const ntarget_cells = target_mesh.num_owned_cells();
+
+    if (nmats > 1) {
+      std::vector<double> interfaces(nmats + 1);
+      interfaces[0] = 0.;
+      interfaces[nmats] = 1.;
+      for (int m = 1; m < nmats; ++m)
+        interfaces[m] = (m - 0.3) / nmats;
+
+      std::unordered_map<std::string, int> matnames;
+      std::unordered_map<int, std::vector<int>> matcells;
+      std::unordered_map<int, std::vector<double>> mat_volfracs;
+      std::unordered_map<int, std::vector<Wonton::Point<D>>> mat_centroids;
+      std::unordered_map<int, std::vector<double>> mat_values;
+
+      for (int m = 0; m < nmats; ++m)
+        matnames["mat" + std::to_string(m)] = m;
+
+      for (int c = 0; c < nsource_cells; ++c) {
+        Wonton::Point<D> lower, upper;
+        std::vector<Wonton::Point<D>> coords;
+        source_mesh.cell_get_coordinates(c, &coords);
+        for (int d = 0; d < D; ++d) {
+          lower[d] = upper[d] = coords[0][d];
+          for (auto const& p : coords) {
+            lower[d] = std::min(lower[d], p[d]);
+            upper[d] = std::max(upper[d], p[d]);
+          }
+        }
+
+        double const width = upper[0] - lower[0];
+        for (int m = 0; m < nmats; ++m) {
+          double const xmin = std::max(lower[0], interfaces[m]);
+          double const xmax = std::min(upper[0], interfaces[m + 1]);
+          if (xmax - xmin > 1.E-12 * width) {
+            Wonton::Point<D> centroid = 0.5 * (lower + upper);
+            centroid[0] = 0.5 * (xmin + xmax);
+            matcells[m].push_back(c);
+            mat_volfracs[m].push_back((xmax - xmin) / width);
+            mat_centroids[m].push_back(centroid);
+            mat_values[m].push_back(material_field<D>(centroid, m));
+          }
+        }
+      }
+
+      source_state.reset(new State(source_mesh, matnames, matcells));
+      source_state->add(std::make_shared<Wonton::StateVectorMulti<>>("mat_volfracs", mat_volfracs));
+      source_state->add(std::make_shared<Wonton::StateVectorMulti<Wonton::Point<D>>>("mat_centroids", mat_centroids));
+      source_state->add(std::make_shared<Wonton::StateVectorMulti<>>("matdata", mat_values));
+
+      target_state.reset(new State(target_mesh, matnames));
+      target_state->add(std::make_shared<Wonton::StateVectorMulti<>>(Wonton::StateVectorMulti<>{"mat_volfracs"}));
+      target_state->add(std::make_shared<Wonton::StateVectorMulti<Wonton::Point<D>>>(Wonton::StateVectorMulti<Wonton::Point<D>>{"mat_centroids"}));
+      target_state->add(std::make_shared<Wonton::StateVectorMulti<>>(Wonton::StateVectorMulti<>{"matdata"}));
+    } else {
+      source_state.reset(new State(source_mesh));
+      target_state.reset(new State(target_mesh));
+    }
+
+    for (int k = 0; k < params_.nfields; ++k) {
+      std::string const name = "meshdata" + std::to_string(k);
+      std::vector<double> values(nsource_cells);
+      for (int c = 0; c < nsource_cells; ++c) {
+        Wonton::Point<D> centroid;
+        source_mesh.cell_centroid(c, &centroid);
+        values[c] = mesh_field<D>(centroid, k);
+      }
+      source_state->add(std::make_shared<Wonton::StateVectorUni<>>(name, Wonton::Entity_kind::CELL, values));
+      target_state->add(std::make_shared<Wonton::StateVectorUni<>>(name, Wonton::Entity_kind::CELL, std::vector<double>(ntarget_cells, 0.)));
+    }
+  }
+
+  /// names of fields to remap
+  std::vector<std::string> field_names() const {
+    std::vector<std::string> names;
+    for (int k = 0; k < params_.nfields; ++k)
+      names.emplace_back("meshdata" + std::to_string(k));
+    if (params_.nmats > 1)
+      names.emplace_back("matdata");
+    return names;
+  }
+
+  /**
+   * @brief Remap fields step by step through the core driver.
+   *
+   * The sequence of calls follows MMDriver::cell_remap, with a timer
+   * checkpoint after each step. Search candidates and non-empty
+   * intersections are counted to detect workload changes.
+   */
+  template<template<int, Wonton::Entity_kind, class, class, class, class, class,
+                    template<class, int, class, class> class,
+                    class, class, class> class Interpolate>
+  void remap_core(Mesh& source_mesh, State const& source_state,
+                  Mesh const& target_mesh, State& target_state,
+                  Profiler& profiler,
+                  std::map<std::string, long>& counters,
+                  Portage::PerfCounters* hw) const {
+
+    auto const names = field_names();
+    auto tic = timer::now();
+    auto start = tic;
+
+    // redistribution also requires a flat copy of the source state
+    FlatState source_state_flat(source_mesh);
+    source_state_flat.initialize(source_state, names);
+
+#ifdef PORTAGE_ENABLE_MPI
+    if (nranks_ > 1) {
+      auto mpiexecutor = dynamic_cast<Wonton::MPIExecutor_type const*>(executor_);
+      Portage::MPI_Bounding_Boxes distributor(mpiexecutor);
+      distributor.reorder_by_sfc(params_.sfc_reorder);
+      if (distributor.is_redistribution_needed(source_mesh, target_mesh))
+        distributor.distribute(source_mesh, source_state_flat,
+                               target_mesh, target_state);
+    }
+#endif
+
+    if (params_.geometry_cache) {
+      // the cache copies the redistributed mesh, which counts as redistribution
+      CachedMesh cached_mesh;
+      cached_mesh.initialize(source_mesh);
+      cached_mesh.update();
+      profiler.time.redistrib = timer::elapsed(tic, true);
+      if (hw) hw->checkpoint("redistrib");
+
+      remap_steps<Interpolate>(cached_mesh, source_state_flat, target_mesh,
+                               target_state, profiler, counters, hw, tic);
+    } else {
+      profiler.time.redistrib = timer::elapsed(tic, true);
+      if (hw) hw->checkpoint("redistrib");
+
+      remap_steps<Interpolate>(source_mesh, source_state_flat, target_mesh,
+                               target_state, profiler, counters, hw, tic);
+    }
+
+    profiler.time.remap = timer::elapsed(start) - profiler.time.redistrib;
+  }
+
+  /**
+   * @brief Run the remap steps of the core driver and time each of them.
+   *
+   * @tparam SourceMesh: the flat source mesh, or a geometry cache of it.
+   * @param tic: time of the last checkpoint, updated at each step.
+   */
+  template<template<int, Wonton::Entity_kind, class, class, class, class, class,
+                    template<class, int, class, class> class,
+                    class, class, class> class Interpolate,
+           class SourceMesh>
+  void remap_steps(SourceMesh const& source_mesh, FlatState const& source_state_flat,
+                   Mesh const& target_mesh, State& target_state,
+                   Profiler& profiler,
+                   std::map<std::string, long>& counters,
+                   Portage::PerfCounters* hw,
+                   std::chrono::high_resolution_clock::time_point& tic) const {
+
+    auto const names = field_names();
+
+    Portage::CoreDriver<D, Wonton::Entity_kind::CELL,
+                        SourceMesh, FlatState, Mesh, State,
+                        InterfaceReconstructor,
+                        Matpoly_Splitter, Matpoly_Clipper>
+      driver(source_mesh, source_state_flat, target_mesh, target_state, executor_);
+
+#ifdef HAVE_TANGRAM
+    driver.set_interface_reconstructor_options(params_.mesh != "perturbed");
+#endif
+
+    auto candidates = driver.template search<Portage::SearchKDTree>();
+    profiler.time.search = timer::elapsed(tic, true);
+    if (hw) hw->checkpoint("search");
+
+    auto weights = driver.template intersect_meshes<Intersect>(candidates);
+    profiler.time.intersect = timer::elapsed(tic, true);
+    if (hw) hw->checkpoint("intersect");
+
+    long& num_candidates = counters["candidates"];
+    long& num_intersections = counters["intersections"];
+    num_candidates = num_intersections = 0;
+    int const ntargets = candidates.size();
+    for (int i = 0; i < ntargets; ++i) {
+      num_candidates += candidates[i].size();
+      num_intersections += weights[i].size();
+    }
+
+    bool const mismatch = driver.check_mismatch(weights);
+    profiler.time.mismatch = timer::elapsed(tic, true);
+    if (hw) hw->checkpoint("mismatch");
+
+    for (int k = 0; k < params_.nfields; ++k) {
+      std::string const& name = names[k];
+      Portage::vector<Wonton::Vector<D>> gradients;
+
+      if (params_.order == 2) {
+        gradients = driver.compute_source_gradient(name, Portage::BARTH_JESPERSEN,
+                                                   Portage::BND_NOLIMITER);
+        timer::reset(tic, &profiler.time.gradient);
+        if (hw) hw->checkpoint("gradient");
+      }
+
+      driver.template interpolate_mesh_var<double, Interpolate>
+        (name, name, weights, params_.order == 2 ? &gradients : nullptr);
+      timer::reset(tic, &profiler.time.interpolate);
+      if (hw) hw->checkpoint("interpolate");
+
+      if (mismatch) {
+        driver.fix_mismatch(name, name);
+        timer::reset(tic, &profiler.time.mismatch);
+        if (hw) hw->checkpoint("mismatch");
+      }
+    }
+
+#ifdef HAVE_TANGRAM
+    int const nmats = params_.nmats;
+    if (nmats > 1) {
+      auto weights_by_mat = driver.template intersect_materials<Intersect>(candidates);
+      profiler.time.interface = timer::elapsed(tic, true);
+      if (hw) hw->checkpoint("interface");
+
+      long& num_mat_intersections = counters["material_intersections"];
+      num_mat_intersections = 0;
+      for (auto const& mat_weights : weights_by_mat)
+        for (auto const& cell_weights : mat_weights)
+          num_mat_intersections += cell_weights.size();
+
+      std::vector<Portage::vector<Wonton::Vector<D>>> gradients(nmats);
+      if (params_.order == 2) {
+        for (int m = 0; m < nmats; ++m)
+          gradients[m] = driver.compute_source_gradient("matdata",
+                                                        Portage::BARTH_JESPERSEN,
+                                                        Portage::BND_NOLIMITER, m);
+        timer::reset(tic, &profiler.time.gradient);
+        if (hw) hw->checkpoint("gradient");
+      }
+
+      driver.template interpolate_mat_var<double, Interpolate>
+        ("matdata", "matdata", weights_by_mat,
+         params_.order == 2 ? &gradients : nullptr);
+      timer::reset(tic, &profiler.time.interpolate);
+      if (hw) hw->checkpoint("interpolate");
+    }
+#endif
+  }
+
+  /**
+   * @brief Remap fields end-to-end through MMDriver.
+   *
+   * Redistribution happens within MMDriver::run, so only the overall
+   * remap time is available.
+   */
+  template<template<int, Wonton::Entity_kind, class, class, class, class, class,
+                    template<class, int, class, class> class,
+                    class, class, class> class Interpolate>
+  void remap_mmdriver(Mesh const& source_mesh, State const& source_state,
+                      Mesh const& target_mesh, State& target_state,
+                      Profiler& profiler,
+                      Portage::PerfCounters* hw) const {
+
+    auto tic = timer::now();
+
+    Portage::MMDriver<Portage::SearchKDTree, Intersect, Interpolate, D,
+                      Mesh, State, Mesh, State,
+                      InterfaceReconstructor,
+                      Matpoly_Splitter, Matpoly_Clipper>
+      driver(source_mesh, source_state, target_mesh, target_state);
+
+    driver.set_remap_var_names(field_names());
+    if (params_.order == 2) {
+      driver.set_limiter(Portage::BARTH_JESPERSEN);
+      driver.set_bnd_limiter(Portage::BND_NOLIMITER);
+    }
+#ifdef HAVE_TANGRAM
+    driver.set_reconstructor_options(params_.mesh != "perturbed");
+#endif
+
+    driver.run(executor_);
+    profiler.time.remap = timer::elapsed(tic);
+    if (hw) hw->checkpoint("remap");
+  }
+
+  Params const& params_;
+  int rank_ = 0;
+  int nranks_ = 1;
+  Wonton::Executor_type const* executor_ = nullptr;
+};
+
+//////////////////////////////////////////////////////////////////////
+// Scaling tables
+
+// number of timed phases in the data file
+int const nphases = 10;
+
+// phase labels, in data file order
+char const* const phase_names[nphases] = {
+  "mesh_init", "redistrib", "interface", "search", "intersect",
+  "gradient", "interpolate", "mismatch", "remap", "total"
+};
+
+/**
+ * @struct Record
+ * @brief A line of the benchmark data file.
+ */
+struct Record {
+  std::string tag;
+  int ranks = 1;
+  int threads = 1;
+  long nsource = 0;
+  long ntarget = 0;
+  float time[nphases] = {};
+};
+
+/**
+ * @brief Identify the study a run belongs to.
+ *
+ * Runs of a same study only differ by their number of ranks and threads.
+ * Cell counts are only part of the tag for strong scaling, since they grow
+ * with the number of workers for weak scaling.
+ */
+std::string study_tag(Params const& params) {
+  std::stringstream tag;
+  tag << params.scaling << "_" << params.dim << "d_" << params.mesh
+      << "_o" << params.order << "_m" << params.nmats
+      << "_f" << params.nfields << "_" << params.driver
+      << "_s" << params.nsource << "_t" << params.ntarget;
+  if (params.sfc_reorder)
+    tag << "_sfc";
+  if (params.geometry_cache)
+    tag << "_gc";
+  return tag.str();
+}
+
+/**
+ * @brief Append a record to the benchmark data file.
+ *
+ * @param path: data file path.
+ * @param record: the record to append.
+ * @return true if the record was written.
+ */
+bool append(std::string const& path, Record const& record) {
+
+  bool const is_empty = [&] {
+    std::ifstream file(path);
+    return not file.good() or file.peek() == std::ifstream::traits_type::eof();
+  }();
+
+  std::ofstream file(path, std::ios::out|std::ios::app);
+  if (not file.good()) {
+    std::fprintf(stderr, "Could not open file :%s\n", path.data());
+    return false;
+  }
+
+  if (is_empty) {
+    file << "# Profiling data for portage benchmark app" << std::endl;
+    file << "#"                                          << std::endl;
+    file << "# Fields"                                   << std::endl;
+    file << "#  1. study tag"                            << std::endl;
+    file << "#  2. number of ranks"                      << std::endl;
+    file << "#  3. number of threads"                    << std::endl;
+    file << "#  4. source cells count"                   << std::endl;
+    file << "#  5. target cells count"                   << std::endl;
+    for (int i = 0; i < nphases; ++i)
+      file << "# " << (i < 4 ? " " : "") << i + 6 << ". "
+           << phase_names[i] << " time" << std::endl;
+    file << std::endl;
+  }
+
+  file << record.tag << "\t" << record.ranks << "\t" << record.threads << "\t"
+       << record.nsource << "\t" << record.ntarget;
+  for (float const& t : record.time)
+    file << "\t" << t;
+  file << std::endl;
+  return true;
+}
+
+/**
+ * @brief Print the scaling table of a study.
+ *
+ * All records of the data file that belong to the study are listed by
+ * increasing number of workers. Speedup and efficiency are computed with
+ * respect to the run with the fewest workers.
+ *
+ * @param path: data file path.
+ * @param tag: the study tag.
+ * @param weak: whether it is a weak scaling study.
+ */
+void print_table(std::string const& path, std::string const& tag, bool weak) {
+
+  std::vector<Record> records;
+  std::ifstream file(path);
+  std::string line;
+
+  while (std::getline(file, line)) {
+    if (line.empty() or line[0] == '#')
+      continue;
+    std::stringstream stream(line);
+    Record record;
+    stream >> record.tag >> record.ranks >> record.threads
+           >> record.nsource >> record.ntarget;
+    for (float& t : record.time)
+      stream >> t;
+    if (stream and record.tag == tag)
+      records.push_back(record);
+  }
+
+  if (records.empty())
+    return;
+
+  // keep the latest run for each worker layout
+  std::stable_sort(records.begin(), records.end(),
+                   [](Record const& a, Record const& b) {
+                     return a.ranks * a.threads < b.ranks * b.threads;
+                   });
+
+  std::vector<Record> rows;
+  for (auto const& record : records) {
+    auto it = std::find_if(rows.begin(), rows.end(), [&](Record const& row) {
+      return row.ranks == record.ranks and row.threads == record.threads;
+    });
+    if (it == rows.end())
+      rows.push_back(record);
+    else
+      *it = record;
+  }
+
+  int const remap = 8;
+  Record const& reference = rows.front();
+  int const ref_workers = reference.ranks * reference.threads;
+
+  std::printf("\n%s scaling table: %s\n", weak ? "Weak" : "Strong", tag.data());
+  std::printf(" ranks threads    nsource    ntarget  search  intersect  interface"
+              "  gradient  interpolate  mismatch   remap  speedup  efficiency\n");
+  for (auto const& row : rows) {
+    int const workers = row.ranks * row.threads;
+    double const speedup = reference.time[remap] / std::max(row.time[remap], 1.E-3f);
+    double const ideal = weak ? 1. : static_cast<double>(workers) / ref_workers;
+    std::printf(" %5d %7d %10ld %10ld %7.3f %10.3f %10.3f %9.3f %12.3f %9.3f %7.3f %8.2f %10.1f%%\n",
+                row.ranks, row.threads, row.nsource, row.ntarget,
+                row.time[3], row.time[4], row.time[2], row.time[5],
+                row.time[6], row.time[7], row.time[remap],
+                speedup, 100. * speedup / ideal);
+  }
+  std::fflush(stdout);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Run all configurations of a study.
+ *
+ * @param params: benchmark parameters.
+ * @param rank, nranks: rank and number of ranks.
+ * @param executor: MPI executor if distributed, null otherwise.
+ * @return number of configurations that regressed against the baseline.
+ */
+template<int D,
+         template <Wonton::Entity_kind, class, class, class,
+                   template <class, int, class, class> class,
+                   class, class> class Intersect,
+         template <class, int, class, class> class InterfaceReconstructor,
+         class Matpoly_Splitter, class Matpoly_Clipper>
+int run_study(Params const& params, int rank, int nranks,
+              Wonton::Executor_type const* executor) {
+
+  Benchmark<D, Intersect, InterfaceReconstructor,
+            Matpoly_Splitter, Matpoly_Clipper> benchmark(params, rank,
+                                                         nranks, executor);
+
+  std::string const tag = study_tag(params);
+  bool const weak = params.scaling == "weak";
+
+  bool const check = not params.baseline.empty();
+  bool baseline_changed = false;
+  int failures = 0;
+  nlohmann::json baseline;
+  if (check and rank == 0)
+    baseline = regression::load(params.baseline);
+
+  for (int const threads : params.threads) {
+#ifdef _OPENMP
+    omp_set_num_threads(threads);
+#endif
+
+    // attach counters to the threads of the current pool
+    std::unique_ptr<Portage::PerfCounters> hw;
+    if (params.perf_counters)
+      hw.reset(new Portage::PerfCounters);
+
+    // scale cell counts with the number of workers for weak scaling
+    int nsource = params.nsource;
+    int ntarget = params.ntarget;
+    if (weak) {
+      double const factor = std::pow(static_cast<double>(nranks * threads), 1. / D);
+      nsource = static_cast<int>(std::lround(nsource * factor));
+      ntarget = static_cast<int>(std::lround(ntarget * factor));
+    }
+
+    std::vector<std::vector<float>> samples(nphases);
+    std::map<std::string, long> counters;
+
+    for (int i = 0; i < params.repeat; ++i) {
+      Profiler profiler;
+      benchmark.run(nsource, ntarget, profiler, counters, hw.get());
+
+      float const elapsed[nphases] = {
+        profiler.time.mesh_init, profiler.time.redistrib,
+        profiler.time.interface, profiler.time.search,
+        profiler.time.intersect, profiler.time.gradient,
+        profiler.time.interpolate, profiler.time.mismatch,
+        profiler.time.remap, profiler.time.total
+      };
+
+      // the slowest rank sets the pace
+      float slowest[nphases];
+      std::copy(elapsed, elapsed + nphases, slowest);
+#ifdef PORTAGE_ENABLE_MPI
+      if (nranks > 1)
+        MPI_Allreduce(elapsed, slowest, nphases, MPI_FLOAT, MPI_MAX, MPI_COMM_WORLD);
+#endif
+      for (int j = 0; j < nphases; ++j)
+        samples[j].push_back(slowest[j]);
+    }
+
+    // workload counters are summed over ranks
+    std::vector<long> local_counts, global_counts;
+    for (auto const& counter : counters)
+      local_counts.push_back(counter.second);
+    global_counts = local_counts;
+#ifdef PORTAGE_ENABLE_MPI
+    if (nranks > 1)
+      MPI_Allreduce(local_counts.data(), global_counts.data(), local_counts.size(),
+                    MPI_LONG, MPI_SUM, MPI_COMM_WORLD);
+#endif
+
+    if (rank == 0) {
+      Record record;
+      record.tag = tag;
+      record.ranks = nranks;
+      record.threads = threads;
+      record.nsource = static_cast<long>(std::pow(nsource, D));
+      record.ntarget = static_cast<long>(std::pow(ntarget, D));
+      regression::Entry entry;
+      for (int j = 0; j < nphases; ++j) {
+        entry.phases[phase_names[j]] = regression::compute_stats(samples[j]);
+        record.time[j] = entry.phases[phase_names[j]].median;
+      }
+
+      int k = 0;
+      for (auto const& counter : counters)
+        entry.counters[counter.first] = global_counts[k++];
+
+      std::printf("ranks: %d, threads: %d, remap: %.3f s (median of %d)\n",
+                  nranks, threads, record.time[8], params.repeat);
+      std::fflush(stdout);
+      append(params.output, record);
+
+      if (hw)
+        hw->dump(true);
+
+      if (check) {
+        std::string const config = tag + "_r" + std::to_string(nranks)
+                                 + "_t" + std::to_string(threads);
+        if (params.update_baseline or not baseline.count(config)) {
+          baseline[config] = regression::to_json(entry);
+          baseline_changed = true;
+          std::printf("Recorded '%s' into baseline '%s'\n",
+                      config.data(), params.baseline.data());
+        } else {
+          auto const reference = regression::from_json(baseline[config]);
+          if (regression::compare(config, reference, entry, params.thresholds))
+            failures++;
+        }
+      }
+    }
+  }
+
+  if (rank == 0) {
+    print_table(params.output, tag, weak);
+    if (baseline_changed)
+      regression::store(params.baseline, baseline);
+  }
+
+#ifdef PORTAGE_ENABLE_MPI
+  if (nranks > 1)
+    MPI_Bcast(&failures, 1, MPI_INT, 0, MPI_COMM_WORLD);
+#endif
+  return failures;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+int main(int argc, char** argv) {
+
+  int rank = 0;
+  int nranks = 1;
+  Wonton::Executor_type* executor = nullptr;
+
+#ifdef PORTAGE_ENABLE_MPI
+  MPI_Init(&argc, &argv);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &nranks);
+  Wonton::MPIExecutor_type mpiexecutor(MPI_COMM_WORLD);
+  if (nranks > 1)
+    executor = &mpiexecutor;
+#endif
+
+  Params params;
+  if (argc > 1 and std::string(argv[1]) == "--help") {
+    if (rank == 0)
+      print_usage();
+#ifdef PORTAGE_ENABLE_MPI
+    MPI_Finalize();
+#endif
+    return EXIT_SUCCESS;
+  }
+
+  if (not parse(argc, argv, params)) {
+    if (rank == 0)
+      print_usage();
+#ifdef PORTAGE_ENABLE_MPI
+    MPI_Finalize();
+#endif
+    return EXIT_FAILURE;
+  }
+
+  if (rank == 0) {
+    std::printf("Running %s scaling benchmark: %dD %s mesh, %d source and "
+                "%d target cells per axis, order %d, %d material(s), "
+                "%d field(s), %d rank(s).\n",
+                params.scaling.data(), params.dim, params.mesh.data(),
+                params.nsource, params.ntarget, params.order, params.nmats,
+                params.nfields, nranks);
+    std::fflush(stdout);
+  }
+
+  int failures = 0;
+
+#ifdef HAVE_TANGRAM
+  if (params.dim == 2)
+    failures = run_study<2, Portage::IntersectR2D, Tangram::MOF,
+                         Tangram::SplitR2D, Tangram::ClipR2D>(params, rank, nranks, executor);
+  else
+    failures = run_study<3, Portage::IntersectR3D, Tangram::MOF,
+                         Tangram::SplitR3D, Tangram::ClipR3D>(params, rank, nranks, executor);
+#else
+  if (params.dim == 2)
+    failures = run_study<2, Portage::IntersectR2D, Portage::DummyInterfaceReconstructor,
+                         void, void>(params, rank, nranks, executor);
+  else
+    failures = run_study<3, Portage::IntersectR3D, Portage::DummyInterfaceReconstructor,
+                         void, void>(params, rank, nranks, executor);
+#endif
+
+#ifdef PORTAGE_ENABLE_MPI
+  MPI_Finalize();
+#endif
+  return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,232 @@
+/*
+  This file is part of the Ristra portage project.
+  Please see the license file at the root of this repository, or at:
+  https://github.com/laristra/portage/blob/master/LICENSE
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "json.h"
+
+/*!
+  @file regression.h
+  @brief Performance regression checks of benchmark runs against a baseline.
+
+  A baseline is a JSON file that maps each benchmark configuration to
+  robust statistics (median and median absolute deviation) of its phase
+  timings over several runs, along with workload counters. A new run of
+  the same configuration is compared phase by phase: a phase regresses
+  when its median exceeds the baseline median by more than both a
+  relative tolerance and a multiple of the combined run-to-run noise.
+  Counters must match exactly, otherwise timings are not comparable.
+ */
+
+namespace regression {
+
+/**
+ * @struct Stats
+ * @brief Robust statistics of a list of timings.
+ */
+struct Stats {
+  float median = 0;
+  float mad = 0;     // median absolute deviation
+  int runs = 0;
+};
+
+/**
+ * @brief Median of a list of values.
+ *
+ * @param values: the values.
+ * @return their median.
+ */
+inline float median(std::vector<float> values) {
+  assert(not values.empty());
+  std::size_t const half = values.size() / 2;
+  std::nth_element(values.begin(), values.begin() + half, values.end());
+  float const upper = values[half];
+  if (values.size() % 2)
+    return upper;
+  float const lower = *std::max_element(values.begin(), values.begin() + half);
+  return 0.5f * (lower + upper);
+}
+
+/**
+ * @brief Compute robust statistics of a list of timings.
+ *
+ * @param samples: the timings of each run.
+ * @return their median and median absolute deviation.
+ */
+inline Stats compute_stats(std::vector<float> const& samples) {
+  Stats stats;
+  stats.runs = samples.size();
+  stats.median = median(samples);
+  std::vector<float> deviations(samples.size());
+  for (std::size_t i = 0; i < samples.size(); ++i)
+    deviations[i] = std::abs(samples[i] - stats.median);
+  stats.mad = median(deviations);
+  return stats;
+}
+
+/**
+ * @struct Thresholds
+ * @brief Noise-aware regression thresholds.
+ *
+ * A phase regresses if its median grows by more than:
+ *   max(relative * base, noise * 1.4826 * (mad_base + mad_run), absolute)
+ * where 1.4826 scales a median absolute deviation to a standard deviation
+ * for normally distributed noise.
+ */
+struct Thresholds {
+  double relative = 0.05;   // relative slowdown tolerance
+  double noise = 3.;        // tolerance in units of run-to-run noise
+  double absolute = 2.E-3;  // timer resolution in seconds
+};
+
+/**
+ * @struct Entry
+ * @brief Timings and counters of a benchmark configuration.
+ */
+struct Entry {
+  std::map<std::string, Stats> phases;
+  std::map<std::string, long> counters;
+};
+
+/**
+ * @brief Convert an entry to JSON.
+ */
+inline nlohmann::json to_json(Entry const& entry) {
+  nlohmann::json json;
+  for (auto const& phase : entry.phases) {
+    json["phases"][phase.first] = {
+      { "median", phase.second.median },
+      { "mad",    phase.second.mad },
+      { "runs",   phase.second.runs }
+    };
+  }
+  for (auto const& counter : entry.counters)
+    json["counters"][counter.first] = counter.second;
+  return json;
+}
+
+/**
+ * @brief Convert JSON to an entry.
+ */
+inline Entry from_json(nlohmann::json const& json) {
+  Entry entry;
+  if (json.count("phases")) {
+    for (auto const& phase : json["phases"].items()) {
+      Stats stats;
+      stats.median = phase.value().at("median").get<float>();
+      stats.mad    = phase.value().at("mad").get<float>();
+      stats.runs   = phase.value().at("runs").get<int>();
+      entry.phases[phase.key()] = stats;
+    }
+  }
+  if (json.count("counters")) {
+    for (auto const& counter : json["counters"].items())
+      entry.counters[counter.key()] = counter.value().get<long>();
+  }
+  return entry;
+}
+
+/**
+ * @brief Load a baseline file.
+ *
+ * @param path: baseline file path.
+ * @return its JSON content, or an empty object if it does not exist.
+ */
+inline nlohmann::json load(std::string const& path) {
+  nlohmann::json json = nlohmann::json::object();
+  std::ifstream file(path);
+  if (file.good()) {
+    try {
+      file >> json;
+    } catch (nlohmann::json::parse_error& e) {
+      std::fprintf(stderr, "Invalid baseline file '%s': %s\n", path.data(), e.what());
+      json = nlohmann::json::object();
+    }
+  }
+  return json;
+}
+
+/**
+ * @brief Store a baseline file.
+ *
+ * @param path: baseline file path.
+ * @param json: its content.
+ * @return true if the file was written.
+ */
+inline bool store(std::string const& path, nlohmann::json const& json) {
+  std::ofstream file(path);
+  if (not file.good()) {
+    std::fprintf(stderr, "Could not open file :%s\n", path.data());
+    return false;
+  }
+  file << json.dump(2) << std::endl;
+  return true;
+}
+
+/**
+ * @brief Compare a run against its baseline and print a report.
+ *
+ * @param config: the configuration key.
+ * @param base: the baseline entry.
+ * @param run: the new run entry.
+ * @param thresholds: regression thresholds.
+ * @return number of regressed phases, or -1 if the workload differs.
+ */
+inline int compare(std::string const& config, Entry const& base,
+                   Entry const& run, Thresholds const& thresholds) {
+
+  std::printf("\nRegression check: %s\n", config.data());
+
+  for (auto const& counter : run.counters) {
+    auto const it = base.counters.find(counter.first);
+    if (it != base.counters.end() and it->second != counter.second) {
+      std::printf(" • workload changed: %s %ld -> %ld, timings not comparable\n",
+                  counter.first.data(), it->second, counter.second);
+      return -1;
+    }
+  }
+
+  int regressions = 0;
+  std::printf(" %-12s %10s %10s %9s %10s  %s\n",
+              "phase", "base (s)", "run (s)", "delta", "threshold", "status");
+
+  for (auto const& phase : run.phases) {
+    auto const it = base.phases.find(phase.first);
+    if (it == base.phases.end())
+      continue;
+
+    Stats const& old = it->second;
+    Stats const& now = phase.second;
+    double const delta = now.median - old.median;
+    double const threshold = std::max({ thresholds.relative * old.median,
+                                        thresholds.noise * 1.4826 * (old.mad + now.mad),
+                                        thresholds.absolute });
+    char const* status = "ok";
+    if (delta > threshold) {
+      status = "\e[31mREGRESSION\e[0m";
+      regressions++;
+    } else if (-delta > threshold)
+      status = "\e[32mimproved\e[0m";
+
+    std::printf(" %-12s %10.3f %10.3f %+8.1f%% %10.3f  %s\n",
+                phase.first.data(), old.median, now.median,
+                old.median > 0 ? 100. * delta / old.median : 0.,
+                threshold, status);
+  }
+  std::fflush(stdout);
+  return regressions;
+}
+
+} // namespace regression
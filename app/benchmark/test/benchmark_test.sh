@@ -0,0 +1,39 @@
+#!/bin/bash
+: <<'END'
+This file is part of the Ristra portage project.
+Please see the license file at the root of this repository, or at:
+    https://github.com/laristra/portage/blob/master/LICENSE
+END
+
+
+# Exit on error
+set -e
+# Echo each command
+set -x
+
+rm -f benchmark_test.dat
+
+# 2d 1st and 2nd order remaps on small synthetic meshes
+${RUN_COMMAND} ${TESTAPPDIR}/benchmark --dim=2 --nsourcecells=8 --ntargetcells=10 \
+  --mesh=perturbed --remap_order=1 --repeat=1 --output=benchmark_test.dat
+${RUN_COMMAND} ${TESTAPPDIR}/benchmark --dim=2 --nsourcecells=8 --ntargetcells=10 \
+  --mesh=rotated --remap_order=2 --repeat=1 --output=benchmark_test.dat
+
+# 3d 2nd order remap through MMDriver
+${RUN_COMMAND} ${TESTAPPDIR}/benchmark --dim=3 --nsourcecells=4 --ntargetcells=5 \
+  --remap_order=2 --driver=mmdriver --repeat=1 --output=benchmark_test.dat
+
+# one record per run
+test $(grep -vc -e '^#' -e '^$' benchmark_test.dat) -eq 3
+
+# record a baseline then check against it with a loose tolerance
+rm -f benchmark_test.json
+${RUN_COMMAND} ${TESTAPPDIR}/benchmark --dim=2 --nsourcecells=8 --ntargetcells=10 \
+  --repeat=3 --output=benchmark_test.dat --baseline=benchmark_test.json
+${RUN_COMMAND} ${TESTAPPDIR}/benchmark --dim=2 --nsourcecells=8 --ntargetcells=10 \
+  --repeat=3 --output=benchmark_test.dat --baseline=benchmark_test.json \
+  --tolerance=100
+
+# same remap on a geometry cache of the source mesh
+${RUN_COMMAND} ${TESTAPPDIR}/benchmark --dim=3 --nsourcecells=4 --ntargetcells=5 \
+  --remap_order=2 --geometry_cache=y --repeat=1 --output=benchmark_test.dat
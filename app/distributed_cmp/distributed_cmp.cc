@@ -10,14 +10,28 @@ Please see the license file at the root of this repository, or at:
 #include <string>
 #include <utility>
 #include <sstream>
-#include <map>
+#include <vector>
 #include <cmath>
 #include <iomanip>
 
+#include "field_io.h"
+
 double DEFAULT_TOLERANCE=1.e-14;
 
 void print_usage() {
   std::printf("Usage: distributed_cmp file_serial tol=%e\n", DEFAULT_TOLERANCE);
+  std::printf("Files are either text files of 'gid matid value' lines or\n"
+              "binary field files, distributed ones being suffixed by rank.\n");
+}
+
+// read a field file, reporting text files that cannot be fully parsed
+field_io::sorted_field_t read_field(std::string const& filename) {
+  try {
+    return field_io::sorted_field_t(filename, true);
+  } catch (field_io::read_error const&) {
+    std::cout << "DATA READ FAILED!" << std::endl;
+    throw;
+  }
 }
 
 int main(int argc, char** argv) {
@@ -27,13 +41,6 @@ int main(int argc, char** argv) {
     return 1;
   }
   
-  // vars for unpacking the file  
-  int gid,matid;
-  double value;
-  
-  std::pair<int,int> key;
-  std::map<std::pair<int,int>,double> serial_map, distributed_map;
-  
   // base filename
   std::string base_filename=argv[1];
   
@@ -51,92 +58,79 @@ int main(int argc, char** argv) {
   // process the serial file
   /////////////////////////////// 
   
-  std::ifstream f;
-  
-  f.open(base_filename);
-  
   // make sure the serial file is good
-  if (!f) throw std::runtime_error("Serial file " + base_filename +  " cannot be opened.");
-  
-  // read the file and unpack the tokens
-  while (f >> gid >> matid >> value){
+  if (!std::ifstream(base_filename))
+    throw std::runtime_error("Serial file " + base_filename +  " cannot be opened.");
   
-    //std::cout << gid << " " << matid << " " << value << "\n";
-    
-    // construct the pair key
-    key = std::make_pair(gid,matid);
-    
-    // does the key already exist
-    if (serial_map.find(key)!=serial_map.end())
-    {
+  // entries are sorted by key (gid, matid)
+  field_io::sorted_field_t const serial = read_field(base_filename);
+  std::size_t const nb_serial = serial.size();
+
+  // duplicated keys are adjacent
+  for (std::size_t i = 1; i < nb_serial; ++i) {
+    if (serial.gid(i) == serial.gid(i-1) && serial.matid(i) == serial.matid(i-1)) {
       error_string << "Serial file " << base_filename <<  
-        " had a duplicated key (gid, matid)=(" << gid << ", " << matid << ")";      
+        " had a duplicated key (gid, matid)=(" << serial.gid(i) << ", "
+        << serial.matid(i) << ")";
       throw std::runtime_error(error_string.str());
     }
-    
-    // add the key to the map
-    serial_map[key]=value;
-    
   }
 
-  f.close();
-  
+  // whether each serial key was found in a distributed file
+  std::vector<char> found(nb_serial, 0);
+  std::size_t nb_found = 0;
+
   // loop through partitions
   int rank=0;
   
   while (true) {
       
-    // open the serial file
-    f.open(base_filename + "." + std::to_string(rank));
-  
-    // make sure the serial file is good
-    if (!f) break;
+    std::string const filename = base_filename + "." + std::to_string(rank);
+
+    // make sure the distributed file is good
+    if (!std::ifstream(filename)) break;
   
-    //std::cout << "processing rank: " << rank <<"\n\n";
-    
-    // read the file and unpack the tokens
-    while (f >> gid >> matid >> value){
-    
-    
-      //std::cout<<gid<<" "<<matid<<" "<<value<<"\n";
-      
-      // construct the pair key
-      key = std::make_pair(gid,matid);
+    // merge the sorted distributed entries with the serial ones
+    field_io::sorted_field_t const distributed = read_field(filename);
+    std::size_t const nb_distributed = distributed.size();
+    std::size_t j = 0;
+
+    for (std::size_t i = 0; i < nb_distributed; ++i) {
+
+      int const gid = distributed.gid(i);
+      int const matid = distributed.matid(i);
+      double const value = distributed.value(i);
       
+      j = serial.lower_bound(gid, matid, j);
+
       // check the distributed data is correct
-      if (serial_map.find(key)==serial_map.end())
+      if (j == nb_serial || serial.gid(j) != gid || serial.matid(j) != matid)
       {      
-        // the key is not found in the serial map  
-        error_string << "Distributed file: " << base_filename << "." << rank <<
+        // the key is not found in the serial file
+        error_string << "Distributed file: " << filename <<
           " had a key (gid, matid): (" << gid << ", " << matid << 
           ") not in the serial file";      
         throw std::runtime_error(error_string.str());
       } 
-      else if (serial_map.find(key)!=serial_map.end() &&
-               std::fabs(value-serial_map[key])>tol)
+      else if (std::fabs(value-serial.value(j))>tol)
       {      
         
         // the key is already registered but with a different value  
-        error_string << "Distributed file: " << base_filename << "." << rank <<
+        error_string << "Distributed file: " << filename <<
           " had a conflicting key: (" << gid << ", " << matid << 
           "). Serial value: " << std::fixed << std::setprecision(16) 
-           << serial_map[key] << " Distributed value: " << value
-           << std::scientific << " Error: " << std::fabs(value-serial_map[key])
+           << serial.value(j) << " Distributed value: " << value
+           << std::scientific << " Error: " << std::fabs(value-serial.value(j))
            << " Tolerance: " << tol;      
         throw std::runtime_error(error_string.str());
       }
-      else
+      else if (!found[j])
       {   
-        // key is good, add the key to the map
-        distributed_map[key]=value;
+        // key is good, mark it as found
+        found[j] = 1;
+        nb_found++;
       }
-      
     }
-  
-    if (f.fail() && !f.eof()) std::cout << "DATA READ FAILED!\n";
-    
-    // clean up
-    f.close();
     
     // bump the partition
     rank++;
@@ -150,7 +144,7 @@ int main(int argc, char** argv) {
     throw std::runtime_error("No partitions were found for  " + base_filename);
     
   // make sure there are no missing keys in the distributed files
-  if (distributed_map.size() < serial_map.size()) 
+  if (nb_found < nb_serial) 
     throw std::runtime_error("The distributed files missed keys from the serial run");
 
   std::cout << "Success!\n\n";
@@ -18,3 +18,13 @@ set -x
 
 $APPDIR/distributed_cmp field.txt 
 
+# same fields as binary files
+for suffix in "" .0 .1 .2; do
+  $FIELD_IO field.txt$suffix field.bin$suffix 1
+done
+$APPDIR/distributed_cmp field.bin
+
+# text files that cannot be parsed are reported
+printf "0 0 1.0\n1 0 x\n" > bad.txt
+cp field.txt.0 bad.txt.0
+(! $APPDIR/distributed_cmp bad.txt) | grep "DATA READ FAILED"
@@ -0,0 +1,287 @@
+/*
+  This file is part of the Ristra portage project.
+  Please see the license file at the root of this repository, or at:
+  https://github.com/laristra/portage/blob/master/LICENSE
+*/
+
+#ifndef PORTAGEAPP_FIELD_IO_H_
+#define PORTAGEAPP_FIELD_IO_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Binary columnar format of remapped field values, used by the apps
+// to dump their results and by the comparison tools to check them.
+//
+// Each rank writes its own file, without any gather. A file starts with
+// a fixed-size header giving the number of entries and the offset of
+// each column, followed by the columns themselves: global ids, material
+// ids (only for multi-material fields) and values. Entries are sorted by
+// (global id, material id) so that files can be compared by a merge.
+// Files are read back by mapping them in memory, without any parsing.
+//
+// Files are native-endian: they are meant to be compared on the machine
+// that produced them.
+
+namespace field_io {
+
+// header of a field file
+struct header_t {
+  char magic[8];                  // format identifier
+  std::uint64_t count;            // number of entries
+  std::uint64_t gid_offset;       // offset of global ids (int32)
+  std::uint64_t matid_offset;     // offset of material ids (int32), 0 if none
+  std::uint64_t value_offset;     // offset of values (double)
+};
+
+constexpr char magic[8] = {'P', 'O', 'R', 'T', 'F', 'L', 'D', '1'};
+
+// error raised on a malformed text field file
+struct read_error : public std::runtime_error {
+  using std::runtime_error::runtime_error;
+};
+
+// Check if a filename requests the binary format.
+inline bool is_binary_filename(std::string const& filename) {
+  std::string const extension = ".bin";
+  return filename.size() >= extension.size()
+         and filename.compare(filename.size() - extension.size(),
+                              extension.size(), extension) == 0;
+}
+
+// Check if a file is in the binary format.
+inline bool is_binary_file(std::string const& filename) {
+  char buffer[sizeof(magic)] = {};
+  std::ifstream file(filename, std::ios::binary);
+  file.read(buffer, sizeof(magic));
+  return file and std::memcmp(buffer, magic, sizeof(magic)) == 0;
+}
+
+// Write field values in binary format.
+// Material ids may be empty for single-material fields.
+inline void write(std::string const& filename,
+                  std::vector<int> const& gids,
+                  std::vector<int> const& matids,
+                  std::vector<double> const& values) {
+
+  std::size_t const count = gids.size();
+  bool const has_matids = not matids.empty();
+  if (values.size() != count or (has_matids and matids.size() != count))
+    throw std::runtime_error("field_io: mismatched column sizes");
+
+  // sort entries by key
+  std::vector<std::size_t> order(count);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](std::size_t i, std::size_t j) {
+    return has_matids ? std::tie(gids[i], matids[i]) < std::tie(gids[j], matids[j])
+                      : gids[i] < gids[j];
+  });
+
+  std::vector<std::int32_t> sorted_gids(count), sorted_matids(has_matids ? count : 0);
+  std::vector<double> sorted_values(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    sorted_gids[i] = gids[order[i]];
+    sorted_values[i] = values[order[i]];
+    if (has_matids)
+      sorted_matids[i] = matids[order[i]];
+  }
+
+  // align each column on 8 bytes
+  auto align = [](std::uint64_t offset) { return (offset + 7) & ~std::uint64_t(7); };
+
+  header_t header {};
+  std::memcpy(header.magic, magic, sizeof(magic));
+  header.count = count;
+  header.gid_offset = align(sizeof(header_t));
+  header.matid_offset = has_matids ? align(header.gid_offset + 4 * count) : 0;
+  header.value_offset = align((has_matids ? header.matid_offset : header.gid_offset) + 4 * count);
+
+  std::ofstream file(filename, std::ios::binary);
+  if (not file)
+    throw std::runtime_error("field_io: cannot open " + filename);
+
+  auto write_at = [&](std::uint64_t offset, void const* data, std::size_t size) {
+    file.seekp(offset);
+    file.write(static_cast<char const*>(data), size);
+  };
+
+  write_at(0, &header, sizeof(header_t));
+  write_at(header.gid_offset, sorted_gids.data(), 4 * count);
+  if (has_matids)
+    write_at(header.matid_offset, sorted_matids.data(), 4 * count);
+  write_at(header.value_offset, sorted_values.data(), 8 * count);
+
+  if (not file)
+    throw std::runtime_error("field_io: cannot write " + filename);
+}
+
+// Read-only view of a binary field file mapped in memory.
+class mapped_field_t {
+public:
+  explicit mapped_field_t(std::string const& filename) {
+    int const fd = ::open(filename.data(), O_RDONLY);
+    if (fd < 0)
+      throw std::runtime_error("field_io: cannot open " + filename);
+
+    struct stat info {};
+    if (::fstat(fd, &info) != 0 or info.st_size < static_cast<off_t>(sizeof(header_t))) {
+      ::close(fd);
+      throw std::runtime_error("field_io: invalid file " + filename);
+    }
+
+    size_ = info.st_size;
+    data_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data_ == MAP_FAILED)
+      throw std::runtime_error("field_io: cannot map " + filename);
+
+    header_t const& header = *static_cast<header_t const*>(data_);
+    bool const valid =
+      std::memcmp(header.magic, magic, sizeof(magic)) == 0
+      and header.gid_offset + 4 * header.count <= size_
+      and (header.matid_offset == 0 or header.matid_offset + 4 * header.count <= size_)
+      and header.value_offset + 8 * header.count <= size_;
+
+    if (not valid) {
+      ::munmap(data_, size_);
+      throw std::runtime_error("field_io: invalid file " + filename);
+    }
+    header_ = header;
+  }
+
+  ~mapped_field_t() { ::munmap(data_, size_); }
+
+  mapped_field_t(mapped_field_t const&) = delete;
+  mapped_field_t& operator=(mapped_field_t const&) = delete;
+
+  std::size_t size() const { return header_.count; }
+  bool has_matids() const { return header_.matid_offset != 0; }
+
+  std::int32_t const* gids() const { return column<std::int32_t>(header_.gid_offset); }
+  std::int32_t const* matids() const { return column<std::int32_t>(header_.matid_offset); }
+  double const* values() const { return column<double>(header_.value_offset); }
+
+private:
+  template<class T>
+  T const* column(std::uint64_t offset) const {
+    return offset ? reinterpret_cast<T const*>(static_cast<char const*>(data_) + offset)
+                  : nullptr;
+  }
+
+  void* data_ = nullptr;
+  std::size_t size_ = 0;
+  header_t header_ {};
+};
+
+// Field entries sorted by (global id, material id), either mapped from a
+// binary file or parsed from a text file of 'gid [matid] value' lines.
+// A text file that cannot be parsed up to its end raises a read_error.
+class sorted_field_t {
+public:
+  sorted_field_t(std::string const& filename, bool text_matids) {
+    if (is_binary_file(filename)) {
+      mapped_.reset(new mapped_field_t(filename));
+      size_ = mapped_->size();
+      gids_ = mapped_->gids();
+      matids_ = mapped_->matids();
+      values_ = mapped_->values();
+      return;
+    }
+
+    std::ifstream file(filename);
+    if (not file)
+      throw std::runtime_error("field_io: cannot open " + filename);
+
+    std::vector<int> gids, matids;
+    std::vector<double> values;
+    int gid, matid = 0;
+    double value;
+    bool complete = true;
+    while (file >> gid) {
+      if ((text_matids and not (file >> matid)) or not (file >> value)) {
+        complete = false;
+        break;
+      }
+      gids.push_back(gid);
+      values.push_back(value);
+      if (text_matids)
+        matids.push_back(matid);
+    }
+
+    // the stream of a well-formed file only fails at its end
+    if (not complete or not file.eof())
+      throw read_error("field_io: cannot read entry " + std::to_string(gids.size())
+                       + " of " + filename);
+
+    size_ = gids.size();
+    std::vector<std::size_t> order(size_);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t i, std::size_t j) {
+      return text_matids ? std::tie(gids[i], matids[i]) < std::tie(gids[j], matids[j])
+                         : gids[i] < gids[j];
+    });
+
+    text_gids_.resize(size_);
+    text_values_.resize(size_);
+    text_matids_.resize(text_matids ? size_ : 0);
+    for (std::size_t i = 0; i < size_; ++i) {
+      text_gids_[i] = gids[order[i]];
+      text_values_[i] = values[order[i]];
+      if (text_matids)
+        text_matids_[i] = matids[order[i]];
+    }
+
+    gids_ = text_gids_.data();
+    matids_ = text_matids ? text_matids_.data() : nullptr;
+    values_ = text_values_.data();
+  }
+
+  std::size_t size() const { return size_; }
+  int gid(std::size_t i) const { return gids_[i]; }
+  int matid(std::size_t i) const { return matids_ ? matids_[i] : 0; }
+  double value(std::size_t i) const { return values_[i]; }
+
+  // Find the first entry whose key is not less than a given one,
+  // searching from a given position.
+  std::size_t lower_bound(int gid, int matid, std::size_t from = 0) const {
+    std::size_t first = from, count = size_ - from;
+    while (count > 0) {
+      std::size_t const step = count / 2;
+      std::size_t const i = first + step;
+      if (std::make_pair(gids_[i], this->matid(i)) < std::make_pair(gid, matid)) {
+        first = i + 1;
+        count -= step + 1;
+      } else
+        count = step;
+    }
+    return first;
+  }
+
+private:
+  std::unique_ptr<mapped_field_t> mapped_;
+  std::vector<std::int32_t> text_gids_, text_matids_;
+  std::vector<double> text_values_;
+  std::size_t size_ = 0;
+  std::int32_t const* gids_ = nullptr;
+  std::int32_t const* matids_ = nullptr;
+  double const* values_ = nullptr;
+};
+
+}  // namespace field_io
+
+#endif  // PORTAGEAPP_FIELD_IO_H_
@@ -11,6 +11,13 @@
 // ExprTk package for expression parsing
 // See http://www.partow.net/programming/exprtk/ for source and examples
 
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
+
 #include "exprtk.hpp"
 #include "wonton/support/Point.h"
 #ifdef HAVE_JALI
@@ -18,7 +25,10 @@
 #endif
 
 // This functor initializes a general field from a string expression
-// and returns its value at any given point
+// and returns its value at any given point.
+// The compiled expression is bound to the x/y/z members of the object,
+// so a copy compiles the expression again against its own variables:
+// each thread can then evaluate its own copy concurrently.
 
 class user_field_t {
 public:
@@ -26,6 +36,7 @@ public:
   double y = 0.;
   double z = 0.;
   int dim_ = 0;
+  std::string expression_str_;
 
   exprtk::symbol_table<double> symbol_table {};
   exprtk::expression<double> expression {};
@@ -34,8 +45,26 @@ public:
   user_field_t() = default;
   ~user_field_t() = default;
 
+  user_field_t(user_field_t const& other) {
+    if (other.dim_ > 0)
+      initialize(other.dim_, other.expression_str_);
+  }
+
+  user_field_t& operator=(user_field_t const& other) {
+    if (this != &other) {
+      symbol_table = exprtk::symbol_table<double>();
+      expression = exprtk::expression<double>();
+      dim_ = 0;
+      expression_str_.clear();
+      if (other.dim_ > 0)
+        initialize(other.dim_, other.expression_str_);
+    }
+    return *this;
+  }
+
   int initialize(int dim, std::string const& expression_str) {
     dim_ = dim;
+    expression_str_ = expression_str;
     assert(dim_ >= 1 && dim_ <= 3);
     if (dim_ > 0) symbol_table.add_variable("x", x);
     if (dim_ > 1) symbol_table.add_variable("y", y);
@@ -82,6 +111,33 @@ public:
       throw std::runtime_error("incompatible dimensions");
   }
 #endif
+
+  // Evaluate the expression at a set of points, in parallel if possible.
+  // Each thread evaluates a copy of the compiled expression.
+  template<class Point>
+  void evaluate(std::vector<Point> const& points, double* values) const {
+    int const nb_points = points.size();
+    if (nb_points == 0)
+      return;
+
+    // evaluate the first point serially so that dimension
+    // mismatches are reported outside of any parallel region
+    user_field_t first(*this);
+    values[0] = first(points[0]);
+
+#ifdef _OPENMP
+    #pragma omp parallel
+    {
+      user_field_t local(*this);
+      #pragma omp for schedule(static)
+      for (int i = 1; i < nb_points; ++i)
+        values[i] = local(points[i]);
+    }
+#else
+    for (int i = 1; i < nb_points; ++i)
+      values[i] = first(points[i]);
+#endif
+  }
 };
 
 
@@ -5,6 +5,7 @@ Please see the license file at the root of this repository, or at:
 */
 
 #include <fstream>
+#include <memory>
 #include <sstream>
 #include <vector>
 
@@ -61,31 +62,6 @@ void print_usage() {
 }
 
 
-/* ******************************************************************
-* Utility that computes corner centroid
-****************************************************************** */
-template<>
-void corner_get_centroid(
-    int cn, const Wonton::Jali_Mesh_Wrapper& mesh,
-    Wonton::Point<3>& xcn)
-{
-  std::vector<int> wedges;
-  std::array<Wonton::Point<3>, 4> wcoords;
-
-  double volume = mesh.corner_volume(cn); 
-  mesh.corner_get_wedges(cn, &wedges);
-
-  xcn = {0.0, 0.0, 0.0};
-  for (auto w : wedges) {
-    double frac = mesh.wedge_volume(w) / volume; 
-    mesh.wedge_get_coordinates(w, &wcoords);
-    for (int i = 0; i < 4; ++i) {
-      xcn += frac * wcoords[i] / 4;
-    }
-  }
-}
-
-
 /* ******************************************************************
 * Main driver for the momentum remap
 ****************************************************************** */
@@ -119,7 +95,7 @@ int main(int argc, char** argv) {
 
   user_field_t ini_rho, ini_velx, ini_vely, ini_velz;
 
-  if ((method != SGH && method != CCH) ||
+  if ((method != Portage::SGH && method != Portage::CCH) ||
       (!ini_rho.initialize(3, formula_rho)) ||
       (!ini_velx.initialize(3, formula_velx)) ||
       (!ini_vely.initialize(3, formula_vely)) ||
@@ -132,7 +108,7 @@ int main(int argc, char** argv) {
     return 0;
   }
 
-  if (numpe > 1 && method == SGH) {
+  if (numpe > 1 && method == Portage::SGH) {
     if (rank == 0) {
       std::cout << "=== Input ERROR ===\n";
       std::cout << "method=SGH runs only in the serial mode, since ghost data\n";
@@ -173,11 +149,21 @@ int main(int argc, char** argv) {
 
   // -- register velocity components with the states
   //    target state does not need data, but code re-use does the task easier
-  MomentumRemap<3, Wonton::Jali_Mesh_Wrapper> mr(method);
+  Wonton::MPIExecutor_type mpiexecutor(MPI_COMM_WORLD);
+  MomentumRemapApp<3, Wonton::Jali_Mesh_Wrapper>
+      mr(static_cast<Portage::Momentum_remap_method>(method), &mpiexecutor);
+
+  // -- corner geometry is shared by initialization, remap and diagnostics
+  using Corners = MomentumRemapApp<3, Wonton::Jali_Mesh_Wrapper>::Corners;
+  std::unique_ptr<Corners> srccorners, trgcorners;
+  if (method == Portage::SGH) {
+    srccorners.reset(new Corners(srcmesh_wrapper));
+    trgcorners.reset(new Corners(trgmesh_wrapper));
+  }
 
   std::vector<double> u_src[3], tmp;
 
-  auto kind = mr.VelocityKind();
+  auto kind = mr.velocity_kind();
   mr.InitVelocity(srcmesh_wrapper, ini_velx, u_src[0]);
   mr.InitVelocity(srcmesh_wrapper, ini_vely, u_src[1]);
   mr.InitVelocity(srcmesh_wrapper, ini_velz, u_src[2]);
@@ -194,18 +180,19 @@ int main(int argc, char** argv) {
   // -- register mass with the states
   std::vector<double> mass_src;
 
-  kind = mr.MassKind();
-  mr.InitMass(srcmesh_wrapper, ini_rho, mass_src);
+  kind = mr.mass_kind();
+  mr.InitMass(srcmesh_wrapper, srccorners.get(), ini_rho, mass_src);
 
   srcstate_wrapper.mesh_add_data(kind, "mass", &(mass_src[0]));
-  mr.InitMass(trgmesh_wrapper, ini_rho, tmp);
+  mr.InitMass(trgmesh_wrapper, trgcorners.get(), ini_rho, tmp);
   trgstate_wrapper.mesh_add_data(kind, "mass", &(tmp[0]));
 
   // -- summary
-  auto total_mass_src = mr.TotalMass(srcmesh_wrapper, mass_src);
-  auto total_momentum_src = mr.TotalMomentum(srcmesh_wrapper, mass_src, u_src);
-  auto umin = mr.VelocityMin(srcmesh_wrapper, u_src);
-  auto umax = mr.VelocityMax(srcmesh_wrapper, u_src);
+  auto summary_src = mr.diagnostics(srcmesh_wrapper, mass_src, u_src, srccorners.get());
+  auto total_mass_src = summary_src.mass;
+  auto total_momentum_src = summary_src.momentum;
+  auto umin = summary_src.umin;
+  auto umax = summary_src.umax;
   if (rank == 0) {
     std::cout << "=== SOURCE data ===" << std::endl;
     std::cout << "mesh:           " << nx << " x " << ny << " x " << nz << std::endl;
@@ -216,11 +203,11 @@ int main(int argc, char** argv) {
   }
 
   //
-  // SEVEN-step REMAP algorithm 
+  // FIVE-step REMAP algorithm
   //
-  mr.RemapND<Wonton::Jali_State_Wrapper>(srcmesh_wrapper, srcstate_wrapper,
-                                         trgmesh_wrapper, trgstate_wrapper,
-                                         limiter);
+  mr.remap(srcmesh_wrapper, srcstate_wrapper,
+           trgmesh_wrapper, trgstate_wrapper,
+           limiter, srccorners.get(), trgcorners.get());
 
   //
   // Verification 
@@ -228,19 +215,20 @@ int main(int argc, char** argv) {
   const double *mass_trg;
   const double *u_trg[3];
 
-  kind = mr.MassKind();
+  kind = mr.mass_kind();
   trgstate_wrapper.mesh_get_data(kind, "mass", &mass_trg);
 
-  kind = mr.VelocityKind();
+  kind = mr.velocity_kind();
   trgstate_wrapper.mesh_get_data(kind, "velocity_x", &u_trg[0]);
   trgstate_wrapper.mesh_get_data(kind, "velocity_y", &u_trg[1]);
   trgstate_wrapper.mesh_get_data(kind, "velocity_z", &u_trg[2]);
 
   // use 2D/3D routines with dummy parameters 
-  auto total_mass_trg = mr.TotalMass(trgmesh_wrapper, mass_trg);
-  auto total_momentum_trg = mr.TotalMomentum(trgmesh_wrapper, mass_trg, u_trg);
-  umin = mr.VelocityMin(trgmesh_wrapper, u_trg);
-  umax = mr.VelocityMax(trgmesh_wrapper, u_trg);
+  auto summary_trg = mr.diagnostics(trgmesh_wrapper, mass_trg, u_trg, trgcorners.get());
+  auto total_mass_trg = summary_trg.mass;
+  auto total_momentum_trg = summary_trg.momentum;
+  umin = summary_trg.umin;
+  umax = summary_trg.umax;
 
   if (rank == 0) {
     std::cout << "\n=== TARGET data ===" << std::endl;
@@ -9,10 +9,19 @@
 // ExprTk package for expression parsing
 // See http://www.partow.net/programming/exprtk/ for source and examples
 
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
+
 #include "exprtk.hpp"
 
 // This functor initializes a general field from a string expression
-// and returns its value at any given point
+// and returns its value at any given point.
+// As for user_field_t, a copy compiles the expression again against
+// its own variables so that threads can filter points concurrently.
 
 class filter_t {
 
@@ -21,9 +30,25 @@ public:
    filter_t() = default;
   ~filter_t() = default;
 
+  filter_t(filter_t const& other) {
+    if (other.dim_ > 0)
+      initialize(other.dim_, other.user_expression);
+  }
+
+  filter_t& operator=(filter_t const& other) {
+    if (this != &other) {
+      reset();
+      if (other.dim_ > 0)
+        initialize(other.dim_, other.user_expression);
+    }
+    return *this;
+  }
+
   bool initialize(int dim, std::string const& expression_str) {
     assert(dim >= 1 and dim <= 3);
 
+    // allow reuse for another expression
+    reset();
     user_expression = expression_str;
 
     // register variables and symbol table
@@ -64,7 +89,40 @@ public:
     return expression.value() != 0;
   }
 
+  // Retrieve the indices of the points satisfying the predicate,
+  // in increasing order. Points are tested in parallel if possible.
+  template<class Point>
+  std::vector<int> select(std::vector<Point> const& points) const {
+    int const nb_points = points.size();
+    std::vector<char> selected(nb_points, 0);
+
+#ifdef _OPENMP
+    #pragma omp parallel
+#endif
+    {
+      filter_t local(*this);
+#ifdef _OPENMP
+      #pragma omp for schedule(static)
+#endif
+      for (int i = 0; i < nb_points; ++i)
+        selected[i] = local(points[i]);
+    }
+
+    std::vector<int> indices;
+    for (int i = 0; i < nb_points; ++i)
+      if (selected[i])
+        indices.push_back(i);
+    return indices;
+  }
+
 private:
+  void reset() {
+    symbol_table = exprtk::symbol_table<double>();
+    expression = exprtk::expression<double>();
+    user_expression.clear();
+    dim_ = 0;
+  }
+
   double x = 0;
   double y = 0;
   double z = 0;
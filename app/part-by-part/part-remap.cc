@@ -560,32 +560,30 @@ void remap<2>(std::string field, int nb_parts,
                                           Wonton::Jali_Mesh_Wrapper,
                                           Wonton::Jali_State_Wrapper>;
 
-  using PartPair = Portage::PartPair<2, Wonton::Jali_Mesh_Wrapper,
-                                        Wonton::Jali_State_Wrapper>;
-
-
-  std::vector<PartPair> parts_manager;
-  parts_manager.reserve(nb_parts);
+  using PartBatch = Portage::PartBatch<2, Wonton::Jali_Mesh_Wrapper,
+                                          Wonton::Jali_State_Wrapper>;
 
-  for (int i = 0; i < nb_parts; ++i) {
-    // create source-target mesh parts manager and
-    // populate cell lists for the current part.
-    parts_manager.emplace_back(source_mesh_wrapper, source_state_wrapper,
-                               target_mesh_wrapper, target_state_wrapper,
-                               source_cells[i], target_cells[i], executor);
-  }
+  // create source-target mesh parts managers and
+  // tag cells with the part they belong to.
+  PartBatch parts_manager(source_mesh_wrapper, source_state_wrapper,
+                          target_mesh_wrapper, target_state_wrapper,
+                          source_cells, target_cells, executor);
 
-  // perform remap kernels.
+  // perform remap kernels for all parts at once,
+  // skipping intersections of cells from different parts.
   Remapper remapper(source_mesh_wrapper, source_state_wrapper,
                     target_mesh_wrapper, target_state_wrapper);
 
   auto candidates = remapper.search<Portage::SearchKDTree>();
+  parts_manager.filter_candidates(candidates);
   auto weights = remapper.intersect_meshes<Portage::IntersectR2D>(candidates);
 
+  // compute volumes of intersection and test for parts boundaries mismatch.
+  parts_manager.check_mismatch(weights);
+
   // use the right interpolator according to the requested order of remap.
   auto interpolate = [&](auto* current_part) {
-    Portage::vector<Wonton::Vector<2>> *gradients = nullptr;
-    auto const source_part = current_part->source();
+    Portage::vector<Wonton::Vector<2>> gradients;
 
     switch (params.order) {
       case 1: 
@@ -596,12 +594,12 @@ void remap<2>(std::string field, int nb_parts,
               
       break;
 
-      case 2: *gradients = remapper.compute_source_gradient(field, params.limiter,
-                                                            params.bnd_limiter,0,
-                                                            &source_part);
+      case 2: gradients = remapper.compute_source_gradient(field, params.limiter,
+                                                           params.bnd_limiter,0,
+                                                           &(current_part->source()));
 
         remapper.interpolate_mesh_var<double, Portage::Interpolate_2ndOrder>(
-          field, field, weights, current_part, gradients
+          field, field, weights, current_part, &gradients
         );
         
       break;
@@ -616,14 +614,9 @@ void remap<2>(std::string field, int nb_parts,
 
   };
 
-  for (int i = 0; i < nb_parts; ++i) {
-  
-    // compute volumes of intersection and test for parts boundaries mismatch.
-    parts_manager[i].check_mismatch(weights);
-
-    // interpolate field for each part and fix partially filled or empty cells.
-    interpolate(parts_manager.data() + i);
-  }
+  // interpolate field for each part and fix partially filled or empty cells.
+  for (int i = 0; i < nb_parts; ++i)
+    interpolate(&(parts_manager[i]));
 }
 
 /**
@@ -657,26 +650,26 @@ void remap<3>(std::string field, int nb_parts,
                                           Wonton::Jali_Mesh_Wrapper,
                                           Wonton::Jali_State_Wrapper>;
 
-  using PartPair = Portage::PartPair<3, Wonton::Jali_Mesh_Wrapper,
-                                        Wonton::Jali_State_Wrapper>;
-
-  std::vector<PartPair> parts_manager;
-  parts_manager.reserve(nb_parts);
+  using PartBatch = Portage::PartBatch<3, Wonton::Jali_Mesh_Wrapper,
+                                          Wonton::Jali_State_Wrapper>;
 
-  // filter cells and populate lists
-  for (int i = 0; i < nb_parts; ++i) {
-    parts_manager.emplace_back(source_mesh_wrapper, source_state_wrapper,
-                               target_mesh_wrapper, target_state_wrapper,
-                               source_cells[i], target_cells[i], executor);
-  }
+  // filter cells, populate lists and tag cells with their part
+  PartBatch parts_manager(source_mesh_wrapper, source_state_wrapper,
+                          target_mesh_wrapper, target_state_wrapper,
+                          source_cells, target_cells, executor);
 
-  // perform remap kernels.
+  // perform remap kernels for all parts at once,
+  // skipping intersections of cells from different parts.
   Remapper remapper(source_mesh_wrapper, source_state_wrapper,
                     target_mesh_wrapper, target_state_wrapper);
 
   auto candidates = remapper.search<Portage::SearchKDTree>();
+  parts_manager.filter_candidates(candidates);
   auto weights = remapper.intersect_meshes<Portage::IntersectR3D>(candidates);
 
+  // compute volumes of intersection and test for parts boundaries mismatch.
+  parts_manager.check_mismatch(weights);
+
   // use the right interpolator according to the requested order of remap.
   auto interpolate = [&](auto* current_part) {
     Portage::vector<Wonton::Vector<3>> gradients;
@@ -688,6 +681,8 @@ void remap<3>(std::string field, int nb_parts,
           field, field, weights, current_part
         );
               
+      break;
+
       case 2: 
       
         gradients = remapper.compute_source_gradient(field, params.limiter,
@@ -709,13 +704,9 @@ void remap<3>(std::string field, int nb_parts,
       params.partial_fixup, params.empty_fixup);
   };
 
-  for (int i = 0; i < nb_parts; ++i) {
-    // compute volumes of intersection and test for parts boundaries mismatch.
-    parts_manager[i].check_mismatch(weights);
-
-    // interpolate field for each part and fix partially filled or empty cells.
-    interpolate(parts_manager.data() + i);
-  }
+  // interpolate field for each part and fix partially filled or empty cells.
+  for (int i = 0; i < nb_parts; ++i)
+    interpolate(&(parts_manager[i]));
 }
 
 /**
@@ -825,6 +816,14 @@ int main(int argc, char* argv[]) {
     std::printf("\n");
   }
 
+  // cell centroids used to evaluate fields and part predicates
+  std::vector<JaliGeometry::Point> source_centroids(nb_source_cells);
+  std::vector<JaliGeometry::Point> target_centroids(nb_target_cells);
+  for (long c = 0; c < nb_source_cells; c++)
+    source_centroids[c] = source_mesh->cell_centroid(c);
+  for (long c = 0; c < nb_target_cells; c++)
+    target_centroids[c] = target_mesh->cell_centroid(c);
+
   // assign scalar fields
   for (auto&& field : params.fields) {
     double* field_data = nullptr;
@@ -836,12 +835,11 @@ int main(int argc, char* argv[]) {
     // evaluate field expression and assign it
     user_field_t source_field;
     if(source_field.initialize(params.dimension, field.second)) {
-      for (long c = 0; c < nb_source_cells; c++) {
-        field_data[c] = source_field(source_mesh->cell_centroid(c));
-        #if DEBUG_PART_BY_PART
+      source_field.evaluate(source_centroids, field_data);
+      #if DEBUG_PART_BY_PART
+        for (long c = 0; c < nb_source_cells; c++)
           std::printf("field_data[%d]: %.3f\n", c, field_data[c]);
-        #endif
-      }
+      #endif
     } else
       return abort("cannot parse numerical field "+ field.second, false);
   }
@@ -876,28 +874,16 @@ int main(int argc, char* argv[]) {
     // with respect to user-defined predicates.
     for (int i = 0; i < nb_parts; ++i) {
       auto const& part = params.parts[field][i];
-      source_cells[i].reserve(nb_source_cells);
-      target_cells[i].reserve(nb_target_cells);
 
       // populate source part entities
-      if (filter.initialize(params.dimension, part.source)) {
-        for (long s = 0; s < nb_source_cells; ++s) {
-          if (filter(source_mesh->cell_centroid(s)))
-            source_cells[i].push_back(s);
-        }
-        source_cells[i].shrink_to_fit();
-      }
+      if (filter.initialize(params.dimension, part.source))
+        source_cells[i] = filter.select(source_centroids);
       else
         return abort("cannot filter source part cells for field "+field, false);
 
       // populate target part entities
-      if (filter.initialize(params.dimension, part.target)) {
-        for (long t = 0; t < nb_target_cells; ++t) {
-          if (filter(target_mesh->cell_centroid(t)))
-            target_cells[i].push_back(t);
-        }
-        target_cells[i].shrink_to_fit();
-      }
+      if (filter.initialize(params.dimension, part.target))
+        target_cells[i] = filter.select(target_centroids);
       else
         return abort("cannot filter target part cells for field "+field, false);
 
@@ -1001,12 +987,14 @@ int main(int argc, char* argv[]) {
         }
 
         // compute cell error
+        std::vector<double> exact_target_values(nb_target_cells);
+        exact_value.evaluate(target_centroids, exact_target_values.data());
+
         for (int t = 0; t < nb_target_cells; ++t) {
           min_target_val = std::min(target_field_data[t], min_target_val);
           max_target_val = std::max(target_field_data[t], max_target_val);
           // compute difference between exact and remapped value
-          auto const& centroid = target_mesh->cell_centroid(t);
-          auto const error = exact_value(centroid) - target_field_data[t];
+          auto const error = exact_target_values[t] - target_field_data[t];
           auto const cell_volume = target_mesh_wrapper.cell_volume(t);
           // update L^p norm error and target mass
           error_l1 += std::abs(error) * cell_volume;
@@ -1071,49 +1059,25 @@ int main(int argc, char* argv[]) {
 
     MPI_Barrier(comm);
 
-    std::vector<int> index_helper;
     std::vector<int> local_index;
-    std::vector<int> global_index;
     std::vector<double> local_field;
-    std::vector<double> global_field;
     double* field_data = nullptr;
 
-    local_index.resize(nb_target_cells);
-    local_field.resize(nb_target_cells);
-
     // dump each field in a separate file
     for (auto&& field : params.fields) {
       // retrieve cell global indices and field values for current rank
+      local_index.resize(nb_target_cells);
+      local_field.resize(nb_target_cells);
       for (auto c = 0; c < nb_target_cells; ++c)
         local_index[c] = target_mesh->GID(c, Jali::Entity_kind::CELL);
 
       target_state_wrapper.mesh_get_data(entity::cell, field.first, &field_data);
       std::copy(field_data, field_data + nb_target_cells, local_field.begin());
 
-      // append local index and values lists to master rank global lists
-      Portage::collate(comm, my_rank, nb_ranks, local_index, global_index);
-      Portage::collate(comm, my_rank, nb_ranks, local_field, global_field);
-
-      if (my_rank == 0) {
-        // sort field values by global ID
-        Portage::argsort(global_index, index_helper);
-        Portage::reorder(global_index, index_helper);
-        Portage::reorder(global_field, index_helper);
-
-        // dump sorted data eventually
-        std::ofstream file("remap_"+ field.first +".dat");
-        file << std::scientific;
-        file.precision(17);
-
-        for (long c = 0; c < nb_target_cells; ++c)
-          file << global_index[c] << "\t" << global_field[c] << std::endl;
-
-        index_helper.clear();
-        global_index.clear();
-        global_field.clear();
-      }
-
-      MPI_Barrier(comm);
+      // sort field values by global ID across ranks and dump them
+      // in parallel, each rank writing its own sorted slice.
+      Portage::distributed_sort(comm, nb_ranks, local_index, local_field);
+      Portage::write_ordered(comm, "remap_"+ field.first +".dat", local_index, local_field);
     }
 
     if (my_rank == 0)
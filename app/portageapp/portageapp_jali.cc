@@ -45,6 +45,7 @@
 // For parsing and evaluating user defined expressions in apps
 
 #include "user_field.h"
+#include "field_io.h"
 
 using Wonton::Jali_Mesh_Wrapper;
 using Portage::argsort;
@@ -128,7 +129,8 @@ int print_usage() {
 
   std::cout << "--results_file=results_filename (default = output.txt)\n";
   std::cout << "  If a filename is specified, the target field values are " <<
-      "output to the file given by 'results_filename' in ascii format\n\n";
+      "output to the file given by 'results_filename' in ascii format, " <<
+      "or in binary format if it ends with '.bin'\n\n";
   return 0;
 }
 //////////////////////////////////////////////////////////////////////
@@ -556,8 +558,10 @@ template<int dim> void run(std::shared_ptr<Jali::Mesh> sourceMesh,
     sourceData.resize(nsrccells);
 
     if (!remap_back) {
+      std::vector<JaliGeometry::Point> centroids(nsrccells);
       for (int c = 0; c < nsrccells; ++c)
-        sourceData[c] = source_field(sourceMesh->cell_centroid(c));
+        centroids[c] = sourceMesh->cell_centroid(c);
+      source_field.evaluate(centroids, sourceData.data());
     }
 
     sourceState->add("celldata", sourceMesh, Jali::Entity_kind::CELL,
@@ -579,11 +583,10 @@ template<int dim> void run(std::shared_ptr<Jali::Mesh> sourceMesh,
       cell_centroid?
     */
 
-    Portage::Point<dim> node;
-    for (int i = 0; i < nsrcnodes; ++i) {
-      sourceMeshWrapper.node_get_coordinates(i, &node);
-      sourceData[i] = source_field(node);
-    }
+    std::vector<Portage::Point<dim>> nodes(nsrcnodes);
+    for (int i = 0; i < nsrcnodes; ++i)
+      sourceMeshWrapper.node_get_coordinates(i, &(nodes[i]));
+    source_field.evaluate(nodes, sourceData.data());
 
     sourceState->add("nodedata", sourceMesh, Jali::Entity_kind::NODE,
                     Jali::Entity_type::ALL, &(sourceData[0]));
@@ -713,11 +716,17 @@ template<int dim> void run(std::shared_ptr<Jali::Mesh> sourceMesh,
       source_mass += cellvecin[c] * cellvol2;
     }
 
-    // Cell error computation
-    Portage::Point<dim> ccen;
+    // Cell error computation, with exact values evaluated in a batch
+    std::vector<Portage::Point<dim>> centroids(ntarcells);
+    for (int c = 0; c < ntarcells; ++c)
+      targetMeshWrapper.cell_centroid(c, &centroids[c]);
+
+    std::vector<double> exact(ntarcells);
+    source_field.evaluate(centroids, exact.data());
+
     for (int c = 0; c < ntarcells; ++c) {
-      targetMeshWrapper.cell_centroid(c, &ccen);
-      error = source_field(ccen) - cellvecout[c];
+      Portage::Point<dim> const& ccen = centroids[c];
+      error = exact[c] - cellvecout[c];
       targetData[c] = cellvecout[c];
       minout = fmin( minout, cellvecout[c] );
       maxout = fmax( maxout, cellvecout[c] );
@@ -757,10 +766,16 @@ template<int dim> void run(std::shared_ptr<Jali::Mesh> sourceMesh,
       source_mass += nodevecin[c] * nodevol2;
     }
 
-    Portage::Point<dim> nodexy;
+    std::vector<Portage::Point<dim>> nodes(ntarnodes);
+    for (int i = 0; i < ntarnodes; ++i)
+      targetMeshWrapper.node_get_coordinates(i, &nodes[i]);
+
+    std::vector<double> exact(ntarnodes);
+    source_field.evaluate(nodes, exact.data());
+
     for (int i = 0; i < ntarnodes; ++i) {
-      targetMeshWrapper.node_get_coordinates(i, &nodexy);
-      error = source_field(nodexy) - nodevecout[i];
+      Portage::Point<dim> const& nodexy = nodes[i];
+      error = exact[i] - nodevecout[i];
       double dualcellvol = targetMeshWrapper.dual_cell_volume(i);
       minout = fmin( minout, nodevecout[i] );
       maxout = fmax( maxout, nodevecout[i] );
@@ -855,19 +870,26 @@ template<int dim> void run(std::shared_ptr<Jali::Mesh> sourceMesh,
     reorder(lgid, idx);   // sort the global ids
     reorder(lvalues, idx);  // sort the values
 
+    bool const binary = field_io::is_binary_filename(field_filename);
     if (numpe > 1) {
       int const maxwidth = std::ceil(std::log10(numpe));
       char rankstr[10];
       std::snprintf(rankstr, sizeof(rankstr), "%0*d", maxwidth, rank);
       field_filename = field_filename + "." + std::string(rankstr);
     }
-    std::ofstream fout(field_filename);
-    fout << std::scientific;
-    fout.precision(17);
-
-    // write out the values
-    int const num_lgid = lgid.size();
-    for (int i=0; i < num_lgid; i++)
-      fout << lgid[i] << " " << lvalues[i] << std::endl;
+
+    // each rank writes its own binary file
+    if (binary) {
+      field_io::write(field_filename, lgid, {}, lvalues);
+    } else {
+      std::ofstream fout(field_filename);
+      fout << std::scientific;
+      fout.precision(17);
+
+      // write out the values
+      int const num_lgid = lgid.size();
+      for (int i=0; i < num_lgid; i++)
+        fout << lgid[i] << " " << lvalues[i] << std::endl;
+    }
   }
 }
@@ -78,7 +78,8 @@ int print_usage() {
       "--remap_order=1|2 \n" <<
       "--limiter=barth_jespersen --bnd_limiter=zero_gradient"
       "--mesh_min=0. --mesh_max=1. \n" <<
-      "--output_meshes=y|n --results_file=filename --convergence_study=NREF --only_threads=y|n\n\n";
+      "--output_meshes=y|n --results_file=filename --convergence_study=NREF --only_threads=y|n\n" <<
+      "--gmv_format=ascii|binary\n\n";
 
   std::cout << "--dim (default = 2): spatial dimension of mesh\n\n";
 
@@ -145,6 +146,11 @@ int print_usage() {
   std::cout << "  If a filename is specified, the target field values are " <<
       "output to the file given by 'results_filename' in ascii format\n\n";
 
+  std::cout << "--gmv_format (default = ascii)\n";
+  std::cout << "  Format of the material polygons written to source_mm.gmv and " <<
+      "the results file. If 'binary', all ranks write to a single file " <<
+      "in parallel (names are then limited to 8 characters)\n\n";
+
 #if ENABLE_TIMINGS
   std::cout << "--only_threads (default = n)\n";
   std::cout << " enable if you want to profile only threads scaling\n\n";
@@ -246,7 +252,7 @@ void run(std::shared_ptr<Jali::Mesh> sourceMesh,
          int interp_order,
          std::string material_filename,
          std::vector<std::string> material_field_expressions,
-         std::string field_filename, bool mesh_output,
+         std::string field_filename, bool mesh_output, bool gmv_binary,
          int rank, int numpe, Jali::Entity_kind entityKind,
          double *L1_error, double *L2_error,
          std::shared_ptr<Profiler> profiler = nullptr);
@@ -293,6 +299,7 @@ int main(int argc, char** argv) {
   int interp_order = 1;
   bool all_convex = true;
   bool mesh_output = false;
+  bool gmv_binary = false;
   int n_converge = 1;
   Jali::Entity_kind entityKind = Jali::Entity_kind::CELL;
   Portage::Limiter_type limiter = Portage::Limiter_type::NOLIMITER;
@@ -364,6 +371,8 @@ int main(int argc, char** argv) {
       srchi = stod(valueword);
     } else if (keyword == "output_meshes") {
       mesh_output = (valueword == "y");
+    } else if (keyword == "gmv_format") {
+      gmv_binary = (valueword == "binary");
     } else if (keyword == "all_convex") {
       all_convex = (valueword == "y");
     } else if (keyword == "results_file") {
@@ -523,24 +532,24 @@ int main(int argc, char** argv) {
         if (all_convex)
           run<2, true>(source_mesh, target_mesh, limiter, bnd_limiter, interp_order,
                material_filename, material_field_expressions,
-               field_filename, mesh_output,
+               field_filename, mesh_output, gmv_binary,
                rank, numpe, entityKind, &(l1_err[i]), &(l2_err[i]), profiler);
         else
           run<2, false>(source_mesh, target_mesh, limiter, bnd_limiter, interp_order,
                material_filename, material_field_expressions,
-               field_filename, mesh_output,
+               field_filename, mesh_output, gmv_binary,
                rank, numpe, entityKind, &(l1_err[i]), &(l2_err[i]), profiler);
         break;
       case 3:
         if (all_convex)
           run<3, true>(source_mesh, target_mesh, limiter, bnd_limiter, interp_order,
                material_filename, material_field_expressions,
-               field_filename, mesh_output,
+               field_filename, mesh_output, gmv_binary,
                rank, numpe, entityKind, &(l1_err[i]), &(l2_err[i]), profiler);
         else
           run<3, false>(source_mesh, target_mesh, limiter, bnd_limiter, interp_order,
                material_filename, material_field_expressions,
-               field_filename, mesh_output,
+               field_filename, mesh_output, gmv_binary,
                rank, numpe, entityKind, &(l1_err[i]), &(l2_err[i]), profiler);
         break;
       default:
@@ -598,6 +607,7 @@ template<int dim, bool all_convex> void run(std::shared_ptr<Jali::Mesh> sourceMe
                            std::string material_filename,
                            std::vector<std::string> material_field_expressions,
                            std::string field_filename, bool mesh_output,
+                           bool gmv_binary,
                            int rank, int numpe, Jali::Entity_kind entityKind,
                            double *L1_error, double *L2_error,
                            std::shared_ptr<Profiler> profiler) {
@@ -770,32 +780,48 @@ template<int dim, bool all_convex> void run(std::shared_ptr<Jali::Mesh> sourceMe
       if (!mat_fields[m].initialize(dim, material_field_expressions[m]))
         MPI_Abort(MPI_COMM_WORLD, -1);
 
+      // gather the centroids of pure cells and of the material
+      // polygons of mixed cells, and evaluate the field in a batch
       int nmatcells = matcells[m].size();
-      std::vector<double> matData(nmatcells);
+      std::vector<int> first(nmatcells + 1, 0);
+      std::vector<Wonton::Point<dim>> points;
+      std::vector<double> volumes;
       for (int ic = 0; ic < nmatcells; ic++) {
         int c = matcells[m][ic];
         if (cell_num_mats[c] == 1) {
           if (cell_mat_ids[offsets[c]] == m) {
             Wonton::Point<dim> ccen;
             sourceMeshWrapper.cell_centroid(c, &ccen);
-            matData[ic] = mat_fields[m](ccen);
+            points.push_back(ccen);
+            volumes.push_back(1.0);
           }
         } else {
           Tangram::CellMatPoly<dim> const& cellmatpoly =
               source_interface_reconstructor->cell_matpoly_data(c);
           int nmp = cellmatpoly.num_matpolys();
-          matData[ic] = 0.0;
-          double matvolume = 0.0;
           for (int i = 0; i < nmp; i++) {
             if (cellmatpoly.matpoly_matid(i) == m) {
-              double matpolyvolume = cellmatpoly.matpoly_volume(i);
-              matvolume += matpolyvolume;
-              Wonton::Point<dim> mcen = cellmatpoly.matpoly_centroid(i);
-              matData[ic] += mat_fields[m](mcen) * matpolyvolume;
+              points.push_back(cellmatpoly.matpoly_centroid(i));
+              volumes.push_back(cellmatpoly.matpoly_volume(i));
             }
           }
-          matData[ic] /= matvolume;
         }
+        first[ic + 1] = points.size();
+      }
+
+      std::vector<double> values(points.size());
+      mat_fields[m].evaluate(points, values.data());
+
+      std::vector<double> matData(nmatcells);
+      for (int ic = 0; ic < nmatcells; ic++) {
+        if (first[ic] == first[ic + 1])
+          continue;
+        double matvolume = 0.0;
+        for (int k = first[ic]; k < first[ic + 1]; k++) {
+          matData[ic] += values[k] * volumes[k];
+          matvolume += volumes[k];
+        }
+        matData[ic] /= matvolume;
       }
 
       sourceStateWrapper.mat_add_celldata("cellmatdata", m, &(matData[0]));
@@ -803,11 +829,19 @@ template<int dim, bool all_convex> void run(std::shared_ptr<Jali::Mesh> sourceMe
   }
 
 
+  Wonton::MPIExecutor_type mpiexecutor(MPI_COMM_WORLD);
+  Wonton::Executor_type *executor = (numpe > 1) ? &mpiexecutor : nullptr;
+
   std::vector<std::string> fieldnames;
   fieldnames.emplace_back("cellmatdata");
-  Portage::write_to_gmv<dim>(sourceMeshWrapper, sourceStateWrapper,
-                             source_interface_reconstructor, fieldnames,
-                             "source_mm.gmv");
+  if (gmv_binary)
+    Portage::write_to_gmv_binary<dim>(sourceMeshWrapper, sourceStateWrapper,
+                                      source_interface_reconstructor, fieldnames,
+                                      "source_mm.gmv", executor);
+  else
+    Portage::write_to_gmv<dim>(sourceMeshWrapper, sourceStateWrapper,
+                               source_interface_reconstructor, fieldnames,
+                               "source_mm.gmv");
 
 
   // Add the materials into the target mesh but with empty cell lists
@@ -836,9 +870,6 @@ template<int dim, bool all_convex> void run(std::shared_ptr<Jali::Mesh> sourceMe
   profiler->time.interface = timer::elapsed(tic);
 #endif
 
-  Wonton::MPIExecutor_type mpiexecutor(MPI_COMM_WORLD);
-  Wonton::Executor_type *executor = (numpe > 1) ? &mpiexecutor : nullptr;
-
   if (dim == 2) {
     if (all_convex) {
       if (interp_order == 1) {
@@ -1020,9 +1051,14 @@ template<int dim, bool all_convex> void run(std::shared_ptr<Jali::Mesh> sourceMe
                                                 Tcell_mat_centroids);
   target_interface_reconstructor->reconstruct();
 
-  Portage::write_to_gmv<dim>(targetMeshWrapper, targetStateWrapper,
-                             target_interface_reconstructor, fieldnames,
-                             field_filename);
+  if (gmv_binary)
+    Portage::write_to_gmv_binary<dim>(targetMeshWrapper, targetStateWrapper,
+                                      target_interface_reconstructor, fieldnames,
+                                      field_filename, executor);
+  else
+    Portage::write_to_gmv<dim>(targetMeshWrapper, targetStateWrapper,
+                               target_interface_reconstructor, fieldnames,
+                               field_filename);
 
 
   // Compute error
@@ -1037,22 +1073,22 @@ template<int dim, bool all_convex> void run(std::shared_ptr<Jali::Mesh> sourceMe
       std::vector<int> current_matcells;
       targetStateWrapper.mat_get_cells(m, &current_matcells);
 
-      // Cell error computation
+      // Cell error computation: gather the centroid of each pure cell
+      // and of the first material polygon of each mixed cell, and
+      // evaluate exact values in a batch
       int nmatcells = current_matcells.size();
+      std::vector<int> point_cells;
+      std::vector<Wonton::Point<dim>> points;
+      std::vector<double> volumes;
       for (int ic = 0; ic < nmatcells; ++ic) {
         int c = current_matcells[ic];
         if (target_cell_num_mats[c] == 1) {
           if (target_cell_mat_ids[offsets[c]] == m) {
             Wonton::Point<dim> ccen;
             targetMeshWrapper.cell_centroid(c, &ccen);
-            error = mat_fields[m](ccen) - cellmatvals[ic];
-            if (fabs(error) > 1.0e-08)
-              std::cout << "Pure cell " << c << " Material " << m << " Error " << error << "\n";
-
-            double cellvol = targetMeshWrapper.cell_volume(c);
-            totvolume += cellvol;
-            *L1_error += fabs(error)*cellvol;
-            *L2_error += error*error*cellvol;
+            point_cells.push_back(ic);
+            points.push_back(ccen);
+            volumes.push_back(targetMeshWrapper.cell_volume(c));
           }
         } else {
           Tangram::CellMatPoly<dim> const& cellmatpoly =
@@ -1060,18 +1096,30 @@ template<int dim, bool all_convex> void run(std::shared_ptr<Jali::Mesh> sourceMe
           int nmp = cellmatpoly.num_matpolys();
           for (int i = 0; i < nmp; i++) {
             if (cellmatpoly.matpoly_matid(i) == m) {
-              Wonton::Point<dim> mcen = cellmatpoly.matpoly_centroid(i);
-              error = mat_fields[m](mcen) - cellmatvals[ic];
-
-              double matpolyvol = cellmatpoly.matpoly_volume(i);
-              totvolume += matpolyvol;
-              *L1_error += fabs(error)*matpolyvol;
-              *L2_error += error*error*matpolyvol;
+              point_cells.push_back(ic);
+              points.push_back(cellmatpoly.matpoly_centroid(i));
+              volumes.push_back(cellmatpoly.matpoly_volume(i));
               break;
             }
           }
         }
       }
+
+      std::vector<double> exact(points.size());
+      mat_fields[m].evaluate(points, exact.data());
+
+      int npoints = points.size();
+      for (int k = 0; k < npoints; ++k) {
+        int ic = point_cells[k];
+        int c = current_matcells[ic];
+        error = exact[k] - cellmatvals[ic];
+        if (target_cell_num_mats[c] == 1 && fabs(error) > 1.0e-08)
+          std::cout << "Pure cell " << c << " Material " << m << " Error " << error << "\n";
+
+        totvolume += volumes[k];
+        *L1_error += fabs(error)*volumes[k];
+        *L2_error += error*error*volumes[k];
+      }
     }
   }
 
@@ -66,6 +66,7 @@
 
 // For parsing and evaluating user defined expressions in apps
 #include "user_field.h"
+#include "field_io.h"
 
 using Wonton::Jali_Mesh_Wrapper;
 
@@ -189,7 +190,8 @@ int print_usage() {
 #endif
 
   std::cout << "--field_filename\n\n";
-  std::cout << "  If defined, the field output filename. Rank is appended if parallel\n\n";
+  std::cout << "  If defined, the field output filename. Rank is appended if parallel\n";
+  std::cout << "  Values are written in binary format if it ends with '.bin'\n\n";
 
   return 0;
 }
@@ -847,14 +849,34 @@ int main(int argc, char** argv) {
 void write_field(std::string filename, 
     const Wonton::Jali_Mesh_Wrapper& meshWrapper, 
     const Wonton::Jali_State_Wrapper& stateWrapper,
-    std::string field_name="cellmatdata"){
-  
-  // open the stream
-  std::ofstream f(filename);
+    std::string field_name="cellmatdata", bool binary=false){
   
   // get the number of materials in the problem frm the state manager
   int nmats=stateWrapper.num_materials();
   
+  // gather columns and write them at once in binary format
+  if (binary) {
+    std::vector<int> gids, matids;
+    std::vector<double> values;
+    for (int m = 0; m < nmats; ++m) {
+      std::vector<int> matcells;
+      stateWrapper.mat_get_cells(m, &matcells);
+      double const *data;
+      stateWrapper.mat_get_celldata(field_name, m, &data);
+      int const num_matcells = matcells.size();
+      for (int ic = 0; ic < num_matcells; ic++) {
+        gids.push_back(meshWrapper.get_global_id(matcells[ic], Wonton::Entity_kind::CELL));
+        matids.push_back(m);
+        values.push_back(data[ic]);
+      }
+    }
+    field_io::write(filename, gids, matids, values);
+    return;
+  }
+
+  // open the stream
+  std::ofstream f(filename);
+  
   // loop over materials since we are material dominant
   for (int m = 0; m < nmats;  ++m) {
   
@@ -1121,27 +1143,40 @@ template<int dim> void run(std::shared_ptr<Jali::Mesh> sourceMesh,
       if (!mat_fields[m].initialize(dim, material_field_expressions[m]))
         MPI_Abort(MPI_COMM_WORLD, -1);
 
+      // gather the centroid of each pure cell and of the last material
+      // polygon of each mixed cell, and evaluate the field in a batch
       int nmatcells = matcells[m].size();
-      std::vector<double> matData(nmatcells);
+      std::vector<int> point_cells;
+      std::vector<Wonton::Point<dim>> points;
       for (int ic = 0; ic < nmatcells; ic++) {
         int c = matcells[m][ic];
         if (cell_num_mats[c] == 1) {
           Wonton::Point<dim> ccen;
           sourceMeshWrapper.cell_centroid(c, &ccen);
-          matData[ic] = mat_fields[m](ccen);
+          point_cells.push_back(ic);
+          points.push_back(ccen);
         } else {
           Tangram::CellMatPoly<dim> const& cellmatpoly =
             source_interface_reconstructor->cell_matpoly_data(c);
           int nmp = cellmatpoly.num_matpolys();
-          for (int i = 0; i < nmp; i++) {
+          for (int i = nmp - 1; i >= 0; i--) {
             if (cellmatpoly.matpoly_matid(i) == m) {
-              Wonton::Point<dim> mcen = cellmatpoly.matpoly_centroid(i);
-              matData[ic] = mat_fields[m](mcen);
+              point_cells.push_back(ic);
+              points.push_back(cellmatpoly.matpoly_centroid(i));
+              break;
             }
           }
         }
       }
 
+      std::vector<double> values(points.size());
+      mat_fields[m].evaluate(points, values.data());
+
+      std::vector<double> matData(nmatcells);
+      int npoints = points.size();
+      for (int k = 0; k < npoints; k++)
+        matData[point_cells[k]] = values[k];
+
       sourceStateWrapper.mat_add_celldata("cellmatdata", m, &(matData[0]));
     }
   }
@@ -1476,8 +1511,13 @@ template<int dim> void run(std::shared_ptr<Jali::Mesh> sourceMesh,
       std::vector<int> current_matcells;
       targetStateWrapper.mat_get_cells(mat_id, &current_matcells);
 
-      // Cell error computation
+      // Cell error computation: gather the centroids of pure cells and
+      // of the material polygons of mixed cells, and evaluate exact
+      // values in a batch
       int nmatcells = current_matcells.size();
+      std::vector<int> point_cells;
+      std::vector<Wonton::Point<dim>> points;
+      std::vector<double> volumes;
       for (int ic = 0; ic < nmatcells; ++ic) {
         int state_cell_id = current_matcells[ic];
         int mesh_cell_id = owned2all[state_cell_id];
@@ -1485,12 +1525,9 @@ template<int dim> void run(std::shared_ptr<Jali::Mesh> sourceMesh,
           if (target_cell_mat_ids[offsets[mesh_cell_id]] == mat_id) {
             Wonton::Point<dim> ccen;
             targetMeshWrapper.cell_centroid(mesh_cell_id, &ccen);
-            error = mat_fields[mat_id](ccen) - cellmatvals[ic];
-
-            double cellvol = targetMeshWrapper.cell_volume(mesh_cell_id);
-            totvolume += cellvol;
-            L1_error += fabs(error)*cellvol;
-            L2_error += error*error*cellvol;
+            point_cells.push_back(ic);
+            points.push_back(ccen);
+            volumes.push_back(targetMeshWrapper.cell_volume(mesh_cell_id));
           }
         } else {
           Tangram::CellMatPoly<dim> const& cellmatpoly =
@@ -1498,17 +1535,25 @@ template<int dim> void run(std::shared_ptr<Jali::Mesh> sourceMesh,
           int nmp = cellmatpoly.num_matpolys();
           for (int i = 0; i < nmp; i++) {
             if (cellmatpoly.matpoly_matid(i) == mat_id) {
-              Wonton::Point<dim> mcen = cellmatpoly.matpoly_centroid(i);
-              error = mat_fields[mat_id](mcen) - cellmatvals[ic];
-
-              double matpolyvol = cellmatpoly.matpoly_volume(i);
-              totvolume += matpolyvol;
-              L1_error += fabs(error)*matpolyvol;
-              L2_error += error*error*matpolyvol;
+              point_cells.push_back(ic);
+              points.push_back(cellmatpoly.matpoly_centroid(i));
+              volumes.push_back(cellmatpoly.matpoly_volume(i));
             }
           }
         }
       }
+
+      std::vector<double> exact(points.size());
+      mat_fields[mat_id].evaluate(points, exact.data());
+
+      int npoints = points.size();
+      for (int k = 0; k < npoints; ++k) {
+        error = exact[k] - cellmatvals[point_cells[k]];
+
+        totvolume += volumes[k];
+        L1_error += fabs(error)*volumes[k];
+        L2_error += error*error*volumes[k];
+      }
     }
   }
 
@@ -1539,7 +1584,8 @@ template<int dim> void run(std::shared_ptr<Jali::Mesh> sourceMesh,
     std::cout << "*************writing to: " << field_filename_ <<"\n";
     
     // write the date file
-    write_field(field_filename_, targetMeshWrapper, targetStateWrapper);
+    write_field(field_filename_, targetMeshWrapper, targetStateWrapper,
+                "cellmatdata", field_io::is_binary_filename(field_filename));
   } 
 
 #ifdef ENABLE_DEBUG
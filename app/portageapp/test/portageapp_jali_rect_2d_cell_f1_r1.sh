@@ -42,6 +42,22 @@ $CMPAPPDIR/apptest_cmp GOLD_jali_rect_2d_cell_f1_r1.txt.2 jali_rect_2d_cell_f1_r
 $CMPAPPDIR/apptest_cmp GOLD_jali_rect_2d_cell_f1_r1.txt.3 jali_rect_2d_cell_f1_r1.txt.3 1e-12
 
 
+# PARALLEL RUN, same meshes as above, binary field files
+
+mpirun -np 4 $TESTAPPDIR/portageapp_jali \
+--dim=2 --nsourcecells=5 --ntargetcells=7 \
+--conformal=n \
+--entity_kind=cell --field="x+y" \
+--remap_order=1 \
+--results_file="jali_rect_2d_cell_f1_r1.bin"
+
+# Compare the values for the field with the text gold files
+$CMPAPPDIR/apptest_cmp GOLD_jali_rect_2d_cell_f1_r1.txt.0 jali_rect_2d_cell_f1_r1.bin.0 1e-12
+$CMPAPPDIR/apptest_cmp GOLD_jali_rect_2d_cell_f1_r1.txt.1 jali_rect_2d_cell_f1_r1.bin.1 1e-12
+$CMPAPPDIR/apptest_cmp GOLD_jali_rect_2d_cell_f1_r1.txt.2 jali_rect_2d_cell_f1_r1.bin.2 1e-12
+$CMPAPPDIR/apptest_cmp GOLD_jali_rect_2d_cell_f1_r1.txt.3 jali_rect_2d_cell_f1_r1.bin.3 1e-12
+
+
 # PARALLEL RUN, non-conforming meshes
 
 mpirun -np 4 $TESTAPPDIR/portageapp_jali \
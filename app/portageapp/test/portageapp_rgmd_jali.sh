@@ -15,7 +15,9 @@ set -x
 # In particular $6 is a field expression and can contain non alphanumeric
 # characters that can be a problem for filenames, but at the moment it works
 # and avoids file clobbers in a human readable way as opposed to hashes.
-FILENAME=field_$1_$2_$3_$4_$5_$6_$7.txt
+# An optional 8th argument gives the extension of the field files, 'bin'
+# for binary field files.
+FILENAME=field_$1_$2_$3_$4_$5_$6_$7.${8:-txt}
 
 TOLERANCE_2D=5.e-11
 TOLERANCE_3D=5.e-9
@@ -21,6 +21,7 @@ Please see the license file at the root of this repository, or at:
 // portage includes
 #include "portage/support/portage.h"
 #include "portage/driver/mmdriver.h"
+#include "portage/support/dual_geometry_cache.h"
 
 // wonton includes
 #include "wonton/mesh/simple/simple_mesh.h"
@@ -36,6 +37,9 @@ using Wonton::Simple_State_Wrapper;
 using Wonton::Point;
 using Wonton::Entity_kind;
 
+// node remaps query dual cells from a cache rather than assembling them
+using Dual_Mesh_Wrapper = Portage::DualGeometryCache<3, Simple_Mesh_Wrapper>;
+
 
 
 //////////////////////////////////////////////////////////////////////
@@ -303,8 +307,8 @@ int main(int argc, char** argv) {
                                                  n_target, n_target, n_target);
     }
 
-    Simple_Mesh_Wrapper inputMeshWrapper(*inputMesh);
-    Simple_Mesh_Wrapper targetMeshWrapper(*targetMesh);
+    Dual_Mesh_Wrapper inputMeshWrapper(*inputMesh);
+    Dual_Mesh_Wrapper targetMeshWrapper(*targetMesh);
 
     const int ninpnodes = inputMeshWrapper.num_owned_nodes();
     const int ntarnodes = targetMeshWrapper.num_owned_nodes();
@@ -353,7 +357,7 @@ int main(int argc, char** argv) {
         Portage::IntersectR3D,
         Portage::Interpolate_1stOrder,
         3,
-        Simple_Mesh_Wrapper,
+        Dual_Mesh_Wrapper,
         Simple_State_Wrapper<Simple_Mesh_Wrapper>>
           d(inputMeshWrapper, inputStateWrapper,
             targetMeshWrapper, targetStateWrapper);
@@ -365,7 +369,7 @@ int main(int argc, char** argv) {
         Portage::IntersectR3D,
         Portage::Interpolate_2ndOrder,
         3,
-        Simple_Mesh_Wrapper,
+        Dual_Mesh_Wrapper,
         Simple_State_Wrapper<Simple_Mesh_Wrapper>>
           d(inputMeshWrapper, inputStateWrapper,
             targetMeshWrapper, targetStateWrapper);
@@ -281,15 +281,15 @@ void run(
         throw std::runtime_error("Could not initialize user field: "
                 +material_field_expressions[m]);
 
-      // field values for this material
-      std::vector<double> matData;
-
-      // loop of cell indices for this material
-      for (int c: matcells[m]) {
-        Point<2> point;
-        source_mesh_wrapper.cell_centroid(c, &point);
-        matData.push_back(mat_fields[m](point));
-      }
+      // field values for this material at the centroid of its cells
+      int const nb_mat_cells = matcells[m].size();
+      std::vector<double> matData(nb_mat_cells);
+      std::vector<Point<2>> points(nb_mat_cells);
+
+      for (int i = 0; i < nb_mat_cells; i++)
+        source_mesh_wrapper.cell_centroid(matcells[m][i], &(points[i]));
+
+      mat_fields[m].evaluate(points, matData.data());
 
       // add the data to the user_field
       user_field[m]=matData;
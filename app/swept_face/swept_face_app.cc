@@ -535,12 +535,12 @@ void remap(std::shared_ptr<Jali::Mesh> source_mesh,
     throw std::runtime_error("expression parsing failure");
 
   double source_field[nb_source_cells];
+  std::vector<Wonton::Point<dim>> source_centroids(nb_source_cells);
 
-  for (int c = 0; c < nb_source_cells; ++c) {
-    Wonton::Point<dim> centroid;
-    source_mesh_wrapper.cell_centroid(c, &centroid);
-    source_field[c] = exact_value(centroid);
-  }
+  for (int c = 0; c < nb_source_cells; ++c)
+    source_mesh_wrapper.cell_centroid(c, &(source_centroids[c]));
+
+  exact_value.evaluate(source_centroids, source_field);
 
   source_state_wrapper.mesh_add_data(Portage::CELL, "density", source_field);
   target_state_wrapper.mesh_add_data(Portage::CELL, "density", 0.0);
@@ -385,6 +385,15 @@ else(ENABLE_THRUST)
   endif(Boost_FOUND)
 endif(ENABLE_THRUST)
 
+#-----------------------------------------------------------------------------
+# Huge pages for large arrays
+#-----------------------------------------------------------------------------
+set(ENABLE_HUGE_PAGES FALSE CACHE BOOL "Advise huge pages for large arrays")
+if(ENABLE_HUGE_PAGES)
+  message(STATUS "Enabling huge pages for large arrays")
+  set(PORTAGE_ENABLE_HUGE_PAGES True CACHE BOOL "Does Portage advise huge pages?")
+endif(ENABLE_HUGE_PAGES)
+
 
 
 
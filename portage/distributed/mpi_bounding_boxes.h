@@ -11,7 +11,9 @@ Please see the license file at the root of this repository, or at:
 #ifdef PORTAGE_ENABLE_MPI
 
 #include <cassert>
+#include <cstdint>
 #include <algorithm>
+#include <limits>
 #include <numeric>
 #include <memory>
 #include <unordered_map>
@@ -20,6 +22,7 @@ Please see the license file at the root of this repository, or at:
 #include <set>
 
 #include "portage/support/portage.h"
+#include "portage/support/hilbert.h"
 #include "wonton/support/Point.h"
 #include "wonton/state/state_vector_uni.h"
 #include "mpi.h"
@@ -144,6 +147,45 @@ class MPI_Bounding_Boxes {
 
 
 
+  /*!
+    @brief Renumber the distributed source entities along a Hilbert curve
+
+    By default, the flat mesh numbers the received entities in ascending
+    global id order, owned entities first. When enabled, distribute numbers
+    owned and ghost cells, nodes and faces along a Hilbert curve of the
+    whole source mesh instead, so that entities close in space are close
+    in memory for the kernels that follow. Connectivity and fields of the
+    flat mesh and state are renumbered consistently. It must be set alike
+    on all ranks since the curve is fitted to the global source bounds.
+
+    @param[in] enable  whether to renumber entities
+   */
+  void reorder_by_sfc(bool enable = true) { sfc_reorder_ = enable; }
+
+
+  /*!
+    @brief Renumbering of the flat mesh cells
+    @return for each flat cell, its index in global id order
+
+    This is the identity unless entities were renumbered along a curve.
+    It allows results on the flat mesh to be brought back to the default
+    numbering, e.g. to compare them with runs without renumbering.
+   */
+  std::vector<int> const& get_flat_cell_order() const { return flatCellOrder_; }
+
+  /*!
+    @brief Renumbering of the flat mesh nodes
+    @return for each flat node, its index in global id order
+   */
+  std::vector<int> const& get_flat_node_order() const { return flatNodeOrder_; }
+
+  /*!
+    @brief Renumbering of the flat mesh faces
+    @return for each flat face, its index in global id order (3D only)
+   */
+  std::vector<int> const& get_flat_face_order() const { return flatFaceOrder_; }
+
+
   /*!
     @brief Compute bounding boxes for all partitions, and send source mesh and state
            information to all target partitions with an overlapping bounding box using MPI
@@ -182,6 +224,21 @@ class MPI_Bounding_Boxes {
     int sourceNumNodes = sourceNumOwnedNodes + source_mesh_flat.num_ghost_nodes();
     setSendRecvCounts(&nodeInfo, commSize, sendFlags,sourceNumNodes, sourceNumOwnedNodes);
 
+    // SEND SPACE-FILLING CURVE KEYS (only if renumbering)
+    std::vector<std::uint64_t> sourceCellKeys, sourceNodeKeys, sourceFaceKeys;
+    std::vector<std::uint64_t> distributedCellKeys, distributedNodeKeys, distributedFaceKeys;
+    if (sfc_reorder_) {
+      compute_sfc_keys(source_mesh_flat, sourceCellKeys, sourceNodeKeys, sourceFaceKeys);
+
+      distributedCellKeys.resize(cellInfo.newNum);
+      sendField(cellInfo, commRank, commSize, MPI_UINT64_T, 1,
+                sourceCellKeys, &distributedCellKeys);
+
+      distributedNodeKeys.resize(nodeInfo.newNum);
+      sendField(nodeInfo, commRank, commSize, MPI_UINT64_T, 1,
+                sourceNodeKeys, &distributedNodeKeys);
+    }
+
     ///////////////////////////////////////////////////////
     // always distributed
     ///////////////////////////////////////////////////////
@@ -209,6 +266,13 @@ class MPI_Bounding_Boxes {
     compress_with_ghosts(distributedNodeGlobalIds, nodeInfo.newNumOwned,
       distributedNodeIds_, flatNodeGlobalIds_, flatNodeNumOwned_);
 
+    // renumber along the curve before anything is merged, so that all
+    // data and references follow the new numbering
+    sort_by_key(distributedCellKeys, flatCellNumOwned_,
+      distributedCellIds_, flatCellGlobalIds_, flatCellOrder_);
+    sort_by_key(distributedNodeKeys, flatNodeNumOwned_,
+      distributedNodeIds_, flatNodeGlobalIds_, flatNodeOrder_);
+
     // create the map from cell global id to flat cell index
     create_gid_to_flat_map(flatCellGlobalIds_, gidToFlatCellId_);
     create_gid_to_flat_map(flatNodeGlobalIds_, gidToFlatNodeId_);
@@ -289,6 +353,15 @@ class MPI_Bounding_Boxes {
       compress_with_ghosts(distributedFaceGlobalIds, faceInfo.newNumOwned,
         distributedFaceIds_, flatFaceGlobalIds_, flatFaceNumOwned_);
 
+      // renumber faces along the curve as well
+      if (sfc_reorder_) {
+        distributedFaceKeys.resize(faceInfo.newNum);
+        sendField(faceInfo, commRank, commSize, MPI_UINT64_T, 1,
+                  sourceFaceKeys, &distributedFaceKeys);
+      }
+      sort_by_key(distributedFaceKeys, flatFaceNumOwned_,
+        distributedFaceIds_, flatFaceGlobalIds_, flatFaceOrder_);
+
       // create the map from face global id to flat cell index
       create_gid_to_flat_map(flatFaceGlobalIds_, gidToFlatFaceId_);
 
@@ -619,6 +692,14 @@ class MPI_Bounding_Boxes {
 
   int dim_ = 1;
 
+  // whether to renumber distributed entities along a Hilbert curve
+  bool sfc_reorder_ = false;
+
+  // for each flat cell, node and face, its index in global id order
+  std::vector<int> flatCellOrder_ {};
+  std::vector<int> flatNodeOrder_ {};
+  std::vector<int> flatFaceOrder_ {};
+
   // the number of nodes "owned" by the flat mesh. "Owned" is in quotes because
   // a node may be "owned" by multiple partitions in the flat mesh. A node is
   // owned by the flat mesh if it was owned by any partition.
@@ -1174,6 +1255,152 @@ class MPI_Bounding_Boxes {
   }
 
 
+  /*!
+    @brief Compute the Hilbert keys of the local source entities
+
+    @param[in] source_mesh_flat  Input mesh (must be flat representation)
+    @param[out] cellKeys  The key of each cell
+    @param[out] nodeKeys  The key of each node
+    @param[out] faceKeys  The key of each face (3D only)
+
+    Keys are computed on the curve of the bounding box of the whole source
+    mesh so that keys sent by different partitions can be compared. Cells
+    and faces are located by the average of their node coordinates, or of
+    their face averages for 3D cells, which is enough to order them.
+   */
+  template <class Source_Mesh>
+  void compute_sfc_keys(Source_Mesh &source_mesh_flat,
+                        std::vector<std::uint64_t>& cellKeys,
+                        std::vector<std::uint64_t>& nodeKeys,
+                        std::vector<std::uint64_t>& faceKeys) {
+
+    std::vector<double>& coords = source_mesh_flat.get_coords();
+    int const numNodes = source_mesh_flat.num_owned_nodes()
+                       + source_mesh_flat.num_ghost_nodes();
+    int const numCells = source_mesh_flat.num_owned_cells()
+                       + source_mesh_flat.num_ghost_cells();
+
+    // bounding box of the whole source mesh
+    std::vector<double> lo(dim_, std::numeric_limits<double>::max());
+    std::vector<double> hi(dim_, std::numeric_limits<double>::lowest());
+    for (int n = 0; n < numNodes; ++n)
+      for (int d = 0; d < dim_; ++d) {
+        lo[d] = std::min(lo[d], coords[dim_*n + d]);
+        hi[d] = std::max(hi[d], coords[dim_*n + d]);
+      }
+
+    MPI_Allreduce(MPI_IN_PLACE, lo.data(), dim_, MPI_DOUBLE, MPI_MIN, comm_);
+    MPI_Allreduce(MPI_IN_PLACE, hi.data(), dim_, MPI_DOUBLE, MPI_MAX, comm_);
+
+    nodeKeys.resize(numNodes);
+    for (int n = 0; n < numNodes; ++n)
+      nodeKeys[n] = hilbert_key(&(coords[dim_*n]), dim_, lo.data(), hi.data());
+
+    // average of the points of each entity of a list
+    auto average = [&](std::vector<double> const& points,
+                       std::vector<int> const& offsets,
+                       std::vector<int> const& counts,
+                       std::vector<int> const& list, int i) {
+      std::vector<double> x(dim_, 0.);
+      for (int j = 0; j < counts[i]; ++j)
+        for (int d = 0; d < dim_; ++d)
+          x[d] += points[dim_*list[offsets[i] + j] + d] / counts[i];
+      return x;
+    };
+
+    std::vector<double> cellPoints(dim_*numCells);
+
+    if (dim_ == 2) {
+      std::vector<int>& cellNodeOffsets = source_mesh_flat.get_cell_node_offsets();
+      std::vector<int>& cellNodeCounts = source_mesh_flat.get_cell_node_counts();
+      std::vector<int>& cellToNodeList = source_mesh_flat.get_cell_to_node_list();
+
+      for (int c = 0; c < numCells; ++c) {
+        auto const x = average(coords, cellNodeOffsets, cellNodeCounts, cellToNodeList, c);
+        std::copy(x.begin(), x.end(), cellPoints.begin() + dim_*c);
+      }
+    }
+
+    if (dim_ == 3) {
+      int const numFaces = source_mesh_flat.num_owned_faces()
+                         + source_mesh_flat.num_ghost_faces();
+      std::vector<int>& faceNodeOffsets = source_mesh_flat.get_face_node_offsets();
+      std::vector<int>& faceNodeCounts = source_mesh_flat.get_face_node_counts();
+      std::vector<int>& faceToNodeList = source_mesh_flat.get_face_to_node_list();
+      std::vector<int>& cellFaceOffsets = source_mesh_flat.get_cell_face_offsets();
+      std::vector<int>& cellFaceCounts = source_mesh_flat.get_cell_face_counts();
+      std::vector<int>& cellToFaceList = source_mesh_flat.get_cell_to_face_list();
+
+      std::vector<double> facePoints(dim_*numFaces);
+      faceKeys.resize(numFaces);
+      for (int f = 0; f < numFaces; ++f) {
+        auto const x = average(coords, faceNodeOffsets, faceNodeCounts, faceToNodeList, f);
+        std::copy(x.begin(), x.end(), facePoints.begin() + dim_*f);
+        faceKeys[f] = hilbert_key(x.data(), dim_, lo.data(), hi.data());
+      }
+
+      for (int c = 0; c < numCells; ++c) {
+        auto const x = average(facePoints, cellFaceOffsets, cellFaceCounts, cellToFaceList, c);
+        std::copy(x.begin(), x.end(), cellPoints.begin() + dim_*c);
+      }
+    }
+
+    cellKeys.resize(numCells);
+    for (int c = 0; c < numCells; ++c)
+      cellKeys[c] = hilbert_key(&(cellPoints[dim_*c]), dim_, lo.data(), hi.data());
+  }
+
+
+  /*!
+    @brief Renumber compressed entities by their space-filling curve key
+
+    @param[in] distributedKeys  The key of each entity post distribution,
+      empty to keep the global id order
+    @param[in] flatNumOwned  The number of owned entities in the flat mesh
+    @param[in,out] distributedIds  The vector of indices of first occurrence
+      in the post distribution data, for each entity in the flat mesh
+    @param[in,out] flatGlobalIds  The global ids in the flat mesh
+    @param[out] order  For each entity in the flat mesh, its index in global
+      id order
+
+    This is called right after compress_with_ghosts, before any data is
+    merged. Owned and ghost entities are sorted separately so that owned
+    entities still come first. Keys shared by several entities are ordered
+    by global id, so that the numbering does not depend on the ranks the
+    entities came from.
+   */
+  void sort_by_key(std::vector<std::uint64_t> const& distributedKeys,
+                   int const flatNumOwned, std::vector<int>& distributedIds,
+                   std::vector<GID_t>& flatGlobalIds, std::vector<int>& order) const {
+
+    int const numFlat = distributedIds.size();
+    order.resize(numFlat);
+    std::iota(order.begin(), order.end(), 0);
+
+    if (distributedKeys.empty())
+      return;
+
+    auto by_key = [&](int i, int j) {
+      std::uint64_t const ki = distributedKeys[distributedIds[i]];
+      std::uint64_t const kj = distributedKeys[distributedIds[j]];
+      return ki < kj or (ki == kj and flatGlobalIds[i] < flatGlobalIds[j]);
+    };
+
+    std::sort(order.begin(), order.begin() + flatNumOwned, by_key);
+    std::sort(order.begin() + flatNumOwned, order.end(), by_key);
+
+    std::vector<int> sortedIds(numFlat);
+    std::vector<GID_t> sortedGlobalIds(numFlat);
+    for (int i = 0; i < numFlat; ++i) {
+      sortedIds[i] = distributedIds[order[i]];
+      sortedGlobalIds[i] = flatGlobalIds[order[i]];
+    }
+
+    distributedIds.swap(sortedIds);
+    flatGlobalIds.swap(sortedGlobalIds);
+  }
+
+
   /*!
     @brief Create a map from gid to flat mesh index
 
@@ -410,6 +410,110 @@ TEST(MPI_Bounding_Boxes, SimpleTest2D) {
 }
 
 
+TEST(MPI_Bounding_Boxes, ReorderBySFC3D) {
+
+  Jali::MeshFactory mf(MPI_COMM_WORLD);
+
+  std::shared_ptr<Jali::Mesh> source_mesh = mf(0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 4, 4, 4);
+  std::shared_ptr<Jali::Mesh> target_mesh = mf(0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 3, 3, 3);
+  Wonton::Jali_Mesh_Wrapper inputMeshWrapper(*source_mesh);
+  Wonton::Jali_Mesh_Wrapper target_mesh_(*target_mesh);
+  std::shared_ptr<Jali::State> target_state(Jali::State::create(target_mesh));
+  Wonton::Jali_State_Wrapper target_state_(*target_state);
+
+  // field values are a function of the gid to be consistent across ranks
+  int const num_source_cells = inputMeshWrapper.num_owned_cells()
+                             + inputMeshWrapper.num_ghost_cells();
+  std::vector<double> dtest(num_source_cells);
+  for (int c = 0; c < num_source_cells; ++c)
+    dtest[c] = double(inputMeshWrapper.get_global_id(c, Portage::Entity_kind::CELL)) + 10.;
+
+  std::shared_ptr<Jali::State> state(Jali::State::create(source_mesh));
+  state->add("d", source_mesh, Jali::Entity_kind::CELL,
+             Jali::Entity_type::ALL, dtest.data());
+  Wonton::Jali_State_Wrapper wrapper(*state);
+
+  using Flat_Mesh = Wonton::Flat_Mesh_Wrapper<>;
+  using Flat_State = Wonton::Flat_State_Wrapper<Flat_Mesh>;
+  Wonton::MPIExecutor_type executor(MPI_COMM_WORLD);
+
+  // distribute the same source in global id order and along the curve
+  Flat_Mesh default_mesh, sorted_mesh;
+  default_mesh.initialize(inputMeshWrapper);
+  sorted_mesh.initialize(inputMeshWrapper);
+  Flat_State default_state(default_mesh), sorted_state(sorted_mesh);
+  default_state.initialize(wrapper, {"d"});
+  sorted_state.initialize(wrapper, {"d"});
+
+  Portage::MPI_Bounding_Boxes default_distributor(&executor);
+  default_distributor.distribute(default_mesh, default_state, target_mesh_, target_state_);
+
+  Portage::MPI_Bounding_Boxes sorted_distributor(&executor);
+  sorted_distributor.reorder_by_sfc();
+  sorted_distributor.distribute(sorted_mesh, sorted_state, target_mesh_, target_state_);
+
+  int const num_owned_cells = sorted_mesh.num_owned_cells();
+  int const num_cells = num_owned_cells + sorted_mesh.num_ghost_cells();
+  ASSERT_EQ(default_mesh.num_owned_cells(), num_owned_cells);
+  ASSERT_EQ(default_mesh.num_ghost_cells(), sorted_mesh.num_ghost_cells());
+  ASSERT_EQ(default_mesh.num_owned_nodes(), sorted_mesh.num_owned_nodes());
+  ASSERT_EQ(default_mesh.num_owned_faces(), sorted_mesh.num_owned_faces());
+
+  // the default numbering is the identity
+  auto const& default_order = default_distributor.get_flat_cell_order();
+  for (int c = 0; c < num_cells; ++c)
+    ASSERT_EQ(c, default_order[c]);
+
+  // the renumbering keeps owned cells first
+  auto const& order = sorted_distributor.get_flat_cell_order();
+  ASSERT_EQ(unsigned(num_cells), order.size());
+  std::vector<int> seen(num_cells, 0);
+  for (int c = 0; c < num_cells; ++c) {
+    ASSERT_EQ(c < num_owned_cells, order[c] < num_owned_cells);
+    seen[order[c]]++;
+  }
+  for (int c = 0; c < num_cells; ++c)
+    ASSERT_EQ(1, seen[c]);
+
+  // each renumbered cell has the geometry, faces and values of the
+  // cell it was renumbered from
+  std::vector<Wonton::GID_t>& default_cell_gids = default_mesh.get_global_cell_ids();
+  std::vector<Wonton::GID_t>& sorted_cell_gids = sorted_mesh.get_global_cell_ids();
+  std::vector<Wonton::GID_t>& default_face_gids = default_mesh.get_global_face_ids();
+  std::vector<Wonton::GID_t>& sorted_face_gids = sorted_mesh.get_global_face_ids();
+
+  double* default_data = nullptr;
+  double* sorted_data = nullptr;
+  default_state.mesh_get_data(Portage::Entity_kind::CELL, "d", &default_data);
+  sorted_state.mesh_get_data(Portage::Entity_kind::CELL, "d", &sorted_data);
+
+  for (int c = 0; c < num_cells; ++c) {
+    int const ref = order[c];
+    ASSERT_EQ(default_cell_gids[ref], sorted_cell_gids[c]);
+
+    std::vector<Wonton::Point<3>> coords, ref_coords;
+    sorted_mesh.cell_get_coordinates(c, &coords);
+    default_mesh.cell_get_coordinates(ref, &ref_coords);
+    ASSERT_EQ(ref_coords.size(), coords.size());
+    for (unsigned n = 0; n < coords.size(); ++n)
+      for (int d = 0; d < 3; ++d)
+        ASSERT_EQ(ref_coords[n][d], coords[n][d]);
+
+    std::vector<int> faces, ref_faces, dirs, ref_dirs;
+    sorted_mesh.cell_get_faces_and_dirs(c, &faces, &dirs);
+    default_mesh.cell_get_faces_and_dirs(ref, &ref_faces, &ref_dirs);
+    ASSERT_EQ(ref_faces.size(), faces.size());
+    for (unsigned f = 0; f < faces.size(); ++f) {
+      ASSERT_EQ(default_face_gids[ref_faces[f]], sorted_face_gids[faces[f]]);
+      ASSERT_EQ(ref_dirs[f], dirs[f]);
+    }
+
+    if (c < num_owned_cells)
+      ASSERT_EQ(default_data[ref], sorted_data[c]);
+  }
+}
+
+
 TEST(MPI_Bounding_Boxes, NeedsRedistribution2D_1) {
 
  Jali::MeshFactory mf(MPI_COMM_WORLD);
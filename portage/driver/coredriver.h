@@ -9,6 +9,7 @@
 
 #include <ctime>
 #include <algorithm>
+#include <array>
 #include <vector>
 #include <iterator>
 #include <string>
@@ -17,6 +18,7 @@
 #include <type_traits>
 #include <memory>
 #include <limits>
+#include <cstdint>
 
 
 #ifdef HAVE_TANGRAM
@@ -25,11 +27,16 @@
 
 #include "portage/intersect/dummy_interface_reconstructor.h"
 #include "portage/interpolate/gradient.h"
+#include "portage/interpolate/limiter.h"
+#include "portage/interpolate/material_cell_index.h"
 #include "portage/support/portage.h"
+#include "portage/support/workspace.h"
 #include "wonton/support/Point.h"
 #include "wonton/support/CoordinateSystem.h"
 #include "portage/driver/parts.h"
 #include "portage/driver/fix_mismatch.h"
+#include "portage/driver/remap_cost.h"
+#include "portage/driver/reconstruction_cache.h"
 
 /*!
   @file coredriver.h
@@ -212,6 +219,28 @@ class CoreDriverBase {
                                                material_id, source_part);
   }
 
+  /**
+   * @brief Compute and limit together the gradient fields of several
+   *        cell-centered mesh variables on source mesh.
+   *
+   * @param field_names: the variable names.
+   * @param limiter_type: gradient limiter to use on internal regions.
+   * @param boundary_limiter_type: gradient limiter to use on boundary.
+   * @param coupled: whether all variables share the limiter factor of a cell.
+   */
+  std::vector<Portage::vector<Vector<D>>> compute_source_gradients(
+    std::vector<std::string> const& field_names,
+    Limiter_type limiter_type = NOLIMITER,
+    Boundary_Limiter_type boundary_limiter_type = BND_NOLIMITER,
+    bool coupled = false) {
+
+    assert(onwhat() == CELL);
+    auto derived_class_ptr = static_cast<CoreDriverType<CELL> *>(this);
+    return derived_class_ptr->compute_source_gradients(field_names, limiter_type,
+                                                       boundary_limiter_type,
+                                                       coupled);
+  }
+
   /*!
 
     Interpolate a mesh variable of type T residing on entity kind
@@ -419,6 +448,53 @@ class CoreDriverBase {
     derived_class_ptr->set_num_tols(num_tols);
   }
 
+  /*!
+    @brief Compute gradients only where the field is not smooth
+
+    @tparam Entity_kind  what kind of entity are we setting for
+
+    @param threshold     relative range of neighbor values below which
+                         gradients are skipped
+  */
+
+  template<Entity_kind ONWHAT>
+  void
+  set_adaptive_order_threshold(double threshold) {
+    assert(ONWHAT == onwhat());
+    auto derived_class_ptr = static_cast<CoreDriverType<ONWHAT> *>(this);
+    derived_class_ptr->set_adaptive_order_threshold(threshold);
+  }
+
+  /*!
+    @brief Record the intersection cost of each target entity
+
+    @tparam Entity_kind  what kind of entity are we recording for
+
+    @param enable        whether to record costs
+  */
+
+  template<Entity_kind ONWHAT>
+  void enable_cost_map(bool enable = true) {
+    assert(ONWHAT == onwhat());
+    auto derived_class_ptr = static_cast<CoreDriverType<ONWHAT> *>(this);
+    derived_class_ptr->enable_cost_map(enable);
+  }
+
+  /*!
+    @brief Write the recorded intersection costs to the target state
+
+    @tparam Entity_kind  what kind of entity are we writing for
+
+    @param prefix        prefix of the cost field names
+  */
+
+  template<Entity_kind ONWHAT>
+  void write_cost_map(std::string const& prefix = "remap_cost") {
+    assert(ONWHAT == onwhat());
+    auto derived_class_ptr = static_cast<CoreDriverType<ONWHAT> *>(this);
+    derived_class_ptr->write_cost_map(prefix);
+  }
+
 
 #ifdef HAVE_TANGRAM
   /*!
@@ -441,6 +517,65 @@ class CoreDriverBase {
     derived_class_ptr->set_interface_reconstructor_options(all_convex, tols);
   }
 
+  /*!
+    @brief restrict interface reconstruction to the source cells that
+    are needed by the intersection candidates
+    @param lazy Whether to skip mixed cells that are neither candidates
+    of an owned target cell nor neighbors of such a candidate.
+  */
+  void set_lazy_interface_reconstruction(bool lazy = true) {
+    assert(onwhat() == CELL);
+    auto derived_class_ptr = static_cast<CoreDriverType<CELL> *>(this);
+    derived_class_ptr->set_lazy_interface_reconstruction(lazy);
+  }
+
+  /// Interface reconstruction type along with its input fingerprint
+  using Reconstruction = InterfaceReconstruction<
+    Tangram::Driver<InterfaceReconstructorType, D, SourceMesh,
+                    Matpoly_Splitter, Matpoly_Clipper>>;
+
+  /*!
+    @brief keep the interface reconstruction and reuse it as long as
+    the source data is unchanged
+    @param enable Whether to keep and reuse the reconstruction.
+  */
+  void enable_reconstruction_cache(bool enable = true) {
+    assert(onwhat() == CELL);
+    auto derived_class_ptr = static_cast<CoreDriverType<CELL> *>(this);
+    derived_class_ptr->enable_reconstruction_cache(enable);
+  }
+
+  /*!
+    @brief retrieve the kept interface reconstruction
+    @return the reconstruction and the fingerprint of its data
+  */
+  Reconstruction const& interface_reconstruction() {
+    assert(onwhat() == CELL);
+    auto derived_class_ptr = static_cast<CoreDriverType<CELL> *>(this);
+    return derived_class_ptr->interface_reconstruction();
+  }
+
+  /*!
+    @brief number of mixed source cells handed to the interface
+    reconstructor by the last material intersection
+    @return the number of reconstructed cells on this rank
+  */
+  int num_reconstructed_cells() {
+    assert(onwhat() == CELL);
+    auto derived_class_ptr = static_cast<CoreDriverType<CELL> *>(this);
+    return derived_class_ptr->num_reconstructed_cells();
+  }
+
+  /*!
+    @brief adopt an existing interface reconstruction
+    @param reconstruction The reconstruction to reuse.
+  */
+  void set_interface_reconstruction(Reconstruction const& reconstruction) {
+    assert(onwhat() == CELL);
+    auto derived_class_ptr = static_cast<CoreDriverType<CELL> *>(this);
+    derived_class_ptr->set_interface_reconstruction(reconstruction);
+  }
+
 #endif
 
 };
@@ -559,7 +694,8 @@ class CoreDriver : public CoreDriverBase<D,
     @tparam Search Search class templated on dimension, Entity_kind
     and both meshes
 
-    @return Vector of intersection candidates for each target entity
+    @return Vector of intersection candidates for each target entity,
+    sorted by source entity index
   */
 
   template<template<int, Entity_kind, class, class> class Search>
@@ -574,9 +710,17 @@ class CoreDriver : public CoreDriverBase<D,
     // initialize search candidate vector
     Portage::vector<std::vector<int>> candidates(ntarget_ents);
 
+    // candidates come out in tree traversal order: sort them by source
+    // index so that the intersector pulls source geometry in memory
+    // order, which follows the curve when sources were renumbered
     Portage::transform(target_mesh_.begin(ONWHAT, PARALLEL_OWNED),
                        target_mesh_.end(ONWHAT, PARALLEL_OWNED),
-                       candidates.begin(), search_functor);
+                       candidates.begin(),
+                       [&search_functor](int entity) {
+      std::vector<int> list = search_functor(entity);
+      std::sort(list.begin(), list.end());
+      return list;
+    });
 
     return candidates;
   }
@@ -621,11 +765,21 @@ class CoreDriver : public CoreDriverBase<D,
               InterfaceReconstructorType, Matpoly_Splitter, Matpoly_Clipper>
         intersector(source_mesh_, source_state_, target_mesh_, num_tols_);
 
-    Portage::transform(target_mesh_.begin(ONWHAT, PARALLEL_OWNED),
-                       target_mesh_.end(ONWHAT, PARALLEL_OWNED),
-                       candidates.begin(),
-                       sources_and_weights.begin(),
-                       intersector);
+    if (cost_.enabled()) {
+      auto const pieces = target_pieces(intersector, nents);
+      auto const timed = make_timed_intersect(intersector, cost_, pieces);
+      Portage::transform(target_mesh_.begin(ONWHAT, PARALLEL_OWNED),
+                         target_mesh_.end(ONWHAT, PARALLEL_OWNED),
+                         candidates.begin(),
+                         sources_and_weights.begin(),
+                         timed);
+    } else {
+      Portage::transform(target_mesh_.begin(ONWHAT, PARALLEL_OWNED),
+                         target_mesh_.end(ONWHAT, PARALLEL_OWNED),
+                         candidates.begin(),
+                         sources_and_weights.begin(),
+                         intersector);
+    }
 
     return sources_and_weights;
   }
@@ -644,6 +798,63 @@ class CoreDriver : public CoreDriverBase<D,
     num_tols_ = num_tols;
   }
 
+  /*!
+    @brief Select the order of remap per source entity.
+
+    Gradients are only computed on source entities where the range of
+    values among the entity and its neighbors, relative to the entity
+    value, exceeds the threshold. They are zero elsewhere, so that
+    second order interpolation reduces to first order there without
+    the cost of a least squares fit, a limiter or source centroids.
+    The default zero threshold only skips locally constant fields,
+    which leaves results unchanged.
+
+    @param threshold  relative smoothness threshold
+  */
+  void set_adaptive_order_threshold(double threshold) {
+    adaptive_order_threshold_ = threshold;
+  }
+
+  /*!
+    @brief Record the intersection cost of each target entity.
+
+    When enabled, subsequent calls to intersect_meshes and
+    intersect_materials accumulate for each target entity the time
+    spent in the intersector, the number of convex clips it required
+    (source polytopes times the target pieces reported by the
+    intersector, a single piece unless it splits target entities)
+    and the number of source material polytopes it was intersected
+    with. Recording is off by default since it adds a clock query per
+    target entity.
+
+    @param enable  whether to record costs; disabling drops them.
+  */
+  void enable_cost_map(bool enable = true) {
+    cost_.reset(enable ? target_mesh_.num_entities(ONWHAT, ALL) : 0);
+  }
+
+  /// Intersection costs recorded so far for each target entity
+  RemapCost const& cost_map() const { return cost_; }
+
+  /*!
+    @brief Write recorded intersection costs as target fields.
+
+    Adds the fields '<prefix>_time', '<prefix>_clips' and
+    '<prefix>_matpolys' on target entities of kind ONWHAT, so that
+    they can be exported along with remapped fields.
+
+    @param prefix  prefix of the cost field names.
+  */
+  void write_cost_map(std::string const& prefix = "remap_cost") {
+    if (not cost_.enabled())
+      throw std::runtime_error("cost map was not enabled before intersection");
+
+    target_state_.mesh_add_data(ONWHAT, prefix + "_time", cost_.time.data());
+    target_state_.mesh_add_data(ONWHAT, prefix + "_clips", cost_.clips.data());
+    target_state_.mesh_add_data(ONWHAT, prefix + "_matpolys",
+                                cost_.matpolys.data());
+  }
+
 #ifdef HAVE_TANGRAM
   /*!
     @brief set options for interface reconstructor driver
@@ -664,6 +875,75 @@ class CoreDriver : public CoreDriverBase<D,
     reconstructor_all_convex_ = all_convex; 
   }
 
+  /*!
+    @brief restrict interface reconstruction to the source cells that
+    are needed by the intersection candidates
+
+    Only mixed cells that are candidates of some owned target cell
+    need material polytopes, along with their node neighbors for the
+    stencil of gradients. Other mixed cells are handed to the
+    reconstructor as pure cells of their dominant material, so that
+    their material polytopes are neither computed nor available:
+    they must not be queried (e.g. to write them out). Gradients of
+    material fields are only computed on candidate cells.
+
+    @param lazy Whether to skip unneeded mixed cells.
+  */
+  void set_lazy_interface_reconstruction(bool lazy = true) {
+    lazy_reconstruction_ = lazy;
+  }
+
+  /// Interface reconstruction type along with its input fingerprint
+  using Reconstruction = InterfaceReconstruction<
+    Tangram::Driver<InterfaceReconstructorType, D, SourceMesh,
+                    Matpoly_Splitter, Matpoly_Clipper>>;
+
+  /*!
+    @brief keep the interface reconstruction and reuse it in later
+    calls to intersect_materials
+
+    The volume fractions, centroids and coordinates of source cells, as
+    well as the reconstructor options, are fingerprinted on each call:
+    interfaces are reconstructed again only if any of them changed on
+    any rank.
+
+    @param enable Whether to keep and reuse the reconstruction.
+  */
+  void enable_reconstruction_cache(bool enable = true) {
+    cache_reconstruction_ = enable;
+  }
+
+  /*!
+    @brief retrieve the kept interface reconstruction, e.g. to hand it
+    to another driver with the same source mesh and state
+    @return the reconstruction and the fingerprint of its data, which
+    is empty unless the reconstruction cache is enabled.
+  */
+  Reconstruction const& interface_reconstruction() const {
+    return reconstruction_;
+  }
+
+  /*!
+    @brief number of mixed source cells handed to the interface
+    reconstructor by the last material intersection, which is smaller
+    than the number of mixed cells with lazy reconstruction
+    @return the number of reconstructed cells on this rank
+  */
+  int num_reconstructed_cells() const { return num_reconstructed_cells_; }
+
+  /*!
+    @brief adopt an existing interface reconstruction and enable the
+    reconstruction cache: it is reused as long as the source data
+    matches its fingerprint
+    @param reconstruction The reconstruction to reuse.
+  */
+  void set_interface_reconstruction(Reconstruction const& reconstruction) {
+    reconstruction_ = reconstruction;
+    interface_reconstructor_ = reconstruction.reconstructor;
+    material_cell_index_.clear();
+    cache_reconstruction_ = true;
+  }
+
 #endif
 
 
@@ -700,24 +980,6 @@ class CoreDriver : public CoreDriverBase<D,
            typeid(DummyInterfaceReconstructor<SourceMesh, D,
                   Matpoly_Splitter, Matpoly_Clipper>));
 
-    // Intel 18.0.1 does not recognize std::make_unique even with -std=c++14 flag *ugh*
-    // interface_reconstructor_ =
-    //     std::make_unique<Tangram::Driver<InterfaceReconstructorType, D,
-    //                                      SourceMesh,
-    //                                      Matpoly_Splitter,
-    //                                      Matpoly_Clipper>
-    //                      >(source_mesh_, tols, true);
-    interface_reconstructor_ =
-        std::unique_ptr<Tangram::Driver<InterfaceReconstructorType, D,
-                                        SourceMesh,
-                                        Matpoly_Splitter,
-                                        Matpoly_Clipper>
-                        >(new Tangram::Driver<InterfaceReconstructorType, D,
-                          SourceMesh,
-                          Matpoly_Splitter,
-                          Matpoly_Clipper>(source_mesh_, reconstructor_tols_,
-                                           reconstructor_all_convex_));
-
     int ntargetcells = target_mesh_.num_entities(CELL, PARALLEL_OWNED);
 
 
@@ -731,11 +993,69 @@ class CoreDriver : public CoreDriverBase<D,
     ccc_vfcen_data(cell_num_mats, cell_mat_ids, cell_mat_volfracs,
                    cell_mat_centroids);
 
-    interface_reconstructor_->set_volume_fractions(cell_num_mats,
-                                                   cell_mat_ids,
-                                                   cell_mat_volfracs,
-                                                   cell_mat_centroids);
-    interface_reconstructor_->reconstruct(executor_);
+    if (lazy_reconstruction_)
+      restrict_reconstruction(candidates, cell_num_mats, cell_mat_ids,
+                              cell_mat_volfracs, cell_mat_centroids);
+    else {
+      candidate_cells_.clear();
+      reconstructed_cells_.clear();
+    }
+
+    num_reconstructed_cells_ = std::count_if(cell_num_mats.begin(),
+                                             cell_num_mats.end(),
+                                             [](int n) { return n > 1; });
+
+    // Reuse the kept reconstruction if no cell has changed on any rank
+    bool reconstruct = true;
+    if (cache_reconstruction_) {
+      auto fingerprint = reconstruction_fingerprint<D>(source_mesh_,
+                                                       cell_num_mats,
+                                                       cell_mat_ids,
+                                                       cell_mat_volfracs,
+                                                       cell_mat_centroids);
+      std::uint64_t const options = reconstructor_options_fingerprint();
+      int changed = reconstruction_.count_changed(fingerprint, options);
+#ifdef PORTAGE_ENABLE_MPI
+      if (mycomm_ != MPI_COMM_NULL)
+        MPI_Allreduce(MPI_IN_PLACE, &changed, 1, MPI_INT, MPI_SUM, mycomm_);
+#endif
+      reconstruct = changed > 0;
+      reconstruction_.fingerprint = std::move(fingerprint);
+      reconstruction_.options = options;
+    } else
+      reconstruction_ = {};
+
+    if (reconstruct) {
+      // Intel 18.0.1 does not recognize std::make_unique even with -std=c++14 flag *ugh*
+      // interface_reconstructor_ =
+      //     std::make_unique<Tangram::Driver<InterfaceReconstructorType, D,
+      //                                      SourceMesh,
+      //                                      Matpoly_Splitter,
+      //                                      Matpoly_Clipper>
+      //                      >(source_mesh_, tols, true);
+      interface_reconstructor_ =
+          std::unique_ptr<Tangram::Driver<InterfaceReconstructorType, D,
+                                          SourceMesh,
+                                          Matpoly_Splitter,
+                                          Matpoly_Clipper>
+                          >(new Tangram::Driver<InterfaceReconstructorType, D,
+                            SourceMesh,
+                            Matpoly_Splitter,
+                            Matpoly_Clipper>(source_mesh_, reconstructor_tols_,
+                                             reconstructor_all_convex_));
+
+      interface_reconstructor_->set_volume_fractions(cell_num_mats,
+                                                     cell_mat_ids,
+                                                     cell_mat_volfracs,
+                                                     cell_mat_centroids);
+      interface_reconstructor_->reconstruct(executor_);
+
+      // material cell offsets and centroids depend on the reconstruction
+      material_cell_index_.clear();
+
+      if (cache_reconstruction_)
+        reconstruction_.reconstructor = interface_reconstructor_;
+    }
 
     // Make an intersector which knows about the source state (to be
     // able to query the number of materials, etc) and also knows
@@ -753,6 +1073,11 @@ class CoreDriver : public CoreDriverBase<D,
     std::vector<Portage::vector<std::vector<Weights_t>>>
         source_weights_by_mat(nmats);
 
+    // target pieces do not depend on the material
+    std::vector<int> pieces;
+    if (cost_.enabled())
+      pieces = target_pieces(intersector, ntargetcells);
+
     for (int m = 0; m < nmats; m++) {
       std::vector<int> matcellstgt;
 
@@ -784,11 +1109,21 @@ class CoreDriver : public CoreDriverBase<D,
 
 
       std::vector<std::vector<Weights_t>> this_mat_sources_and_wts(ntargetcells);
-      Portage::transform(target_mesh_.begin(CELL, PARALLEL_OWNED),
-                         target_mesh_.end(CELL, PARALLEL_OWNED),
-                         candidates.begin(),
-                         this_mat_sources_and_wts.begin(),
-                         intersector);
+      if (cost_.enabled()) {
+        auto const polytopes = [this, m](int s) { return material_polytopes(m, s); };
+        auto const timed = make_timed_intersect(intersector, cost_, pieces, polytopes);
+        Portage::transform(target_mesh_.begin(CELL, PARALLEL_OWNED),
+                           target_mesh_.end(CELL, PARALLEL_OWNED),
+                           candidates.begin(),
+                           this_mat_sources_and_wts.begin(),
+                           timed);
+      } else {
+        Portage::transform(target_mesh_.begin(CELL, PARALLEL_OWNED),
+                           target_mesh_.end(CELL, PARALLEL_OWNED),
+                           candidates.begin(),
+                           this_mat_sources_and_wts.begin(),
+                           intersector);
+      }
 
       // LOOK AT INTERSECTION WEIGHTS TO DETERMINE WHICH TARGET CELLS
       // WILL GET NEW MATERIALS
@@ -933,9 +1268,11 @@ class CoreDriver : public CoreDriverBase<D,
 
         // Filter out GHOST cells
         // SHOULD BE IN HANDLED IN THE STATE MANAGER (See ticket LNK-1589)
+        // Skip cells that are not needed by lazy reconstruction
         mat_cells.reserve(nallent);
         for (auto const& c : mat_cells_all)
-          if (source_mesh_.cell_get_type(c) == PARALLEL_OWNED)
+          if (source_mesh_.cell_get_type(c) == PARALLEL_OWNED and
+              (candidate_cells_.empty() or candidate_cells_[c]))
             mat_cells.push_back(c);
       }
       else
@@ -957,6 +1294,7 @@ class CoreDriver : public CoreDriverBase<D,
     Gradient kernel(source_mesh_, source_state_, field_name,
                     limiter_type, boundary_limiter_type, source_part);
 #endif
+    kernel.set_smoothness_threshold(adaptive_order_threshold_);
 
     // create the field (material cell indices have owned and ghost
     // cells mixed together; so we have to have a vector of size
@@ -991,6 +1329,45 @@ class CoreDriver : public CoreDriverBase<D,
     return gradient_field;
   }
 
+  /**
+   * @brief Compute the gradient fields of several cell-centered mesh
+   *        variables on source mesh and limit them in a single pass.
+   *
+   * The vertex offsets used by the limiter are fetched once for all
+   * the variables, which may also share the limiter factor of a cell.
+   *
+   * @param field_names: the variable names.
+   * @param limiter_type: gradient limiter to use on internal regions.
+   * @param boundary_limiter_type: gradient limiter to use on boundary.
+   * @param coupled: whether all variables share the limiter factor of a cell.
+   * @return the gradient field of each variable.
+   */
+  std::vector<Portage::vector<Vector<D>>> compute_source_gradients(
+    std::vector<std::string> const& field_names,
+    Limiter_type limiter_type = NOLIMITER,
+    Boundary_Limiter_type boundary_limiter_type = BND_NOLIMITER,
+    bool coupled = false) const {
+
+    assert(ONWHAT == Entity_kind::CELL);
+
+    int const nb_fields = field_names.size();
+    std::vector<double const*> values(nb_fields, nullptr);
+    std::vector<Portage::vector<Vector<D>>> gradients(nb_fields);
+
+    for (int k = 0; k < nb_fields; ++k) {
+#ifdef HAVE_TANGRAM
+      if (source_state_.field_type(ONWHAT, field_names[k]) != Field_type::MESH_FIELD)
+        throw std::runtime_error("only mesh fields can be limited together");
+#endif
+      source_state_.mesh_get_data(ONWHAT, field_names[k], &values[k]);
+      gradients[k] = compute_source_gradient(field_names[k]);
+    }
+
+    Limiter<D, SourceMesh> limiter(source_mesh_);
+    limiter.limit(values, gradients, limiter_type, boundary_limiter_type, coupled);
+    return gradients;
+  }
+
   /**
    * @brief Interpolate mesh variable.
    *
@@ -1044,7 +1421,9 @@ class CoreDriver : public CoreDriverBase<D,
    *
    * @param[in] srcvarname          source mesh variable to remap
    * @param[in] trgvarname          target mesh variable to remap
-   * @param[in] sources_and_weights weights for mesh-mesh interpolation
+   * @param[in] sources_and_weights weights for mesh-mesh interpolation,
+   *                                unused if the part pair already holds
+   *                                them from build_part_weights
    * @param[in] lower_bound         lower bound of variable value 
    * @param[in] upper_bound         upper bound of variable value 
    * @param[in] partition           structure containing source and target part
@@ -1107,10 +1486,10 @@ class CoreDriver : public CoreDriverBase<D,
     // to prevent bugs when interpolating values:
     // check that each entity id is within the
     // mesh entity index space.
-    auto const& source_part = partition->source();
     auto const& target_part = partition->target();
 
 #ifdef DEBUG
+    auto const& source_part = partition->source();
     int const& max_source_id = source_mesh_.num_entities(ONWHAT, ALL);
     int const& max_target_id = target_mesh_.num_entities(ONWHAT, ALL);
 
@@ -1124,56 +1503,29 @@ class CoreDriver : public CoreDriverBase<D,
 #endif
 
     int const target_part_size = target_part.size();
+    auto const& target_cells = target_part.cells();
 
-    // 2. Filter intersection weights list.
-    // To restrict interpolation only to source-target parts, we need
-    // to filter the intersection weights list to keep only that of the
-    // entities of the source part. Notice that this step can be avoided
+    // 2. Restrict intersection weights to the source part, unless the
+    // caller filtered them once for all fields of the pair with
+    // PartPair::build_part_weights. Notice that this step can be avoided
     // when the part-by-part intersection is implemented.
+    std::vector<entity_weights_t> filtered_weights;
+    if (not partition->has_part_weights())
+      partition->filter_weights(sources_and_weights, &filtered_weights);
 
-    auto filter_weights = [&](int entity) {
-      // For a given target entity, we aim to filter its source weights
-      // list to keep only those which are in the source part list.
-      // that way, we ensure that only the contribution of source part entities
-      // weights are taken into account when doing the interpolation.
-      // For that, we just iterate on the related weight list, and add the
-      // current couple of entity/weights if it belongs to the source part.
-      // nb: 'auto' may imply unexpected behavior with thrust enabled.
-      entity_weights_t const& entity_weights = sources_and_weights[entity];
-      entity_weights_t heap;
-      heap.reserve(10); // size of a local vicinity
-      for (auto&& weight : entity_weights) {
-        // constant-time lookup in average case.
-        if(source_part.contains(weight.entityID)) {
-          heap.emplace_back(weight);
-        }
-      }
-      heap.shrink_to_fit();
-      return heap;
-    };
-
-    Portage::vector<entity_weights_t> parts_weights(target_part_size);
-    Portage::transform(target_part.cells().begin(),
-                       target_part.cells().end(),
-                       parts_weights.begin(), filter_weights);
+    auto const& parts_weights = partition->has_part_weights()
+                                ? partition->part_weights() : filtered_weights;
 
     // 3. Process interpolation.
-    // Now that intersection weights is filtered, perform the interpolation.
-    // Notice that we need to store the interpolated values in a temporary
-    // array since they are indexed with respect to the target part
-    // and not to the target mesh. Hence we need to copy them back in the
-    // target state at their correct (absolute index) memory locations.
-    T temporary_storage[target_part_size];
-    Portage::pointer<T> target_part_field(temporary_storage);
-
-    Portage::transform(target_part.cells().begin(),
-                       target_part.cells().end(),
-                       parts_weights.begin(), target_part_field, interpolator);
-
-    for (int i=0; i < target_part_size; ++i) {
-      auto const& j = target_part.cells()[i];
-      target_mesh_field[j] = target_part_field[i];
-    }
+    // Filtered weights are indexed with respect to the target part, so
+    // interpolated values are written directly at their absolute index
+    // in the target field.
+    Portage::for_each(Portage::make_counting_iterator(0),
+                      Portage::make_counting_iterator(target_part_size),
+                      [&](int i) {
+      int const t = target_cells[i];
+      target_mesh_field[t] = interpolator(t, parts_weights[i]);
+    });
   }
   
 
@@ -1232,11 +1584,21 @@ class CoreDriver : public CoreDriverBase<D,
       
     int const nmats = source_state_.num_materials();
 
+    // gather material cell offsets and centroids once for all variables
+    if (interface_reconstructor_ and
+        static_cast<int>(material_cell_index_.size()) != nmats)
+      material_cell_index_ =
+        build_material_cell_index<D>(source_mesh_, source_state_,
+                                     *interface_reconstructor_,
+                                     reconstructed_cells_);
+
     for (int m = 0; m < nmats; m++) {
 
       interpolator.set_material(m);    // We have to do this so we know
       //                               // which material values we have
       //                               // to grab from the source state
+      if (not material_cell_index_.empty())
+        set_material_cell_index(interpolator, &(material_cell_index_[m]));
 
       auto mat_grad = (gradients != nullptr ? &((*gradients)[m]) : nullptr);
       // FEATURE ;-)  Have to set interpolation variable AFTER setting 
@@ -1382,6 +1744,10 @@ class CoreDriver : public CoreDriverBase<D,
   TargetState & target_state_;
 
   NumericTolerances_t num_tols_ = DEFAULT_NUMERIC_TOLERANCES<D>;
+  double adaptive_order_threshold_ = 0.;
+
+  // Intersection cost of each target entity, empty unless enabled
+  RemapCost cost_;
 
   int comm_rank_ = 0;
   int nprocs_ = 1;
@@ -1418,8 +1784,121 @@ class CoreDriver : public CoreDriverBase<D,
                                   SourceMesh,
                                   Matpoly_Splitter, Matpoly_Clipper>
                   > interface_reconstructor_;
+
+  // Offsets and centroids of the source cells of each material,
+  // built on first material interpolation after reconstruction
+  std::vector<MaterialCellIndex<D>> material_cell_index_;
+
+  // Lazy reconstruction: source cells that are candidates of an owned
+  // target cell, and mixed cells actually reconstructed (empty if all)
+  bool lazy_reconstruction_ = false;
+  std::vector<char> candidate_cells_;
+  std::vector<char> reconstructed_cells_;
+  int num_reconstructed_cells_ = 0;
+
+  // Kept reconstruction and fingerprint of its data
+  bool cache_reconstruction_ = false;
+  Reconstruction reconstruction_;
+
+  // Fingerprint of the options handed to the reconstructor
+  std::uint64_t reconstructor_options_fingerprint() const {
+    std::uint64_t hash = hash_seed;
+    hash_bytes(hash, &reconstructor_all_convex_, sizeof(bool));
+    for (auto const& tol : reconstructor_tols_) {
+      hash_bytes(hash, &(tol.max_num_iter), sizeof(tol.max_num_iter));
+      hash_bytes(hash, &(tol.arg_eps), sizeof(tol.arg_eps));
+      hash_bytes(hash, &(tol.fun_eps), sizeof(tol.fun_eps));
+    }
+    return hash;
+  }
+
+  // Mark the source cells needed by the candidates and collapse other
+  // mixed cells to their dominant material in the compact cell-centric
+  // data handed to the interface reconstructor
+  void restrict_reconstruction(Portage::vector<std::vector<int>> const& candidates,
+                               std::vector<int>& cell_num_mats,
+                               std::vector<int>& cell_mat_ids,
+                               std::vector<double>& cell_mat_volfracs,
+                               std::vector<Wonton::Point<D>>& cell_mat_centroids) {
+
+    int const nsourcecells = source_mesh_.num_entities(CELL, ALL);
+    int const ntargetcells = target_mesh_.num_entities(CELL, PARALLEL_OWNED);
+
+    candidate_cells_.assign(nsourcecells, 0);
+    reconstructed_cells_.assign(nsourcecells, 0);
+
+    for (int t = 0; t < ntargetcells; t++) {
+      std::vector<int> const& sources = candidates[t];
+      for (int const& s : sources)
+        candidate_cells_[s] = 1;
+    }
+
+    // candidates and their neighbors which are mixed
+    std::vector<int> neighbors;
+    for (int c = 0; c < nsourcecells; c++) {
+      if (not candidate_cells_[c])
+        continue;
+      if (cell_num_mats[c] > 1)
+        reconstructed_cells_[c] = 1;
+      source_mesh_.cell_get_node_adj_cells(c, ALL, &neighbors);
+      for (int const& n : neighbors)
+        if (cell_num_mats[n] > 1)
+          reconstructed_cells_[n] = 1;
+    }
+
+    bool const have_centroids = not cell_mat_centroids.empty();
+    int offset = 0;
+    int idx = 0;
+    for (int c = 0; c < nsourcecells; c++) {
+      int const nmats = cell_num_mats[c];
+      int kept = offset;
+      int nkept = nmats;
+
+      if (nmats > 1 and not reconstructed_cells_[c]) {
+        for (int i = offset + 1; i < offset + nmats; i++)
+          if (cell_mat_volfracs[i] > cell_mat_volfracs[kept])
+            kept = i;
+        nkept = 1;
+        cell_num_mats[c] = 1;
+        cell_mat_volfracs[kept] = 1.;
+      }
+
+      for (int i = kept; i < kept + nkept; i++, idx++) {
+        cell_mat_ids[idx] = cell_mat_ids[i];
+        cell_mat_volfracs[idx] = cell_mat_volfracs[i];
+        if (have_centroids)
+          cell_mat_centroids[idx] = cell_mat_centroids[i];
+      }
+      offset += nmats;
+    }
+
+    cell_mat_ids.resize(idx);
+    cell_mat_volfracs.resize(idx);
+    if (have_centroids)
+      cell_mat_centroids.resize(idx);
+  }
   
 
+  // Scratch storage of material_polytopes for each thread
+  struct MaterialCostWorkspace {
+    std::vector<int> cellmats;
+  };
+
+  // Number of polytopes of material m in a source cell, mirroring what
+  // the intersector clips: pure source cells are a single polytope,
+  // mixed ones are split by the interface reconstructor.
+  int material_polytopes(int m, int s) const {
+    auto& cellmats = thread_workspace<MaterialCostWorkspace>().cellmats;
+    cellmats.clear();
+    source_state_.cell_get_mats(s, &cellmats);
+    if (cellmats.empty() or (cellmats.size() == 1 and cellmats[0] == m))
+      return 1;
+    if (std::find(cellmats.begin(), cellmats.end(), m) != cellmats.end())
+      return interface_reconstructor_->cell_matpoly_data(s)
+                                      .get_matpolys(m).size();
+    return 0;
+  }
+
   // Convert volume fraction and centroid data from compact
   // material-centric to compact cell-centric (ccc) form as needed
   // by Tangram
@@ -0,0 +1,486 @@
+/*
+This file is part of the Ristra portage project.
+Please see the license file at the root of this repository, or at:
+    https://github.com/laristra/portage/blob/master/LICENSE
+*/
+
+#ifndef PORTAGE_DRIVER_MOMENTUM_REMAP_H_
+#define PORTAGE_DRIVER_MOMENTUM_REMAP_H_
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifdef PORTAGE_ENABLE_MPI
+#include <mpi.h>
+#endif
+
+// portage includes
+#include "portage/driver/coredriver.h"
+#include "portage/interpolate/gradient.h"
+#include "portage/interpolate/interpolate_2nd_order.h"
+#include "portage/intersect/intersect_rNd.h"
+#include "portage/search/search_kdtree.h"
+#include "portage/support/corner_geometry_cache.h"
+#include "portage/support/portage.h"
+
+// wonton includes
+#include "wonton/support/Point.h"
+#include "wonton/support/Vector.h"
+
+/*!
+  @file momentum_remap.h
+  @brief Conservative remap of mass and momentum for hydro codes.
+
+  Staggered-grid hydro (SGH) codes store masses on corners and velocities
+  on nodes, while cell-centered hydro (CCH) codes store both on cells.
+  In both cases, density and specific momentum are reconstructed on the
+  source cells, remapped as cell fields, then integrated back on target
+  corners (SGH) or cells (CCH) so that total mass and momentum are
+  conserved. Meshes are expected to be partitioned consistently.
+*/
+
+namespace Portage {
+
+/// Hydro scheme whose mass and velocity are remapped.
+typedef enum {SGH = 1, CCH = 2} Momentum_remap_method;
+
+/**
+ * @class MomentumRemap
+ * @brief Remap of mass and velocity conserving total momentum.
+ *
+ * Corner loops run in parallel over the compressed corner adjacencies of
+ * a CornerGeometryCache, which callers remapping at every cycle may keep
+ * and pass in. Conservation diagnostics are reduced across ranks with a
+ * single collective when an MPI executor is given.
+ *
+ * @tparam D: the spatial dimension.
+ * @tparam Mesh_Wrapper: the mesh wrapper type, for source and target.
+ */
+template<int D, class Mesh_Wrapper>
+class MomentumRemap {
+public:
+  using Corners = CornerGeometryCache<D, Mesh_Wrapper>;
+
+  /// Totals and velocity bounds of a mass and velocity field.
+  struct Diagnostics {
+    double mass = 0.;
+    Wonton::Point<D> momentum;
+    Wonton::Point<D> umin;
+    Wonton::Point<D> umax;
+  };
+
+  /**
+   * @brief Create the remapper.
+   *
+   * @param method: the hydro scheme.
+   * @param executor: an MPI executor for distributed diagnostics.
+   */
+  explicit MomentumRemap(Momentum_remap_method method,
+                         Wonton::Executor_type const* executor = nullptr)
+    : method_(method), executor_(executor) {
+#ifdef PORTAGE_ENABLE_MPI
+    auto mpiexecutor = dynamic_cast<Wonton::MPIExecutor_type const*>(executor);
+    if (mpiexecutor && mpiexecutor->mpicomm != MPI_COMM_NULL)
+      mycomm_ = mpiexecutor->mpicomm;
+#endif
+  }
+
+  /// Entity kind of masses.
+  Entity_kind mass_kind() const {
+    return method_ == SGH ? Entity_kind::CORNER : Entity_kind::CELL;
+  }
+
+  /// Entity kind of velocities.
+  Entity_kind velocity_kind() const {
+    return method_ == SGH ? Entity_kind::NODE : Entity_kind::CELL;
+  }
+
+  /**
+   * @brief Remap mass and velocity.
+   *
+   * Masses are read from the "mass" field and velocity components from
+   * the "velocity_x", "velocity_y" and "velocity_z" fields of each state.
+   * Auxiliary cell fields "density" and "momentum_*" are added to both.
+   *
+   * @param source_mesh: the source mesh.
+   * @param source_state: the source state.
+   * @param target_mesh: the target mesh.
+   * @param target_state: the target state.
+   * @param limiter: the gradient limiter.
+   * @param source_corners: corner geometry of the source mesh, if any (SGH).
+   * @param target_corners: corner geometry of the target mesh, if any (SGH).
+   */
+  template<class State_Wrapper>
+  void remap(Mesh_Wrapper const& source_mesh, State_Wrapper& source_state,
+             Mesh_Wrapper const& target_mesh, State_Wrapper& target_state,
+             Limiter_type limiter,
+             Corners const* source_corners = nullptr,
+             Corners const* target_corners = nullptr) const;
+
+  /**
+   * @brief Compute total mass and momentum, and velocity bounds.
+   *
+   * Only owned entities are accounted for.
+   *
+   * @param mesh: the mesh.
+   * @param mass: corner (SGH) or cell (CCH) masses.
+   * @param u: node (SGH) or cell (CCH) velocity components.
+   * @param corners: corner geometry of the mesh, if any (SGH).
+   * @return the global diagnostics.
+   */
+  template<class T>
+  Diagnostics diagnostics(Mesh_Wrapper const& mesh,
+                          T const& mass, T const u[D],
+                          Corners const* corners = nullptr) const;
+
+protected:
+  Momentum_remap_method method_;
+  Wonton::Executor_type const* executor_;
+#ifdef PORTAGE_ENABLE_MPI
+  MPI_Comm mycomm_ = MPI_COMM_NULL;
+#endif
+
+private:
+  // mass, momentum, lower and upper velocity bounds
+  using Sums = std::array<double, 1 + 3 * D>;
+
+  // entities accumulated in a row, independently of the number of
+  // threads so that diagnostics are reproducible
+  static constexpr int chunk_size = 1024;
+
+  /// Neutral element of the combination of sums.
+  static Sums identity() {
+    Sums sums;
+    std::fill(sums.begin(), sums.begin() + 1 + D, 0.);
+    std::fill(sums.begin() + 1 + D, sums.begin() + 1 + 2 * D,
+              std::numeric_limits<double>::max());
+    std::fill(sums.begin() + 1 + 2 * D, sums.end(),
+              std::numeric_limits<double>::lowest());
+    return sums;
+  }
+
+  /// Combine sums, taking the sum of totals and the min/max of bounds.
+  static void combine(double const* in, double* inout) {
+    for (int i = 0; i < 1 + D; ++i)
+      inout[i] += in[i];
+    for (int i = 1 + D; i < 1 + 2 * D; ++i)
+      inout[i] = std::min(in[i], inout[i]);
+    for (int i = 1 + 2 * D; i < 1 + 3 * D; ++i)
+      inout[i] = std::max(in[i], inout[i]);
+  }
+
+#ifdef PORTAGE_ENABLE_MPI
+  /// Combine records of sums of several ranks.
+  static void combine_ranks(void* in, void* inout, int* len,
+                            MPI_Datatype* /* type */) {
+    auto const* in_sums = static_cast<double const*>(in);
+    auto* inout_sums = static_cast<double*>(inout);
+    for (int k = 0; k < *len; ++k)
+      combine(in_sums + k * (1 + 3 * D), inout_sums + k * (1 + 3 * D));
+  }
+#endif
+
+  /**
+   * @brief Accumulate a kernel over entities in parallel chunks.
+   *
+   * @param nb_entities: number of entities.
+   * @param sums: sums to update.
+   * @param kernel: updates partial sums with a given entity.
+   */
+  template<class Kernel>
+  static void accumulate(int nb_entities, Sums& sums, Kernel&& kernel) {
+    int const nb_chunks = (nb_entities + chunk_size - 1) / chunk_size;
+    std::vector<Sums> partial(nb_chunks, identity());
+
+    Portage::for_each(Portage::make_counting_iterator(0),
+                      Portage::make_counting_iterator(nb_chunks),
+                      [&](int k) {
+      int const last = std::min((k + 1) * chunk_size, nb_entities);
+      for (int i = k * chunk_size; i < last; ++i)
+        kernel(i, partial[k]);
+    });
+
+    for (auto const& chunk : partial)
+      combine(chunk.data(), sums.data());
+  }
+};
+
+
+/* ******************************************************************
+* Remap of mass and velocity
+****************************************************************** */
+template<int D, class Mesh_Wrapper>
+template<class State_Wrapper>
+void MomentumRemap<D, Mesh_Wrapper>::remap(
+    Mesh_Wrapper const& source_mesh, State_Wrapper& source_state,
+    Mesh_Wrapper const& target_mesh, State_Wrapper& target_state,
+    Limiter_type limiter,
+    Corners const* source_corners, Corners const* target_corners) const {
+
+  bool const sgh = method_ == SGH;
+
+  // build missing corner geometry
+  std::unique_ptr<Corners> source_cache, target_cache;
+  if (sgh and not source_corners) {
+    source_cache.reset(new Corners(source_mesh));
+    source_corners = source_cache.get();
+  }
+  if (sgh and not target_corners) {
+    target_cache.reset(new Corners(target_mesh));
+    target_corners = target_cache.get();
+  }
+
+  // mesh data
+  int const ncells_src = source_mesh.num_owned_cells() + source_mesh.num_ghost_cells();
+  int const ncells_trg = target_mesh.num_owned_cells();
+  int const nnodes_trg = target_mesh.num_owned_nodes();
+  int const ncorners_trg = target_mesh.num_owned_corners();
+
+  // state fields
+  std::string const velocity[3] = { "velocity_x", "velocity_y", "velocity_z" };
+  std::string const momentum[3] = { "momentum_x", "momentum_y", "momentum_z" };
+
+  double const* mass_src;
+  double const* u_src[D];
+  source_state.mesh_get_data(mass_kind(), "mass", &mass_src);
+  for (int i = 0; i < D; ++i)
+    source_state.mesh_get_data(velocity_kind(), velocity[i], &u_src[i]);
+
+  // Step 1: compute density and specific momentum of source cells,
+  // gathered from their corners (SGH) or taken as is (CCH)
+  std::vector<double> density(ncells_src);
+  std::vector<double> momentum_src[D];
+  for (int i = 0; i < D; ++i)
+    momentum_src[i].resize(ncells_src);
+
+  Portage::for_each(Portage::make_counting_iterator(0),
+                    Portage::make_counting_iterator(ncells_src),
+                    [&](int c) {
+    double mass_c = 0.;
+    double momentum_c[D] = {};
+
+    if (sgh) {
+      auto const& offsets = source_corners->cell_offsets();
+      auto const& corners = source_corners->cell_corners();
+      for (int k = offsets[c]; k < offsets[c + 1]; ++k) {
+        int const cn = corners[k];
+        int const v = source_corners->node(cn);
+        mass_c += mass_src[cn];
+        for (int i = 0; i < D; ++i)
+          momentum_c[i] += mass_src[cn] * u_src[i][v];
+      }
+    } else {
+      mass_c = mass_src[c];
+      for (int i = 0; i < D; ++i)
+        momentum_c[i] = mass_src[c] * u_src[i][c];
+    }
+
+    double const volume = source_mesh.cell_volume(c);
+    density[c] = mass_c / volume;
+    for (int i = 0; i < D; ++i)
+      momentum_src[i][c] = momentum_c[i] / volume;
+  });
+
+  // Step 2: remap density and specific momentum following three basic
+  // steps: search, intersect, and interpolate
+  CoreDriver<D, Entity_kind::CELL, Mesh_Wrapper, State_Wrapper>
+    driver(source_mesh, source_state, target_mesh, target_state, executor_);
+
+  auto candidates = driver.template search<SearchKDTree>();
+  auto weights = driver.template intersect_meshes<IntersectRND<D>::template Intersect>(candidates);
+
+  std::vector<std::string> field_names;
+  std::vector<double const*> field_pointers;
+
+  field_names.emplace_back("density");
+  field_pointers.emplace_back(density.data());
+  for (int i = 0; i < D; ++i) {
+    field_names.emplace_back(momentum[i]);
+    field_pointers.emplace_back(momentum_src[i].data());
+  }
+
+  int const nb_fields = field_names.size();
+  std::vector<double> tmp(ncells_trg);
+
+  for (int i = 0; i < nb_fields; ++i) {
+    source_state.mesh_add_data(Entity_kind::CELL, field_names[i], field_pointers[i]);
+    target_state.mesh_add_data(Entity_kind::CELL, field_names[i], tmp.data());
+  }
+
+  // limit all the gradients in a single pass over the source cells
+  auto source_gradients = driver.compute_source_gradients(field_names, limiter);
+
+  for (int i = 0; i < nb_fields; ++i)
+    driver.template interpolate_mesh_var<double, Interpolate_2ndOrder>(
+      field_names[i], field_names[i], weights, &source_gradients[i]);
+
+  double* mass_trg;
+  double* u_trg[D];
+  target_state.mesh_get_data(mass_kind(), "mass", &mass_trg);
+  for (int i = 0; i < D; ++i)
+    target_state.mesh_get_data(velocity_kind(), velocity[i], &u_trg[i]);
+
+  double* density_trg;
+  double const* momentum_trg[D];
+  target_state.mesh_get_data(Entity_kind::CELL, "density", &density_trg);
+  for (int i = 0; i < D; ++i)
+    target_state.mesh_get_data(Entity_kind::CELL, momentum[i], &momentum_trg[i]);
+
+  if (not sgh) {
+    // Step 3 (CCH): integrate density and specific momentum on target cells
+    Portage::for_each(Portage::make_counting_iterator(0),
+                      Portage::make_counting_iterator(ncells_trg),
+                      [&](int c) {
+      mass_trg[c] = density_trg[c] * target_mesh.cell_volume(c);
+      for (int i = 0; i < D; ++i)
+        u_trg[i][c] = momentum_trg[i][c] / density_trg[c];
+    });
+    return;
+  }
+
+  // Step 3 (SGH): create linear reconstruction (limited or unlimited)
+  // of density and specific momentum on the target mesh
+  int const ncells_all = ncells_trg + target_mesh.num_ghost_cells();
+  std::vector<Portage::vector<Vector<D>>> gradients(
+    nb_fields, Portage::vector<Vector<D>>(ncells_all));
+
+  for (int i = 0; i < nb_fields; ++i) {
+    Limited_Gradient<D, Entity_kind::CELL, Mesh_Wrapper, State_Wrapper>
+      gradient_kernel(target_mesh, target_state, field_names[i],
+                      limiter, BND_NOLIMITER);
+
+    Portage::transform(target_mesh.begin(Entity_kind::CELL),
+                       target_mesh.end(Entity_kind::CELL),
+                       gradients[i].begin(), gradient_kernel);
+  }
+
+  // Step 4 (SGH): integrate density and specific momentum on target
+  // corners, whose integral is the value at their centroid
+  std::vector<double> momentum_cn[D];
+  for (int i = 0; i < D; ++i)
+    momentum_cn[i].resize(ncorners_trg);
+
+  Portage::for_each(Portage::make_counting_iterator(0),
+                    Portage::make_counting_iterator(ncells_trg),
+                    [&](int c) {
+    Point<D> xc;
+    target_mesh.cell_centroid(c, &xc);
+
+    auto const& offsets = target_corners->cell_offsets();
+    auto const& corners = target_corners->cell_corners();
+    for (int k = offsets[c]; k < offsets[c + 1]; ++k) {
+      int const cn = corners[k];
+      double const cnvol = target_corners->volume(cn);
+      Vector<D> const dx = target_corners->centroid(cn) - xc;
+
+      mass_trg[cn] = cnvol * (density_trg[c] + dot(gradients[0][c], dx));
+      for (int i = 0; i < D; ++i)
+        momentum_cn[i][cn] = cnvol * (momentum_trg[i][c] + dot(gradients[i + 1][c], dx));
+    }
+  });
+
+  // Step 5 (SGH): gather corner data to target nodes and compute velocity
+  Portage::for_each(Portage::make_counting_iterator(0),
+                    Portage::make_counting_iterator(nnodes_trg),
+                    [&](int v) {
+    double mass_v = 0.;
+    double momentum_v[D] = {};
+
+    auto const& offsets = target_corners->node_offsets();
+    auto const& corners = target_corners->node_corners();
+    for (int k = offsets[v]; k < offsets[v + 1]; ++k) {
+      int const cn = corners[k];
+      if (cn >= ncorners_trg)
+        continue;
+      mass_v += mass_trg[cn];
+      for (int i = 0; i < D; ++i)
+        momentum_v[i] += momentum_cn[i][cn];
+    }
+
+    for (int i = 0; i < D; ++i)
+      u_trg[i][v] = momentum_v[i] / mass_v;
+  });
+}
+
+
+/* ******************************************************************
+* Conservation diagnostics
+****************************************************************** */
+template<int D, class Mesh_Wrapper>
+template<class T>
+typename MomentumRemap<D, Mesh_Wrapper>::Diagnostics
+MomentumRemap<D, Mesh_Wrapper>::diagnostics(
+    Mesh_Wrapper const& mesh, T const& mass, T const u[D],
+    Corners const* corners) const {
+
+  bool const sgh = method_ == SGH;
+
+  std::unique_ptr<Corners> cache;
+  if (sgh and not corners) {
+    cache.reset(new Corners(mesh));
+    corners = cache.get();
+  }
+
+  Sums sums = identity();
+
+  // total mass and momentum over owned cells
+  accumulate(mesh.num_owned_cells(), sums, [&](int c, Sums& local) {
+    if (sgh) {
+      auto const& offsets = corners->cell_offsets();
+      auto const& cell_corners = corners->cell_corners();
+      for (int k = offsets[c]; k < offsets[c + 1]; ++k) {
+        int const cn = cell_corners[k];
+        int const v = corners->node(cn);
+        local[0] += mass[cn];
+        for (int i = 0; i < D; ++i)
+          local[1 + i] += mass[cn] * u[i][v];
+      }
+    } else {
+      local[0] += mass[c];
+      for (int i = 0; i < D; ++i)
+        local[1 + i] += mass[c] * u[i][c];
+    }
+  });
+
+  // velocity bounds over owned nodes or cells
+  int const nb_velocities = sgh ? mesh.num_owned_nodes() : mesh.num_owned_cells();
+  accumulate(nb_velocities, sums, [&](int n, Sums& local) {
+    for (int i = 0; i < D; ++i) {
+      local[1 + D + i] = std::min(u[i][n], local[1 + D + i]);
+      local[1 + 2 * D + i] = std::max(u[i][n], local[1 + 2 * D + i]);
+    }
+  });
+
+#ifdef PORTAGE_ENABLE_MPI
+  if (mycomm_ != MPI_COMM_NULL) {
+    // sums are reduced as a single record so that the operator
+    // never receives a partial one
+    MPI_Datatype record;
+    MPI_Type_contiguous(1 + 3 * D, MPI_DOUBLE, &record);
+    MPI_Type_commit(&record);
+
+    MPI_Op op;
+    MPI_Op_create(&combine_ranks, 1, &op);
+    MPI_Allreduce(MPI_IN_PLACE, sums.data(), 1, record, op, mycomm_);
+    MPI_Op_free(&op);
+    MPI_Type_free(&record);
+  }
+#endif
+
+  Diagnostics result;
+  result.mass = sums[0];
+  for (int i = 0; i < D; ++i) {
+    result.momentum[i] = sums[1 + i];
+    result.umin[i] = sums[1 + D + i];
+    result.umax[i] = sums[1 + 2 * D + i];
+  }
+  return result;
+}
+
+}  // namespace Portage
+
+#endif  // PORTAGE_DRIVER_MOMENTUM_REMAP_H_
@@ -18,6 +18,9 @@
 #include <iostream>
 #include <type_traits>
 #include <limits>
+#include <numeric>
+#include <array>
+#include <stdexcept>
 
 #include "portage/support/portage.h"
 #include "portage/driver/fix_mismatch.h"
@@ -58,17 +61,29 @@ namespace Portage {
       size_ = cells.size();
       if (size_ > 0) {
         volumes_.resize(size_);
-        lookup_.reserve(size_);
 
-        // set relative indexing and populate lookup hashtables
-        for (int i = 0; i < size_; ++i) {
-          auto const& s = cells[i];
-          index_[s] = i;
-          lookup_.insert(s);
+        // set relative indexing: use a dense index array over the
+        // range of entity IDs unless the part is tiny compared to it.
+        int const max_id = *std::max_element(cells.begin(), cells.end());
+        dense_ = max_id < sparse_ratio_ * size_ + 64;
+
+        if (dense_) {
+          index_.assign(max_id + 1, -1);
+          for (int i = 0; i < size_; ++i)
+            index_[cells[i]] = i;
+        } else {
+          sorted_.resize(size_);
+          index_.resize(size_);
+          std::iota(index_.begin(), index_.end(), 0);
+          std::sort(index_.begin(), index_.end(),
+                    [&](int i, int j) { return cells[i] < cells[j]; });
+          for (int i = 0; i < size_; ++i)
+            sorted_[i] = cells[index_[i]];
         }
-      } else { 
+      } else {
         volumes_.clear();
-        lookup_.clear();
+        index_.clear();
+        sorted_.clear();
       }
     }
 
@@ -108,15 +123,31 @@ namespace Portage {
      * @param id entity ID
      * @return true if so, false otherwise.
      */
-    bool contains(int id) const { return lookup_.count(id) == 1; }
+    bool contains(int id) const {
+      if (dense_)
+        return id >= 0 and id < static_cast<int>(index_.size()) and index_[id] >= 0;
+      else
+        return std::binary_search(sorted_.begin(), sorted_.end(), id);
+    }
 
     /**
      * @brief Retrieve relative index of given entity.
      *
      * @param id: entity absolute index in mesh.
      * @return entity relative index in part.
+     * @throw std::out_of_range if the entity is not in the part.
      */
-    const int& index(int id) const { return index_.at(id); }
+    const int& index(int id) const {
+      if (dense_) {
+        if (contains(id))
+          return index_[id];
+      } else {
+        auto const it = std::lower_bound(sorted_.begin(), sorted_.end(), id);
+        if (it != sorted_.end() and *it == id)
+          return index_[it - sorted_.begin()];
+      }
+      throw std::out_of_range("entity " + std::to_string(id) + " not in part");
+    }
 
     /**
      * @brief Get part size.
@@ -154,7 +185,7 @@ namespace Portage {
       // filter then
       filtered.reserve(neigh.size());
       for (auto const& current : neigh) {
-        if (lookup_.count(current)) {
+        if (contains(current)) {
           filtered.emplace_back(current);
         }
       }
@@ -186,7 +217,7 @@ namespace Portage {
 
         // compute the volume of each entity of the part
         Portage::for_each(cells_.begin(), cells_.end(), [&](int s) {
-          auto const& i = index_[s];
+          auto const& i = index(s);
           auto const& volume = mesh_.cell_volume(s);
           volumes_[i] = (use_masks ? masks[s] * volume : volume);
         });
@@ -206,12 +237,19 @@ namespace Portage {
     bool cached_volumes = false;
 
     // part data consist of a list of cells, their volumes and relative indices.
-    // we rely on a hashtable to have constant-time parts lookup queries in average case.
+    // relative indices are stored in a dense array over the range of entity
+    // IDs (-1 if not in part) so that lookups are a single load. For parts
+    // much smaller than that range, they are stored by increasing entity ID
+    // along with the sorted IDs instead, and lookups are binary searches.
     // it is intended for lookup purposes only, and is not meant to be iterated.
-    std::vector<int>        cells_   = {};
-    std::vector<double>     volumes_ = {};
-    std::map<int, int>      index_   = {};
-    std::unordered_set<int> lookup_  = {};
+    std::vector<int>    cells_   = {};
+    std::vector<double> volumes_ = {};
+    std::vector<int>    index_   = {};
+    std::vector<int>    sorted_  = {};
+    bool dense_ = true;
+
+    // max ratio of entity ID range to part size for dense indexing
+    static constexpr int sparse_ratio_ = 32;
   };
 
 
@@ -325,6 +363,75 @@ public:
    */
   const TargetPart& target() const { return target_; }
 
+  /**
+   * @brief Restrict intersection weights to the source part.
+   *
+   * For each entity of the target part, only the moments of its
+   * intersection with entities of the source part are kept.
+   *
+   * @param source_weights: candidate source cells and their intersection
+   *                        moments for each entity of the target mesh.
+   * @param filtered: moments indexed relatively to the target part.
+   */
+  void filter_weights(Portage::vector<entity_weights_t> const& source_weights,
+                      std::vector<entity_weights_t>* filtered) const {
+    auto const& target_entities = target_.cells();
+    int const nb_entities = target_.size();
+    filtered->resize(nb_entities);
+
+    Portage::for_each(Portage::make_counting_iterator(0),
+                      Portage::make_counting_iterator(nb_entities),
+                      [&](int i) {
+      // nb: 'auto' may imply unexpected behavior with thrust enabled.
+      entity_weights_t const& moments = source_weights[target_entities[i]];
+      entity_weights_t& kept = (*filtered)[i];
+      kept.clear();
+      for (auto const& current : moments)
+        if (source_.contains(current.entityID))
+          kept.emplace_back(current);
+    });
+  }
+
+  /**
+   * @brief Filter intersection weights once for all fields of the pair.
+   *
+   * Interpolation on this pair then uses the stored filtered weights
+   * instead of filtering the supplied ones for each field. It must be
+   * called again, or clear_part_weights, whenever weights are recomputed.
+   *
+   * @param source_weights: candidate source cells and their intersection
+   *                        moments for each entity of the target mesh.
+   */
+  void build_part_weights(Portage::vector<entity_weights_t> const& source_weights) {
+    filter_weights(source_weights, &part_weights_);
+    has_part_weights_ = true;
+  }
+
+  /**
+   * @brief Discard the stored filtered weights.
+   */
+  void clear_part_weights() {
+    part_weights_.clear();
+    has_part_weights_ = false;
+  }
+
+  /**
+   * @brief Check if filtered weights were stored by build_part_weights.
+   *
+   * @return true if they were.
+   */
+  bool has_part_weights() const { return has_part_weights_; }
+
+  /**
+   * @brief Retrieve the stored filtered weights.
+   *
+   * @return moments indexed relatively to the target part.
+   */
+  std::vector<entity_weights_t> const& part_weights() const {
+    assert(has_part_weights_ && "build_part_weights must be called first!");
+    return part_weights_;
+  }
+
   /**
    * @brief Compute source and target parts intersection volume.
    *
@@ -340,7 +447,8 @@ public:
     Portage::for_each(target_entities.begin(), target_entities.end(), [&](int t) {
       auto const& i = target_.index(t);
       // accumulate moments
-      entity_weights_t const moments = source_weights[t];
+      // nb: 'auto' may imply unexpected behavior with thrust enabled.
+      entity_weights_t const& moments = source_weights[t];
       intersection_volumes_[i] = 0.;
       for (auto const& current : moments) {
         // matched source cell should be in the source part
@@ -385,32 +493,56 @@ public:
     // ------------------------------------------
     // COMPUTE VOLUMES ON SOURCE AND TARGET PARTS
     // ------------------------------------------
+    auto const local_volumes = compute_volumes(source_weights);
+    auto global_volumes = local_volumes;
+
+#ifdef PORTAGE_ENABLE_MPI
+    if (distributed_) {
+      MPI_Allreduce(local_volumes.data(), global_volumes.data(), 3,
+                    MPI_DOUBLE, MPI_SUM, mycomm_);
+    }
+#endif
+
+    return detect_mismatch(global_volumes);
+  }
+
+  /**
+   * @brief Compute source, target and intersection volumes of the parts.
+   *
+   * Entities of the source part that are masked out are not accounted.
+   *
+   * @param source_weights: source entities ID and weights for each target entity.
+   * @return the local source, target and intersection volumes.
+   */
+  std::array<double, 3>
+  compute_volumes(Portage::vector<entity_weights_t> const& source_weights) {
     // collect volumes of entities that are not masked out and sum them up
     double source_volume = source_.compute_entity_volumes(source_entities_masks_.data());
     double target_volume = target_.compute_entity_volumes();
     double intersect_volume = compute_intersect_volumes(source_weights);
+    return { source_volume, target_volume, intersect_volume };
+  }
 
-    global_source_volume_    = source_volume;
-    global_target_volume_    = target_volume;
-    global_intersect_volume_ = intersect_volume;
+  /**
+   * @brief Detect boundaries mismatch from global part volumes.
+   *
+   * Every rank must call it with the same volumes since it may
+   * involve collective communications.
+   *
+   * @param global_volumes: the global source, target and intersection volumes.
+   * @return true if a mismatch has been identified, false otherwise.
+   */
+  bool detect_mismatch(std::array<double, 3> const& global_volumes) {
 
-#ifdef PORTAGE_ENABLE_MPI
-    if (distributed_) {
-      MPI_Allreduce(&source_volume, &global_source_volume_, 1, MPI_DOUBLE, MPI_SUM, mycomm_);
-      MPI_Allreduce(&target_volume, &global_target_volume_, 1, MPI_DOUBLE, MPI_SUM, mycomm_);
-      MPI_Allreduce(&intersect_volume, &global_intersect_volume_, 1, MPI_DOUBLE, MPI_SUM, mycomm_);
+    global_source_volume_    = global_volumes[0];
+    global_target_volume_    = global_volumes[1];
+    global_intersect_volume_ = global_volumes[2];
 
-      if (rank_ == 0) {
-        std::printf("source volume: %.3f\n", global_source_volume_);
-        std::printf("target volume: %.3f\n", global_target_volume_);
-        std::printf("intersect volume: %.3f\n", global_intersect_volume_);
-      }
+    if (rank_ == 0) {
+      std::printf("source volume: %.3f\n", global_source_volume_);
+      std::printf("target volume: %.3f\n", global_target_volume_);
+      std::printf("intersect volume: %.3f\n", global_intersect_volume_);
     }
-#else
-    std::printf("source volume: %.3f\n", source_volume);
-    std::printf("target volume: %.3f\n", target_volume);
-    std::printf("intersect volume: %.3f\n", intersect_volume);
-#endif
 
     // In our initial redistribution phase, we will move as many
     // source cells as needed from different partitions to cover the
@@ -936,6 +1068,10 @@ private:
   std::vector<int>    source_entities_masks_ = {};
   std::vector<double> intersection_volumes_  = {};
 
+  // intersection moments restricted to the source part, if built
+  std::vector<entity_weights_t> part_weights_ = {};
+  bool has_part_weights_ = false;
+
   // data needed for mismatch checks
   double global_source_volume_    = 0.;
   double global_target_volume_    = 0.;
@@ -956,5 +1092,194 @@ private:
 #endif
 };
 
+/**
+ * @brief Remap several source-target part pairs in a single sweep.
+ *
+ * Parts must be disjoint on each side: every source and target cell is
+ * tagged with the index of the pair it belongs to, so that a single
+ * global search can be filtered inline to discard candidates from
+ * another part before intersecting. Mismatch checks of all pairs are
+ * then done with a single reduction of their volumes.
+ *
+ * @tparam D           the problem dimension.
+ * @tparam SourceMesh  the source mesh wrapper to use
+ * @tparam SourceState the source state wrapper to use
+ * @tparam TargetMesh  the target mesh wrapper to use
+ * @tparam TargetState the target state wrapper to use
+ */
+template<int D,
+  class SourceMesh, class SourceState,
+  class TargetMesh = SourceMesh,
+  class TargetState = SourceState
+>
+class PartBatch {
+  // shortcuts
+  using entity_weights_t = std::vector<Wonton::Weights_t>;
+  using Pair = PartPair<D, SourceMesh, SourceState, TargetMesh, TargetState>;
+
+public:
+  /**
+   * @brief Construct the part pairs and tag their cells.
+   *
+   * @param source_mesh   the source mesh
+   * @param source_state  the source mesh data
+   * @param target_mesh   the target mesh
+   * @param target_state  the target mesh data
+   * @param source_cells  the list of source cells of each part
+   * @param target_cells  the list of target cells of each part
+   * @param executor      the MPI executor to use
+   * @throw std::invalid_argument if a cell belongs to several parts.
+   */
+  PartBatch(SourceMesh const& source_mesh, SourceState& source_state,
+            TargetMesh const& target_mesh, TargetState& target_state,
+            std::vector<std::vector<int>> const& source_cells,
+            std::vector<std::vector<int>> const& target_cells,
+            Wonton::Executor_type const* executor) {
+
+    assert(source_cells.size() == target_cells.size());
+    int const nb_parts = source_cells.size();
+
+#ifdef PORTAGE_ENABLE_MPI
+    auto mpiexecutor = dynamic_cast<Wonton::MPIExecutor_type const *>(executor);
+    if (mpiexecutor && mpiexecutor->mpicomm != MPI_COMM_NULL) {
+      distributed_ = true;
+      mycomm_ = mpiexecutor->mpicomm;
+    }
+#endif
+
+    source_tags_.assign(source_mesh.num_entities(Entity_kind::CELL, Entity_type::ALL), -1);
+    target_tags_.assign(target_mesh.num_entities(Entity_kind::CELL, Entity_type::ALL), -1);
+
+    pairs_.reserve(nb_parts);
+    for (int i = 0; i < nb_parts; ++i) {
+      pairs_.emplace_back(source_mesh, source_state,
+                          target_mesh, target_state,
+                          source_cells[i], target_cells[i], executor);
+      tag(source_cells[i], i, source_tags_);
+      tag(target_cells[i], i, target_tags_);
+    }
+  }
+
+  /**
+   * @brief Get the number of part pairs.
+   *
+   * @return the number of part pairs.
+   */
+  int size() const { return pairs_.size(); }
+
+  /**
+   * @brief Retrieve a part pair.
+   *
+   * @param i: the part index.
+   * @return a reference to the part pair.
+   */
+  Pair& operator[](int i) { return pairs_[i]; }
+  Pair const& operator[](int i) const { return pairs_[i]; }
+
+  /**
+   * @brief Retrieve the part of a source cell.
+   *
+   * @param s: the source cell.
+   * @return its part index, or -1 if it belongs to none.
+   */
+  int source_tag(int s) const { return source_tags_[s]; }
+
+  /**
+   * @brief Retrieve the part of a target cell.
+   *
+   * @param t: the target cell.
+   * @return its part index, or -1 if it belongs to none.
+   */
+  int target_tag(int t) const { return target_tags_[t]; }
+
+  /**
+   * @brief Discard search candidates that belong to another part.
+   *
+   * Target cells outside of any part lose all their candidates, so
+   * that intersections are only computed within parts.
+   *
+   * @param candidates: the candidate source cells of each target cell.
+   */
+  void filter_candidates(Portage::vector<std::vector<int>>& candidates) const {
+    int const nb_target = candidates.size();
+
+    Portage::for_each(Portage::make_counting_iterator(0),
+                      Portage::make_counting_iterator(nb_target),
+                      [&](int t) {
+      // nb: 'auto' may imply unexpected behavior with thrust enabled.
+      std::vector<int> list = candidates[t];
+      int const part = target_tags_[t];
+      auto const last = std::remove_if(list.begin(), list.end(), [&](int s) {
+        return part < 0 or source_tags_[s] != part;
+      });
+      list.erase(last, list.end());
+      candidates[t] = list;
+    });
+  }
+
+  /**
+   * @brief Check boundaries mismatch of all part pairs.
+   *
+   * The volumes of all pairs are reduced at once instead of
+   * three reductions per pair.
+   *
+   * @param source_weights: source entities ID and weights for each target entity.
+   * @return true if a mismatch has been identified for any pair.
+   */
+  bool check_mismatch(Portage::vector<entity_weights_t> const& source_weights) {
+    int const nb_parts = pairs_.size();
+    std::vector<double> local_volumes(3 * nb_parts);
+
+    for (int i = 0; i < nb_parts; ++i) {
+      auto const volumes = pairs_[i].compute_volumes(source_weights);
+      std::copy(volumes.begin(), volumes.end(), local_volumes.begin() + 3 * i);
+    }
+
+    auto global_volumes = local_volumes;
+#ifdef PORTAGE_ENABLE_MPI
+    if (distributed_) {
+      MPI_Allreduce(local_volumes.data(), global_volumes.data(), 3 * nb_parts,
+                    MPI_DOUBLE, MPI_SUM, mycomm_);
+    }
+#endif
+
+    bool has_mismatch = false;
+    for (int i = 0; i < nb_parts; ++i) {
+      std::array<double, 3> const volumes = { global_volumes[3 * i],
+                                              global_volumes[3 * i + 1],
+                                              global_volumes[3 * i + 2] };
+      has_mismatch |= pairs_[i].detect_mismatch(volumes);
+    }
+    return has_mismatch;
+  }
+
+private:
+  /**
+   * @brief Tag cells with their part index.
+   *
+   * @param cells: the cells of the part.
+   * @param part: the part index.
+   * @param tags: the part index of each cell.
+   */
+  static void tag(std::vector<int> const& cells, int part, std::vector<int>& tags) {
+    for (auto const& c : cells) {
+      if (tags[c] >= 0 and tags[c] != part)
+        throw std::invalid_argument("cell " + std::to_string(c)
+                                    + " belongs to several parts");
+      tags[c] = part;
+    }
+  }
+
+  std::vector<Pair> pairs_ = {};
+  std::vector<int> source_tags_ = {};
+  std::vector<int> target_tags_ = {};
+
+  // MPI
+  bool distributed_ = false;
+#ifdef PORTAGE_ENABLE_MPI
+  MPI_Comm mycomm_ = MPI_COMM_NULL;
+#endif
+};
+
 } // end namespace Portage
 #endif //PORTAGE_PARTS_H
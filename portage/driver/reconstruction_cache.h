@@ -0,0 +1,148 @@
+/*
+This file is part of the Ristra portage project.
+Please see the license file at the root of this repository, or at:
+    https://github.com/laristra/portage/blob/master/LICENSE
+*/
+
+#ifndef PORTAGE_DRIVER_RECONSTRUCTION_CACHE_H_
+#define PORTAGE_DRIVER_RECONSTRUCTION_CACHE_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "wonton/support/Point.h"
+
+#include "portage/support/portage.h"
+
+/*!
+  @file reconstruction_cache.h
+  @brief Reuse of interface reconstructions across remaps.
+
+  Material polytopes of a source cell only depend on its geometry and
+  on the volume fractions and centroids of its materials. Each cell is
+  given a fingerprint of these inputs so that a reconstruction can be
+  kept and reused as long as the fingerprints of all cells are unchanged,
+  e.g. when remapping the same source state onto several target meshes.
+*/
+
+namespace Portage {
+
+/**
+ * @brief Mix raw bytes into a 64-bit FNV-1a hash.
+ *
+ * @param hash: the hash to update.
+ * @param data: the bytes to mix.
+ * @param size: their number.
+ */
+inline void hash_bytes(std::uint64_t& hash, void const* data, std::size_t size) {
+  auto const* bytes = static_cast<unsigned char const*>(data);
+  for (std::size_t i = 0; i < size; ++i) {
+    hash ^= bytes[i];
+    hash *= UINT64_C(1099511628211);
+  }
+}
+
+/// Initial value of FNV-1a hashes.
+constexpr std::uint64_t hash_seed = UINT64_C(14695981039346656037);
+
+/**
+ * @brief Compute the fingerprint of the reconstruction data of each cell.
+ *
+ * @tparam D: the spatial dimension.
+ * @tparam Mesh: the source mesh wrapper type.
+ * @param mesh: the source mesh.
+ * @param cell_num_mats: number of materials of each cell.
+ * @param cell_mat_ids: material ids in compact cell-centric form.
+ * @param cell_mat_volfracs: volume fractions in compact cell-centric form.
+ * @param cell_mat_centroids: centroids in compact cell-centric form.
+ * @return the fingerprint of each cell.
+ */
+template<int D, class Mesh>
+std::vector<std::uint64_t>
+reconstruction_fingerprint(Mesh const& mesh,
+                           std::vector<int> const& cell_num_mats,
+                           std::vector<int> const& cell_mat_ids,
+                           std::vector<double> const& cell_mat_volfracs,
+                           std::vector<Wonton::Point<D>> const& cell_mat_centroids) {
+
+  int const nb_cells = cell_num_mats.size();
+  bool const have_centroids = not cell_mat_centroids.empty();
+  std::vector<std::uint64_t> fingerprint(nb_cells, hash_seed);
+  std::vector<int> offsets(nb_cells, 0);
+
+  for (int c = 1; c < nb_cells; ++c)
+    offsets[c] = offsets[c - 1] + cell_num_mats[c - 1];
+
+  Portage::for_each(Portage::make_counting_iterator(0),
+                    Portage::make_counting_iterator(nb_cells),
+                    [&](int c) {
+    std::uint64_t hash = hash_seed;
+    std::vector<Wonton::Point<D>> coords;
+    mesh.cell_get_coordinates(c, &coords);
+    for (auto const& p : coords)
+      for (int d = 0; d < D; ++d) {
+        double const x = p[d];
+        hash_bytes(hash, &x, sizeof(double));
+      }
+
+    int const nb_mats = cell_num_mats[c];
+    hash_bytes(hash, &nb_mats, sizeof(int));
+    for (int i = offsets[c]; i < offsets[c] + nb_mats; ++i) {
+      hash_bytes(hash, &(cell_mat_ids[i]), sizeof(int));
+      hash_bytes(hash, &(cell_mat_volfracs[i]), sizeof(double));
+      if (have_centroids)
+        for (int d = 0; d < D; ++d) {
+          double const x = cell_mat_centroids[i][d];
+          hash_bytes(hash, &x, sizeof(double));
+        }
+    }
+    fingerprint[c] = hash;
+  });
+
+  return fingerprint;
+}
+
+/**
+ * @struct InterfaceReconstruction
+ * @brief An interface reconstruction along with the fingerprint of its data.
+ *
+ * It can be retrieved from a driver once materials were intersected, and
+ * handed to another driver with the same source mesh and state which then
+ * reuses it instead of reconstructing again if the data did not change.
+ *
+ * @tparam Reconstructor: the interface reconstructor driver type.
+ */
+template<class Reconstructor>
+struct InterfaceReconstruction {
+  std::shared_ptr<Reconstructor> reconstructor;
+  std::vector<std::uint64_t> fingerprint;   // of each cell
+  std::uint64_t options = hash_seed;        // fingerprint of the reconstructor options
+
+  /**
+   * @brief Count cells whose data differ from the reconstructed ones.
+   *
+   * @param cells: fingerprint of each cell.
+   * @param settings: fingerprint of the reconstructor options.
+   * @return the number of changed cells, all cells (at least one)
+   *         if nothing was reconstructed yet or if options changed.
+   */
+  int count_changed(std::vector<std::uint64_t> const& cells,
+                    std::uint64_t settings) const {
+    int const nb_cells = cells.size();
+    if (not reconstructor or settings != options or fingerprint.size() != cells.size())
+      return std::max(nb_cells, 1);
+
+    int changed = 0;
+    for (int c = 0; c < nb_cells; ++c)
+      if (cells[c] != fingerprint[c])
+        changed++;
+    return changed;
+  }
+};
+
+}  // namespace Portage
+
+#endif  // PORTAGE_DRIVER_RECONSTRUCTION_CACHE_H_
@@ -0,0 +1,185 @@
+/*
+This file is part of the Ristra portage project.
+Please see the license file at the root of this repository, or at:
+    https://github.com/laristra/portage/blob/master/LICENSE
+*/
+
+#ifndef PORTAGE_DRIVER_REMAP_COST_H_
+#define PORTAGE_DRIVER_REMAP_COST_H_
+
+#include <chrono>
+#include <type_traits>
+#include <vector>
+
+#include "portage/support/portage.h"
+
+/*!
+  @file remap_cost.h
+  @brief Per-target entity cost of the intersection phase of a remap.
+
+  Costs are stored as regular fields of the target entities so that
+  they can be written to the target state and visualized to locate
+  where the remap cost concentrates (material interfaces, degenerate
+  cells, etc.), or used as weights for cost-aware repartitioning.
+*/
+
+namespace Portage {
+
+using Wonton::Weights_t;
+
+/**
+ * @struct RemapCost
+ * @brief Per-target entity costs accumulated over intersections.
+ */
+struct RemapCost {
+  std::vector<double> time;      // seconds spent in the intersector
+  std::vector<double> clips;     // convex clips of a target piece by a source polytope
+  std::vector<double> matpolys;  // source material polytopes intersected
+
+  /**
+   * @brief Reset costs.
+   *
+   * @param nb_entities: number of owned and ghost target entities,
+   *                     costs of ghost entities being left at zero.
+   */
+  void reset(int nb_entities) {
+    time.assign(nb_entities, 0.);
+    clips.assign(nb_entities, 0.);
+    matpolys.assign(nb_entities, 0.);
+  }
+
+  /// Whether costs are being recorded.
+  bool enabled() const { return not time.empty(); }
+};
+
+// Intersectors which split target entities report the number of pieces
+template <class Intersect>
+auto num_target_pieces(Intersect const& intersect, int entity, int)
+  -> decltype(intersect.num_target_pieces(entity)) {
+  return intersect.num_target_pieces(entity);
+}
+
+// Other intersectors clip target entities as a whole
+template <class Intersect>
+int num_target_pieces(Intersect const& /* intersect */, int /* entity */, long) {
+  return 1;
+}
+
+/**
+ * @brief Number of convex pieces an intersector clips a target entity as.
+ *
+ * Intersectors may report it with a num_target_pieces(entity) member,
+ * otherwise target entities are assumed to be clipped as a whole.
+ *
+ * @param intersect: the intersector.
+ * @param entity: the target entity.
+ * @return the number of pieces.
+ */
+template <class Intersect>
+int num_target_pieces(Intersect const& intersect, int entity) {
+  return num_target_pieces(intersect, entity, 0);
+}
+
+/**
+ * @brief Number of convex pieces of each target entity, computed in
+ *        parallel once for all the intersections of a remap.
+ *
+ * @param intersect: the intersector.
+ * @param nb_entities: number of owned target entities.
+ * @return the number of pieces of each target entity.
+ */
+template <class Intersect>
+std::vector<int> target_pieces(Intersect const& intersect, int nb_entities) {
+  std::vector<int> pieces(nb_entities);
+  Portage::for_each(Portage::make_counting_iterator(0),
+                    Portage::make_counting_iterator(nb_entities),
+                    [&](int t) { pieces[t] = num_target_pieces(intersect, t); });
+  return pieces;
+}
+
+/// Source entities intersected as a single polytope each
+struct Whole_Sources {
+  int operator()(int /* source */) const { return 1; }
+};
+
+/**
+ * @class Timed_Intersect
+ * @brief Intersector adaptor which records the time spent on each
+ *        target entity and the clips it required.
+ *
+ * Each target entity is processed by a single thread so that its
+ * costs can be accumulated without synchronization.
+ *
+ * @tparam Intersect: the intersector type.
+ * @tparam Polytopes: number of source material polytopes of a source
+ *         entity, or Whole_Sources when intersecting meshes.
+ */
+template <class Intersect, class Polytopes = Whole_Sources>
+class Timed_Intersect {
+public:
+  /**
+   * @brief Create the adaptor.
+   *
+   * @param intersect: the actual intersector.
+   * @param cost: per-target entity costs to increment.
+   * @param pieces: number of convex pieces of each target entity.
+   * @param polytopes: number of polytopes of each source entity.
+   */
+  Timed_Intersect(Intersect const& intersect, RemapCost& cost,
+                  std::vector<int> const& pieces,
+                  Polytopes const& polytopes = Polytopes())
+    : intersect_(intersect), cost_(cost), pieces_(pieces),
+      polytopes_(polytopes) {}
+
+  /**
+   * @brief Intersect a target entity with its candidates.
+   *
+   * @param entity: the target entity.
+   * @param candidates: its candidate source entities.
+   * @return moments of intersection.
+   */
+  std::vector<Weights_t> operator()(int entity,
+                                    std::vector<int> const& candidates) const {
+    auto const tic = std::chrono::high_resolution_clock::now();
+    auto weights = intersect_(entity, candidates);
+    std::chrono::duration<double> const elapsed =
+      std::chrono::high_resolution_clock::now() - tic;
+    cost_.time[entity] += elapsed.count();
+
+    int nb_polys = 0;
+    for (int const& s : candidates)
+      nb_polys += polytopes_(s);
+
+    cost_.clips[entity] += nb_polys * pieces_[entity];
+    if (not std::is_same<Polytopes, Whole_Sources>::value)
+      cost_.matpolys[entity] += nb_polys;
+    return weights;
+  }
+
+private:
+  Intersect const& intersect_;
+  RemapCost& cost_;
+  std::vector<int> const& pieces_;
+  Polytopes polytopes_;
+};
+
+/**
+ * @brief Create a timed intersector, deducing its types.
+ *
+ * @param intersect: the actual intersector.
+ * @param cost: per-target entity costs to increment.
+ * @param pieces: number of convex pieces of each target entity.
+ * @param polytopes: number of polytopes of each source entity.
+ * @return the adaptor.
+ */
+template <class Intersect, class Polytopes = Whole_Sources>
+Timed_Intersect<Intersect, Polytopes>
+make_timed_intersect(Intersect const& intersect, RemapCost& cost,
+                     std::vector<int> const& pieces,
+                     Polytopes const& polytopes = Polytopes()) {
+  return Timed_Intersect<Intersect, Polytopes>(intersect, cost, pieces, polytopes);
+}
+
+}  // namespace Portage
+
+#endif  // PORTAGE_DRIVER_REMAP_COST_H_
@@ -6,8 +6,10 @@ Please see the license file at the root of this repository, or at:
 
 #ifdef HAVE_TANGRAM
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
+#include <vector>
 
 #include "gtest/gtest.h"
 #ifdef PORTAGE_ENABLE_MPI
@@ -205,4 +207,100 @@ TEST(CellDriver, 3D_2ndOrder) {
 }  // CellDriver_3D_2ndOrder
 
 
+
+// The driver search returns the candidates of the search functor,
+// sorted by source cell index
+
+template<int D>
+void check_sorted_candidates(std::shared_ptr<Jali::Mesh> sourceMesh,
+                             std::shared_ptr<Jali::Mesh> targetMesh) {
+  std::shared_ptr<Jali::State> sourceState = Jali::State::create(sourceMesh);
+  std::shared_ptr<Jali::State> targetState = Jali::State::create(targetMesh);
+
+  Wonton::Jali_Mesh_Wrapper sourceMeshWrapper(*sourceMesh);
+  Wonton::Jali_Mesh_Wrapper targetMeshWrapper(*targetMesh);
+  Wonton::Jali_State_Wrapper sourceStateWrapper(*sourceState);
+  Wonton::Jali_State_Wrapper targetStateWrapper(*targetState);
+
+  Portage::CoreDriver<D, Wonton::Entity_kind::CELL,
+                      Wonton::Jali_Mesh_Wrapper, Wonton::Jali_State_Wrapper>
+      d(sourceMeshWrapper, sourceStateWrapper,
+        targetMeshWrapper, targetStateWrapper);
+
+  auto candidates = d.template search<Portage::SearchKDTree>();
+
+  Portage::SearchKDTree<D, Wonton::Entity_kind::CELL,
+                        Wonton::Jali_Mesh_Wrapper, Wonton::Jali_Mesh_Wrapper>
+      search(sourceMeshWrapper, targetMeshWrapper);
+
+  int ntrgcells = targetMeshWrapper.num_owned_cells();
+  ASSERT_EQ(unsigned(ntrgcells), candidates.size());
+  for (int c = 0; c < ntrgcells; c++) {
+    std::vector<int> expected = search(c);
+    std::sort(expected.begin(), expected.end());
+
+    std::vector<int> const& found = candidates[c];
+    ASSERT_FALSE(found.empty());
+    ASSERT_TRUE(std::is_sorted(found.begin(), found.end()));
+    ASSERT_EQ(expected, found);
+  }
+}
+
+TEST(CellDriver, SortedCandidates) {
+  check_sorted_candidates<2>(
+    Jali::MeshFactory(MPI_COMM_WORLD)(0.0, 0.0, 1.0, 1.0, 7, 6),
+    Jali::MeshFactory(MPI_COMM_WORLD)(0.1, 0.0, 0.9, 1.0, 5, 9));
+
+  check_sorted_candidates<3>(
+    Jali::MeshFactory(MPI_COMM_WORLD)(0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 5, 4, 3),
+    Jali::MeshFactory(MPI_COMM_WORLD)(0.0, 0.1, 0.0, 1.0, 0.9, 1.0, 3, 4, 6));
+}  // CellDriver_SortedCandidates
+
+
+
+TEST(CellDriver, 3D_CostMap) {
+  std::shared_ptr<Jali::Mesh> sourceMesh;
+  std::shared_ptr<Jali::Mesh> targetMesh;
+  std::shared_ptr<Jali::State> sourceState;
+  std::shared_ptr<Jali::State> targetState;
+
+  sourceMesh = Jali::MeshFactory(MPI_COMM_WORLD)(0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 3, 3, 3);
+  targetMesh = Jali::MeshFactory(MPI_COMM_WORLD)(0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 4, 4, 4);
+
+  sourceState = Jali::State::create(sourceMesh);
+  targetState = Jali::State::create(targetMesh);
+
+  Wonton::Jali_Mesh_Wrapper sourceMeshWrapper(*sourceMesh);
+  Wonton::Jali_Mesh_Wrapper targetMeshWrapper(*targetMesh);
+  Wonton::Jali_State_Wrapper sourceStateWrapper(*sourceState);
+  Wonton::Jali_State_Wrapper targetStateWrapper(*targetState);
+
+  Portage::CoreDriver<3, Wonton::Entity_kind::CELL,
+                      Wonton::Jali_Mesh_Wrapper, Wonton::Jali_State_Wrapper>
+      d(sourceMeshWrapper, sourceStateWrapper,
+        targetMeshWrapper, targetStateWrapper);
+
+  // costs must be enabled before intersection to be written
+  ASSERT_THROW(d.write_cost_map(), std::runtime_error);
+
+  d.enable_cost_map();
+  auto candidates = d.search<Portage::SearchKDTree>();
+  auto srcwts = d.intersect_meshes<Portage::IntersectR3D>(candidates);
+  d.write_cost_map("cost");
+
+  double *time, *clips, *matpolys;
+  targetStateWrapper.mesh_get_data(Wonton::Entity_kind::CELL, "cost_time", &time);
+  targetStateWrapper.mesh_get_data(Wonton::Entity_kind::CELL, "cost_clips", &clips);
+  targetStateWrapper.mesh_get_data(Wonton::Entity_kind::CELL, "cost_matpolys", &matpolys);
+
+  // cubes are convex with planar faces: clipped once by every candidate
+  int ntrgcells = targetMeshWrapper.num_owned_cells();
+  for (int c = 0; c < ntrgcells; c++) {
+    ASSERT_GE(time[c], 0.0);
+    ASSERT_DOUBLE_EQ(clips[c], 1. * candidates[c].size());
+    ASSERT_DOUBLE_EQ(matpolys[c], 0.0);
+  }
+}  // CellDriver_3D_CostMap
+
+
 #endif  // ifdef HAVE_TANGRAM
@@ -7,6 +7,7 @@ Please see the license file at the root of this repository, or at:
 #include "portage/support/portage.h"
 #ifdef HAVE_TANGRAM
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
 
@@ -423,6 +424,163 @@ TEST(UberDriver, ThreeMat2D_MOF_MixedOrderRemap) {
 
 
 
+// Remap on a target mesh covering a strip of the source mesh so that
+// some mixed source cells are away from all candidates and are skipped
+// by the lazy interface reconstruction. The linear density of mat0
+// must still be recovered since the mixed neighbors of the candidates,
+// which are in the stencil of their gradients, are reconstructed.
+// The kept reconstruction is then reused by a second driver.
+
+TEST(UberDriver, ThreeMat2D_MOF_LazyReconstruction) {
+  std::shared_ptr<Jali::Mesh> sourceMesh =
+    Jali::MeshFactory(MPI_COMM_WORLD)(0.0, 0.0, 1.0, 1.0, 5, 5);
+  std::shared_ptr<Jali::Mesh> targetMesh =
+    Jali::MeshFactory(MPI_COMM_WORLD)(0.0, 0.0, 0.3, 1.0, 3, 5);
+
+  std::shared_ptr<Jali::State> sourceState = Jali::State::create(sourceMesh);
+  std::shared_ptr<Jali::State> targetState = Jali::State::create(targetMesh);
+
+  Wonton::Jali_Mesh_Wrapper sourceMeshWrapper(*sourceMesh);
+  Wonton::Jali_Mesh_Wrapper targetMeshWrapper(*targetMesh);
+  Wonton::Jali_State_Wrapper sourceStateWrapper(*sourceState);
+  Wonton::Jali_State_Wrapper targetStateWrapper(*targetState);
+
+  // same T-junction layout as ThreeMat2D_MOF_MixedOrderRemap
+  constexpr int nmats = 3;
+  std::string matnames[nmats] = {"mat0", "mat1", "mat2"};
+
+  Wonton::Point<2> matlo[nmats], mathi[nmats];
+  matlo[0] = Wonton::Point<2>(0.0, 0.0);
+  mathi[0] = Wonton::Point<2>(0.5, 1.0);
+  matlo[1] = Wonton::Point<2>(0.5, 0.0);
+  mathi[1] = Wonton::Point<2>(1.0, 0.5);
+  matlo[2] = Wonton::Point<2>(0.5, 0.5);
+  mathi[2] = Wonton::Point<2>(1.0, 1.0);
+
+  std::vector<int> matcells_src[nmats];
+  std::vector<double> matvf_src[nmats];
+  std::vector<Wonton::Point<2>> matcen_src[nmats];
+  std::vector<double> matrho_src[nmats];
+
+  int nsrccells = sourceMeshWrapper.num_entities(Wonton::Entity_kind::CELL,
+                                                 Wonton::Entity_type::ALL);
+  for (int c = 0; c < nsrccells; c++) {
+    std::vector<Wonton::Point<2>> ccoords;
+    sourceMeshWrapper.cell_get_coordinates(c, &ccoords);
+
+    double cellvol = sourceMeshWrapper.cell_volume(c);
+
+    Wonton::Point<2> cell_lo, cell_hi;
+    BOX_INTERSECT::bounding_box<2>(ccoords, &cell_lo, &cell_hi);
+
+    std::vector<double> xmoments;
+    for (int m = 0; m < nmats; m++) {
+      if (BOX_INTERSECT::intersect_boxes<2>(matlo[m], mathi[m],
+                                            cell_lo, cell_hi, &xmoments)) {
+        if (xmoments[0] > 1.0e-06) {  // non-trivial intersection
+          matcells_src[m].push_back(c);
+          matvf_src[m].push_back(xmoments[0]/cellvol);
+
+          Wonton::Point<2> mcen(xmoments[1]/xmoments[0],
+                                xmoments[2]/xmoments[0]);
+          matcen_src[m].push_back(mcen);
+          matrho_src[m].push_back((m+1)*(m+1)*(mcen[0]+mcen[1]));
+        }
+      }
+    }
+  }
+
+  for (int m = 0; m < nmats; m++) {
+    sourceStateWrapper.add_material(matnames[m], matcells_src[m]);
+    sourceStateWrapper.mat_add_celldata("mat_volfracs", m, &(matvf_src[m][0]));
+    sourceStateWrapper.mat_add_celldata("mat_centroids", m, &(matcen_src[m][0]));
+    sourceStateWrapper.mat_add_celldata("density", m, &(matrho_src[m][0]));
+  }
+
+  std::vector<int> dummymatcells;
+  for (int m = 0; m < nmats; m++)
+    targetStateWrapper.add_material(matnames[m], dummymatcells);
+
+  targetStateWrapper.mat_add_celldata<double>("mat_volfracs");
+  targetStateWrapper.mat_add_celldata<Wonton::Point<2>>("mat_centroids");
+  targetStateWrapper.mat_add_celldata<double>("density", 0.0);
+
+  Portage::UberDriver<2,
+                       Wonton::Jali_Mesh_Wrapper, Wonton::Jali_State_Wrapper,
+                       Wonton::Jali_Mesh_Wrapper, Wonton::Jali_State_Wrapper,
+                       Tangram::XMOF2D_Wrapper>
+      d(sourceMeshWrapper, sourceStateWrapper,
+        targetMeshWrapper, targetStateWrapper);
+
+  d.set_lazy_interface_reconstruction(true);
+  d.enable_reconstruction_cache(true);
+  d.compute_interpolation_weights<Portage::SearchKDTree, Portage::IntersectR2D>();
+
+  // mixed source cells away from the strip are not reconstructed
+  std::vector<int> cell_nmats(nsrccells, 0);
+  for (int m = 0; m < nmats; m++)
+    for (int c : matcells_src[m])
+      cell_nmats[c]++;
+  int const nmixed = std::count_if(cell_nmats.begin(), cell_nmats.end(),
+                                   [](int n) { return n > 1; });
+  ASSERT_GT(d.num_reconstructed_cells(), 0);
+  ASSERT_LT(d.num_reconstructed_cells(), nmixed);
+
+  // a second remap of the unchanged source state reuses the reconstruction
+  auto const reconstruction = d.interface_reconstruction();
+  ASSERT_TRUE(reconstruction.reconstructor != nullptr);
+
+  std::shared_ptr<Jali::State> targetState2 = Jali::State::create(targetMesh);
+  Wonton::Jali_State_Wrapper targetStateWrapper2(*targetState2);
+  for (int m = 0; m < nmats; m++)
+    targetStateWrapper2.add_material(matnames[m], dummymatcells);
+  targetStateWrapper2.mat_add_celldata<double>("mat_volfracs");
+  targetStateWrapper2.mat_add_celldata<Wonton::Point<2>>("mat_centroids");
+
+  Portage::UberDriver<2,
+                       Wonton::Jali_Mesh_Wrapper, Wonton::Jali_State_Wrapper,
+                       Wonton::Jali_Mesh_Wrapper, Wonton::Jali_State_Wrapper,
+                       Tangram::XMOF2D_Wrapper>
+      d2(sourceMeshWrapper, sourceStateWrapper,
+         targetMeshWrapper, targetStateWrapper2);
+
+  d2.set_lazy_interface_reconstruction(true);
+  d2.set_interface_reconstruction(reconstruction);
+  d2.compute_interpolation_weights<Portage::SearchKDTree, Portage::IntersectR2D>();
+  ASSERT_EQ(reconstruction.reconstructor,
+            d2.interface_reconstruction().reconstructor);
+
+  double dblmax =  std::numeric_limits<double>::max();
+
+  d.interpolate<double,
+                Portage::Entity_kind::CELL,
+                Portage::Interpolate_2ndOrder>(
+                    "density", "density", 0.0, dblmax,
+                    Portage::Limiter_type::NOLIMITER,
+                    Portage::Boundary_Limiter_type::BND_NOLIMITER);
+
+  // the target strip only contains mat0 with density x+y
+  std::vector<int> matcells;
+  targetStateWrapper.mat_get_cells(0, &matcells);
+  int const ntrgcells = targetMeshWrapper.num_entities(Wonton::Entity_kind::CELL,
+                                                       Wonton::Entity_type::ALL);
+  ASSERT_EQ(ntrgcells, static_cast<int>(matcells.size()));
+
+  double const *density_remap;
+  targetStateWrapper.mat_get_celldata("density", 0, &density_remap);
+
+  for (int ic = 0; ic < ntrgcells; ic++) {
+    Wonton::Point<2> centroid;
+    targetMeshWrapper.cell_centroid(matcells[ic], &centroid);
+    ASSERT_NEAR(centroid[0] + centroid[1], density_remap[ic], 1.0e-10);
+  }
+
+  for (int m = 1; m < nmats; m++)
+    ASSERT_EQ(0, targetStateWrapper.mat_get_num_cells(m));
+
+}  // ThreeMat2D_MOF_LazyReconstruction
+
+
 TEST(UberDriver, ThreeMat3D_MOF_MixedOrderRemap) {
   // Source and target meshes
   std::shared_ptr<Jali::Mesh> sourceMesh;
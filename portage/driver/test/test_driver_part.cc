@@ -357,6 +357,159 @@ TEST_F(PartOrderOneTest, GlobalRemapComparison) {
   }
 }
 
+/**
+ * verify that a batch of parts tags cells with their part, drops
+ * candidates from other parts, and detects the same mismatch with a
+ * single reduction as each part pair does on its own.
+ */
+TEST_F(PartOrderOneTest, PartBatch) {
+
+  using PartBatch = Portage::PartBatch<2, Wonton::Jali_Mesh_Wrapper,
+                                          Wonton::Jali_State_Wrapper>;
+
+  std::vector<std::vector<int>> sources(source_cells, source_cells + nb_parts);
+  std::vector<std::vector<int>> targets(target_cells, target_cells + nb_parts);
+
+  // move one target cell to the other part to create a mismatch
+  targets[1].push_back(targets[0].back());
+  targets[0].pop_back();
+
+  PartBatch batch(source_mesh_wrapper, source_state_wrapper,
+                  target_mesh_wrapper, target_state_wrapper,
+                  sources, targets, nullptr);
+  ASSERT_EQ(nb_parts, batch.size());
+
+  for (int i = 0; i < nb_parts; ++i) {
+    for (auto const& s : sources[i])
+      ASSERT_EQ(i, batch.source_tag(s));
+    for (auto const& t : targets[i])
+      ASSERT_EQ(i, batch.target_tag(t));
+  }
+
+  Remapper remapper(source_mesh_wrapper, source_state_wrapper,
+                    target_mesh_wrapper, target_state_wrapper);
+
+  auto candidates = remapper.search<Portage::SearchKDTree>();
+  auto filtered = candidates;
+  batch.filter_candidates(filtered);
+
+  for (int t = 0; t < nb_target_cells; ++t) {
+    int const part = batch.target_tag(t);
+    std::vector<int> expected;
+    for (auto const& s : candidates[t])
+      if (batch.source_tag(s) == part)
+        expected.push_back(s);
+    ASSERT_EQ(expected, filtered[t]);
+  }
+
+  // same mismatch as standalone pairs on the full weights
+  auto weights = remapper.intersect_meshes<Portage::IntersectR2D>(candidates);
+  bool const batch_mismatch = batch.check_mismatch(weights);
+  ASSERT_TRUE(batch_mismatch);
+
+  for (int i = 0; i < nb_parts; ++i) {
+    PartPair pair(source_mesh_wrapper, source_state_wrapper,
+                  target_mesh_wrapper, target_state_wrapper,
+                  sources[i], targets[i], nullptr);
+    pair.check_mismatch(weights);
+    ASSERT_EQ(pair.has_mismatch(), batch[i].has_mismatch());
+  }
+
+  // a cell cannot belong to several parts
+  std::vector<std::vector<int>> overlapping = { sources[0], sources[0] };
+  ASSERT_THROW(PartBatch(source_mesh_wrapper, source_state_wrapper,
+                         target_mesh_wrapper, target_state_wrapper,
+                         overlapping, targets, nullptr),
+               std::invalid_argument);
+}
+
+/**
+ * verify that weights filtered once per pair with build_part_weights
+ * are used for all fields until they are rebuilt or cleared, and give
+ * the same remap as weights filtered for each field.
+ */
+TEST_F(PartOrderOneTest, StoredPartWeights) {
+
+  Remapper remapper(source_mesh_wrapper, source_state_wrapper,
+                    target_mesh_wrapper, target_state_wrapper);
+
+  double* original = nullptr;
+  double* remapped = nullptr;
+
+  // assign a piecewise constant field on source mesh
+  source_state_wrapper.mesh_get_data(CELL, "density", &original);
+  for (int c = 0; c < nb_source_cells; c++) {
+    auto centroid = source_mesh->cell_centroid(c);
+    original[c] = (centroid[0] < 0.40 ? 30. : 100.);
+  }
+
+  auto candidates = remapper.search<Portage::SearchKDTree>();
+  auto weights = remapper.intersect_meshes<Portage::IntersectR2D>(candidates);
+
+  for (int i = 0; i < 2; ++i) {
+    auto& part = parts[i];
+    ASSERT_FALSE(part.has_part_weights());
+
+    // stored weights match the ones filtered on the fly
+    std::vector<std::vector<Wonton::Weights_t>> filtered;
+    part.filter_weights(weights, &filtered);
+    part.build_part_weights(weights);
+    ASSERT_TRUE(part.has_part_weights());
+
+    auto const& stored = part.part_weights();
+    ASSERT_EQ(unsigned(part.target().size()), stored.size());
+    for (int j = 0; j < part.target().size(); ++j) {
+      ASSERT_EQ(filtered[j].size(), stored[j].size());
+      for (unsigned k = 0; k < stored[j].size(); ++k) {
+        ASSERT_TRUE(part.source().contains(stored[j][k].entityID));
+        ASSERT_EQ(filtered[j][k].entityID, stored[j][k].entityID);
+      }
+    }
+
+    remapper.interpolate_mesh_var<double, Portage::Interpolate_1stOrder>(
+      "density", "density", weights, &part
+    );
+  }
+
+  target_state_wrapper.mesh_get_data(CELL, "density", &remapped);
+  for (int c = 0; c < nb_target_cells; ++c) {
+    auto centroid = target_mesh->cell_centroid(c);
+    ASSERT_NEAR(remapped[c], (centroid[0] < 0.40 ? 30. : 100.), epsilon);
+  }
+
+  // recompute weights in place: stored ones are used until rebuilt
+  auto const previous = weights;
+  for (auto& list : weights)
+    list.clear();
+
+  for (int i = 0; i < 2; ++i) {
+    remapper.interpolate_mesh_var<double, Portage::Interpolate_1stOrder>(
+      "density", "density", weights, &(parts[i])
+    );
+  }
+  for (int c = 0; c < nb_target_cells; ++c) {
+    auto centroid = target_mesh->cell_centroid(c);
+    ASSERT_NEAR(remapped[c], (centroid[0] < 0.40 ? 30. : 100.), epsilon);
+  }
+
+  for (int i = 0; i < 2; ++i) {
+    parts[i].build_part_weights(weights);
+    for (auto const& list : parts[i].part_weights())
+      ASSERT_TRUE(list.empty());
+
+    // once cleared, the supplied weights are filtered again
+    parts[i].clear_part_weights();
+    ASSERT_FALSE(parts[i].has_part_weights());
+    remapper.interpolate_mesh_var<double, Portage::Interpolate_1stOrder>(
+      "density", "density", previous, &(parts[i])
+    );
+  }
+  for (int c = 0; c < nb_target_cells; ++c) {
+    auto centroid = target_mesh->cell_centroid(c);
+    ASSERT_NEAR(remapped[c], (centroid[0] < 0.40 ? 30. : 100.), epsilon);
+  }
+}
+
 
 /**
  * verify that second-order part-by-part remap
@@ -0,0 +1,185 @@
+/*
+This file is part of the Ristra portage project.
+Please see the license file at the root of this repository, or at:
+    https://github.com/laristra/portage/blob/master/LICENSE
+*/
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "mpi.h"
+
+#include "wonton/mesh/jali/jali_mesh_wrapper.h"
+#include "wonton/state/jali/jali_state_wrapper.h"
+#include "wonton/support/Point.h"
+#include "Mesh.hh"
+#include "MeshFactory.hh"
+#include "JaliState.h"
+
+#include "portage/driver/momentum_remap.h"
+#include "portage/support/portage.h"
+
+namespace {
+
+using Remap = Portage::MomentumRemap<2, Wonton::Jali_Mesh_Wrapper>;
+
+double density(Wonton::Point<2> const& x) { return 1. + x[0] + x[0] * x[1]; }
+
+// Set masses on corners (SGH) or cells (CCH) from the density, and
+// velocities on nodes or cells, including ghost entities.
+template<class Velocity>
+void init(Remap const& remapper, Wonton::Jali_Mesh_Wrapper const& mesh,
+          Velocity const& velocity,
+          std::vector<double>& mass, std::vector<double> u[2]) {
+
+  Wonton::Point<2> x;
+  if (remapper.mass_kind() == Portage::Entity_kind::CORNER) {
+    Remap::Corners const corners(mesh);
+    mass.resize(corners.num_corners());
+    for (int cn = 0; cn < corners.num_corners(); cn++)
+      mass[cn] = corners.volume(cn) * density(corners.centroid(cn));
+
+    int const nb_nodes = mesh.num_entities(Portage::Entity_kind::NODE,
+                                           Portage::Entity_type::ALL);
+    u[0].resize(nb_nodes);
+    u[1].resize(nb_nodes);
+    for (int n = 0; n < nb_nodes; n++) {
+      mesh.node_get_coordinates(n, &x);
+      u[0][n] = velocity(x)[0];
+      u[1][n] = velocity(x)[1];
+    }
+  } else {
+    int const nb_cells = mesh.num_entities(Portage::Entity_kind::CELL,
+                                           Portage::Entity_type::ALL);
+    mass.resize(nb_cells);
+    u[0].resize(nb_cells);
+    u[1].resize(nb_cells);
+    for (int c = 0; c < nb_cells; c++) {
+      mesh.cell_centroid(c, &x);
+      mass[c] = mesh.cell_volume(c) * density(x);
+      u[0][c] = velocity(x)[0];
+      u[1][c] = velocity(x)[1];
+    }
+  }
+}
+
+// Remap mass and velocity between two meshes of the unit square held by
+// each rank, and return the source and target diagnostics.
+template<class Velocity>
+std::array<Remap::Diagnostics, 2> remap(Portage::Momentum_remap_method method,
+                                        Velocity const& velocity) {
+  Jali::MeshFactory factory(MPI_COMM_SELF);
+  factory.included_entities(Jali::Entity_kind::ALL_KIND);
+  auto source_mesh = factory(0.0, 0.0, 1.0, 1.0, 6, 5);
+  auto target_mesh = factory(0.0, 0.0, 1.0, 1.0, 8, 9);
+
+  auto source_state = Jali::State::create(source_mesh);
+  auto target_state = Jali::State::create(target_mesh);
+
+  Wonton::Jali_Mesh_Wrapper source_mesh_wrapper(*source_mesh);
+  Wonton::Jali_Mesh_Wrapper target_mesh_wrapper(*target_mesh);
+  Wonton::Jali_State_Wrapper source_state_wrapper(*source_state);
+  Wonton::Jali_State_Wrapper target_state_wrapper(*target_state);
+
+  Remap const remapper(method);
+
+  std::vector<double> mass_src, u_src[2];
+  init(remapper, source_mesh_wrapper, velocity, mass_src, u_src);
+
+  source_state_wrapper.mesh_add_data(remapper.mass_kind(), "mass", mass_src.data());
+  source_state_wrapper.mesh_add_data(remapper.velocity_kind(), "velocity_x", u_src[0].data());
+  source_state_wrapper.mesh_add_data(remapper.velocity_kind(), "velocity_y", u_src[1].data());
+
+  target_state_wrapper.mesh_add_data<double>(remapper.mass_kind(), "mass", 0.0);
+  target_state_wrapper.mesh_add_data<double>(remapper.velocity_kind(), "velocity_x", 0.0);
+  target_state_wrapper.mesh_add_data<double>(remapper.velocity_kind(), "velocity_y", 0.0);
+
+  remapper.remap(source_mesh_wrapper, source_state_wrapper,
+                 target_mesh_wrapper, target_state_wrapper,
+                 Portage::BARTH_JESPERSEN);
+
+  double const* mass_trg;
+  double const* u_trg[2];
+  target_state_wrapper.mesh_get_data(remapper.mass_kind(), "mass", &mass_trg);
+  target_state_wrapper.mesh_get_data(remapper.velocity_kind(), "velocity_x", &u_trg[0]);
+  target_state_wrapper.mesh_get_data(remapper.velocity_kind(), "velocity_y", &u_trg[1]);
+
+  return {{ remapper.diagnostics(source_mesh_wrapper, mass_src, u_src),
+            remapper.diagnostics(target_mesh_wrapper, mass_trg, u_trg) }};
+}
+
+// Total mass and momentum are conserved, and a uniform velocity is kept.
+void check_remap(Portage::Momentum_remap_method method) {
+
+  auto const varying = remap(method, [](Wonton::Point<2> const& x) {
+    return Wonton::Point<2>(1. + x[0], 2. - x[1] * x[1]);
+  });
+
+  ASSERT_NEAR(varying[0].mass, varying[1].mass, 1.e-12);
+  for (int i = 0; i < 2; i++)
+    ASSERT_NEAR(varying[0].momentum[i], varying[1].momentum[i], 1.e-12);
+
+  auto const uniform = remap(method, [](Wonton::Point<2> const&) {
+    return Wonton::Point<2>(2., -1.);
+  });
+
+  ASSERT_NEAR(uniform[0].mass, uniform[1].mass, 1.e-12);
+  for (int i = 0; i < 2; i++) {
+    ASSERT_NEAR(uniform[0].momentum[i], uniform[1].momentum[i], 1.e-12);
+    ASSERT_NEAR(uniform[0].umin[i], uniform[1].umin[i], 1.e-12);
+    ASSERT_NEAR(uniform[0].umax[i], uniform[1].umax[i], 1.e-12);
+  }
+}
+
+}  // namespace
+
+TEST(MomentumRemap, SGH_2D) {
+  check_remap(Portage::SGH);
+}
+
+TEST(MomentumRemap, CCH_2D) {
+  check_remap(Portage::CCH);
+}
+
+// Diagnostics of a distributed mesh match those of the whole mesh.
+TEST(MomentumRemap, Diagnostics) {
+  auto const velocity = [](Wonton::Point<2> const& x) {
+    return Wonton::Point<2>(x[0] * x[1], 1. - x[0]);
+  };
+
+  Jali::MeshFactory global_factory(MPI_COMM_WORLD);
+  Jali::MeshFactory local_factory(MPI_COMM_SELF);
+  global_factory.included_entities(Jali::Entity_kind::ALL_KIND);
+  local_factory.included_entities(Jali::Entity_kind::ALL_KIND);
+
+  auto global_mesh = global_factory(0.0, 0.0, 1.0, 1.0, 8, 8);
+  auto local_mesh = local_factory(0.0, 0.0, 1.0, 1.0, 8, 8);
+  Wonton::Jali_Mesh_Wrapper global_mesh_wrapper(*global_mesh);
+  Wonton::Jali_Mesh_Wrapper local_mesh_wrapper(*local_mesh);
+
+  Wonton::MPIExecutor_type executor(MPI_COMM_WORLD);
+
+  for (auto method : {Portage::SGH, Portage::CCH}) {
+    Remap const global_remapper(method, &executor);
+    Remap const local_remapper(method);
+
+    std::vector<double> global_mass, global_u[2];
+    std::vector<double> local_mass, local_u[2];
+    init(global_remapper, global_mesh_wrapper, velocity, global_mass, global_u);
+    init(local_remapper, local_mesh_wrapper, velocity, local_mass, local_u);
+
+    auto const global = global_remapper.diagnostics(global_mesh_wrapper,
+                                                    global_mass, global_u);
+    auto const local = local_remapper.diagnostics(local_mesh_wrapper,
+                                                  local_mass, local_u);
+
+    ASSERT_NEAR(local.mass, global.mass, 1.e-12);
+    for (int i = 0; i < 2; i++) {
+      ASSERT_NEAR(local.momentum[i], global.momentum[i], 1.e-12);
+      ASSERT_DOUBLE_EQ(local.umin[i], global.umin[i]);
+      ASSERT_DOUBLE_EQ(local.umax[i], global.umax[i]);
+    }
+  }
+}
@@ -0,0 +1,176 @@
+/*
+ * This file is part of the Ristra portage project.
+ * Please see the license file at the root of this repository, or at:
+ * https://github.com/laristra/portage/blob/master/LICENSE
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mpi.h"
+#include "gtest/gtest.h"
+
+#include "wonton/support/wonton.h"
+
+#include "portage/support/portage.h"
+#include "portage/driver/write_to_gmv.h"
+
+namespace {
+
+// A strip of two pure quads of a single material on each rank
+struct StripMesh {
+  explicit StripMesh(int rank) : rank_(rank) {}
+
+  int num_entities(Portage::Entity_kind kind, Portage::Entity_type) const {
+    return kind == Portage::Entity_kind::CELL ? 2 : 6;
+  }
+
+  Portage::Entity_type cell_get_type(int) const {
+    return Wonton::PARALLEL_OWNED;
+  }
+
+  void node_get_coordinates(int n, Wonton::Point<2>* p) const {
+    *p = Wonton::Point<2>(2 * rank_ + n % 3, n / 3);
+  }
+
+  void cell_get_nodes(int c, std::vector<int>* nodes) const {
+    *nodes = {c, c + 1, c + 4, c + 3};
+  }
+
+  void cell_get_faces_and_dirs(int, std::vector<int>*, std::vector<int>*) const {}
+  void face_get_nodes(int, std::vector<int>*) const {}
+
+  int rank_;
+};
+
+struct StripState {
+  explicit StripState(int rank) : values{10. * rank, 10. * rank + 1} {}
+
+  int num_materials() const { return 1; }
+  void cell_get_mats(int, std::vector<int>* mats) const { *mats = {0}; }
+  void mat_get_cells(int, std::vector<int>* cells) const { *cells = {0, 1}; }
+
+  Portage::Field_type field_type(Portage::Entity_kind, std::string const& name) const {
+    return name == "temperature" ? Portage::Field_type::MULTIMATERIAL_FIELD
+                                 : Portage::Field_type::UNKNOWN_TYPE_FIELD;
+  }
+
+  void mat_get_celldata(std::string const&, int, double const** data) const {
+    *data = values.data();
+  }
+
+  std::vector<double> values;
+};
+
+// never queried since all cells are pure
+struct NoReconstructor {
+  Tangram::CellMatPoly<2> const& cell_matpoly_data(int) const { return matpoly; }
+  Tangram::CellMatPoly<2> matpoly;
+};
+
+// Sequential reader of the sections of a binary GMV file
+struct Reader {
+  std::string word() {
+    std::string w(data.data() + pos, 8);
+    pos += 8;
+    return w;
+  }
+
+  template<typename T>
+  T value() {
+    T v;
+    std::memcpy(&v, data.data() + pos, sizeof(T));
+    pos += sizeof(T);
+    return v;
+  }
+
+  std::vector<char> data;
+  std::size_t pos = 0;
+};
+
+}  // namespace
+
+TEST(GMV_Binary, SharedFile) {
+  int rank = 0, nprocs = 1;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+
+  std::string const filename = "test_write_to_gmv.gmv";
+
+  // leave a longer file behind to check that it is truncated
+  if (rank == 0) {
+    std::ofstream old(filename, std::ios::binary);
+    old << std::string(1 << 16, 'x');
+  }
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  StripMesh mesh(rank);
+  StripState state(rank);
+  auto ir = std::make_shared<NoReconstructor>();
+  Wonton::MPIExecutor_type executor(MPI_COMM_WORLD);
+
+  Portage::write_to_gmv_binary<2>(mesh, state, ir, {"temperature"},
+                                  filename, &executor);
+
+  if (rank == 0) {
+    std::ifstream file(filename, std::ios::binary);
+    Reader in;
+    in.data.assign(std::istreambuf_iterator<char>(file),
+                   std::istreambuf_iterator<char>());
+
+    ASSERT_EQ("gmvinput", in.word());
+    ASSERT_EQ("ieeei4r8", in.word());
+    ASSERT_EQ("codename", in.word());
+    ASSERT_EQ("Portage ", in.word());
+    ASSERT_EQ("simdate ", in.word());
+    ASSERT_EQ("01/01/01", in.word());
+
+    // nodes of all ranks in rank order
+    ASSERT_EQ("nodev   ", in.word());
+    ASSERT_EQ(6 * nprocs, in.value<int>());
+    for (int r = 0; r < nprocs; r++)
+      for (int n = 0; n < 6; n++) {
+        ASSERT_EQ(2. * r + n % 3, in.value<double>());
+        ASSERT_EQ(double(n / 3), in.value<double>());
+        ASSERT_EQ(0., in.value<double>());
+      }
+
+    // cells refer to global one-based node indices
+    ASSERT_EQ("cells   ", in.word());
+    ASSERT_EQ(2 * nprocs, in.value<int>());
+    for (int r = 0; r < nprocs; r++)
+      for (int c = 0; c < 2; c++) {
+        ASSERT_EQ("general ", in.word());
+        ASSERT_EQ(1, in.value<int>());
+        ASSERT_EQ(4, in.value<int>());
+        for (int n : {c, c + 1, c + 4, c + 3})
+          ASSERT_EQ(6 * r + n + 1, in.value<int>());
+      }
+
+    ASSERT_EQ("material", in.word());
+    ASSERT_EQ(1, in.value<int>());
+    ASSERT_EQ(0, in.value<int>());
+    ASSERT_EQ("mat1    ", in.word());
+    for (int i = 0; i < 2 * nprocs; i++)
+      ASSERT_EQ(1, in.value<int>());
+
+    // names are truncated to 8 characters
+    ASSERT_EQ("variable", in.word());
+    ASSERT_EQ("temperat", in.word());
+    ASSERT_EQ(0, in.value<int>());
+    for (int r = 0; r < nprocs; r++)
+      for (int c = 0; c < 2; c++)
+        ASSERT_EQ(10. * r + c, in.value<double>());
+
+    ASSERT_EQ("endvars ", in.word());
+    ASSERT_EQ("endgmv  ", in.word());
+    ASSERT_EQ(in.data.size(), in.pos);
+
+    std::remove(filename.c_str());
+  }
+}
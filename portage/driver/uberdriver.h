@@ -377,6 +377,27 @@ class UberDriver {
     }
   }
 
+  /*!
+    @brief compute gradients of second order remaps only where the
+    range of neighbor values relative to the entity value exceeds a
+    threshold, and fall back to first order elsewhere
+
+    @param threshold     relative smoothness threshold
+  */
+  void set_adaptive_order_threshold(double threshold) {
+    for (Entity_kind onwhat : entity_kinds_) {
+      switch (onwhat) {
+        case CELL:
+          core_driver_serial_[CELL]->template set_adaptive_order_threshold<CELL>(threshold); break;
+        case NODE:
+          core_driver_serial_[NODE]->template set_adaptive_order_threshold<NODE>(threshold); break;
+        default:
+          std::cerr << "Cannot remap on " << to_string(onwhat) << "\n";
+          
+      }
+    }
+  }
+
   /*!
     @brief search for candidate source entities whose control volumes
      (cells, dual cells) overlap the control volumes of target cells
@@ -455,6 +476,53 @@ class UberDriver {
     core_driver_serial_[CELL]->set_interface_reconstructor_options(all_convex, tols);
   }
 
+  /*!
+    @brief restrict interface reconstruction to the mixed source cells
+    that are candidates of some target cell, along with their neighbors
+    @param lazy Whether to skip the other mixed cells.
+  */
+  void set_lazy_interface_reconstruction(bool lazy = true) {
+    core_driver_serial_[CELL]->set_lazy_interface_reconstruction(lazy);
+  }
+
+  /*!
+    @brief keep the interface reconstruction and reuse it in later
+    remaps as long as volume fractions, centroids and coordinates of
+    source cells are unchanged
+    @param enable Whether to keep and reuse the reconstruction.
+  */
+  void enable_reconstruction_cache(bool enable = true) {
+    core_driver_serial_[CELL]->enable_reconstruction_cache(enable);
+  }
+
+  /*!
+    @brief retrieve the kept interface reconstruction, e.g. to remap
+    the same source state onto another target mesh
+    @return the reconstruction and the fingerprint of its data
+  */
+  typename SerialDriverType::Reconstruction const& interface_reconstruction() {
+    return core_driver_serial_[CELL]->interface_reconstruction();
+  }
+
+  /*!
+    @brief number of mixed source cells handed to the interface
+    reconstructor, e.g. to check what lazy reconstruction skipped
+    @return the number of reconstructed cells on this rank
+  */
+  int num_reconstructed_cells() {
+    return core_driver_serial_[CELL]->num_reconstructed_cells();
+  }
+
+  /*!
+    @brief adopt an existing interface reconstruction of the same
+    source mesh and state
+    @param reconstruction The reconstruction to reuse.
+  */
+  void set_interface_reconstruction(
+    typename SerialDriverType::Reconstruction const& reconstruction) {
+    core_driver_serial_[CELL]->set_interface_reconstruction(reconstruction);
+  }
+
 #endif
 
   
@@ -8,12 +8,14 @@
 #define PORTAGE_INTERPOLATE_GRADIENT_H_
 
 #include <algorithm>
+#include <cmath>
 #include <stdexcept>
 #include <string>
 #include <vector>
 #include <iostream>
 
 #include "portage/support/portage.h"
+#include "portage/support/workspace.h"
 #include "portage/intersect/dummy_interface_reconstructor.h"
 #include "portage/driver/fix_mismatch.h"
 #include "portage/driver/parts.h"
@@ -291,6 +293,22 @@ namespace Portage {
       }
     }
 
+    /**
+     * @brief Set the smoothness threshold below which gradients are skipped.
+     *
+     * The gradient of a cell is only computed if the range of values among
+     * the cell and its neighbors exceeds the threshold relative to the cell
+     * value. Otherwise it is set to zero so that interpolation reduces to
+     * first order on that cell, without any least squares fit or limiting.
+     * With the default zero threshold, only gradients of locally constant
+     * fields are skipped, which are zero anyway.
+     *
+     * @param threshold: the relative smoothness threshold.
+     */
+    void set_smoothness_threshold(double threshold) {
+      smoothness_threshold_ = threshold;
+    }
+
     // @brief Implementation of Limited_Gradient functor for CELLs
     Vector<D> operator()(int cellid) {
 
@@ -317,8 +335,11 @@ namespace Portage {
         return grad;
       }
 
+      auto& workspace = thread_workspace<Workspace>();
+
       // Include cell where grad is needed as first element
-      std::vector<int> neighbors{cellid};
+      auto& neighbors = workspace.neighbors;
+      neighbors.assign(1, cellid);
 
       if (!cell_neighbors_.empty()) {
         neighbors.insert(std::end(neighbors),
@@ -326,8 +347,10 @@ namespace Portage {
                          std::end(cell_neighbors_[cellid]));
       }
 
-      std::vector<Point<D>> list_coords;
-      std::vector<double> list_values;
+      auto& list_coords = workspace.list_coords;
+      auto& list_values = workspace.list_values;
+      list_coords.clear();
+      list_values.clear();
 
       // Loop over cell where grad is needed and its neighboring cells
       for (auto&& neigh_global : neighbors) {
@@ -345,7 +368,8 @@ namespace Portage {
         // (neigh_local) is equal to global cellid (neigh_global).
         // nota bene: cell_index_in_material can return -1.
         if (neigh_local >= 0) {
-          std::vector<int> cell_mats;
+          auto& cell_mats = workspace.cell_mats;
+          cell_mats.clear();
           state_.cell_get_mats(neigh_global, &cell_mats);
           int const nb_mats = cell_mats.size();
 
@@ -403,19 +427,16 @@ namespace Portage {
         }
       }
 
-      grad = Wonton::ls_gradient<D, CoordSys>(list_coords, list_values);
+      // Min and max vals of function (cell centered vals) among neighbors
+      // and the cell itself, shared by the smoothness check and the limiter
+      /// @todo: must remove assumption the field is scalar
+      bool const check_smooth = smoothness_threshold_ > 0.;
+      double minval = 0.;
+      double maxval = 0.;
+      double cellcenval = 0.;
 
-      // Limit the gradient to enforce monotonicity preservation
-      if (apply_limiter) {
-
-        phi = 1.0;
-
-        // Min and max vals of function (cell centered vals) among neighbors
-        // and the cell itself
-        /// @todo: must remove assumption the field is scalar
-        double minval = list_values[0];
-        double maxval = list_values[0];
-        double cellcenval = list_values[0];
+      if ((apply_limiter || check_smooth) && not list_values.empty()) {
+        minval = maxval = cellcenval = list_values[0];
 
         // Find min and max values among all neighbors (exlude the first element
         // in nbrids because it corresponds to the cell itself, not a neighbor)
@@ -425,6 +446,20 @@ namespace Portage {
           maxval = std::max(list_values[i], maxval);
         }
 
+        // Skip gradient computation where the field is smooth enough
+        if (check_smooth && maxval - minval <= smoothness_threshold_ * std::abs(cellcenval)) {
+          grad.zero();
+          return grad;
+        }
+      }
+
+      grad = Wonton::ls_gradient<D, CoordSys>(list_coords, list_values);
+
+      // Limit the gradient to enforce monotonicity preservation
+      if (apply_limiter) {
+
+        phi = 1.0;
+
         /* Per page 278 of [Kucharik, M. and Shaskov, M, "Conservative
            Multi-material Remap for Staggered Multi-material Arbitrary
            Lagrangian-Eulerian Methods," Journal of Computational Physics,
@@ -445,7 +480,8 @@ namespace Portage {
         // Since the reconstruction is linear, this will occur at one of
         // the nodes of the cell. So find the values of the reconstructed
         // function at the nodes of the cell
-        std::vector<Point<D>> cellcoords;
+        auto& cellcoords = workspace.cellcoords;
+        cellcoords.clear();
         mesh_.cell_get_coordinates(cellid, &cellcoords);
 
         for (auto&& coord : cellcoords) {
@@ -462,6 +498,15 @@ namespace Portage {
     }
 
   private:
+    // scratch storage of each thread
+    struct Workspace {
+      std::vector<int> neighbors;
+      std::vector<int> cell_mats;
+      std::vector<Point<D>> list_coords;
+      std::vector<double> list_values;
+      std::vector<Point<D>> cellcoords;
+    };
+
     Mesh const& mesh_;
     State const& state_;
     double const* values_;
@@ -469,6 +514,7 @@ namespace Portage {
     Limiter_type limiter_type_ = DEFAULT_LIMITER;
     Boundary_Limiter_type boundary_limiter_type_ = DEFAULT_BND_LIMITER;
     Field_type field_type_ = Field_type::UNKNOWN_TYPE_FIELD;
+    double smoothness_threshold_ = 0.;
 
     int material_id_ = 0;
     std::vector<int> cell_ids_;
@@ -627,6 +673,16 @@ namespace Portage {
       state_.mesh_get_data(Entity_kind::NODE, variable_name_, &values_);
     }
 
+    /**
+     * @brief Set the smoothness threshold below which gradients are skipped.
+     *
+     * @param threshold: the relative smoothness threshold.
+     * @see Limited_Gradient<CELL>::set_smoothness_threshold
+     */
+    void set_smoothness_threshold(double threshold) {
+      smoothness_threshold_ = threshold;
+    }
+
     // @brief Limited gradient functor implementation for NODE
     Vector<D> operator()(int nodeid) {
 
@@ -646,8 +702,31 @@ namespace Portage {
       }
 
       auto const& neighbors = node_neighbors_[nodeid];
-      std::vector<Point<D>> node_coords(neighbors.size() + 1);
-      std::vector<double> node_values(neighbors.size() + 1);
+
+      // Min and max vals among neighbors, for the limiter and to skip
+      // gradient computation where the field is smooth enough
+      bool const check_smooth = smoothness_threshold_ > 0.;
+      double const nodeval = values_[nodeid];
+      double minval = nodeval;
+      double maxval = nodeval;
+      if (apply_limiter || check_smooth) {
+        for (auto const& current : neighbors) {
+          minval = std::min(values_[current], minval);
+          maxval = std::max(values_[current], maxval);
+        }
+      }
+
+      if (check_smooth &&
+          maxval - minval <= smoothness_threshold_ * std::abs(nodeval)) {
+        grad.zero();
+        return grad;
+      }
+
+      auto& workspace = thread_workspace<Workspace>();
+      auto& node_coords = workspace.node_coords;
+      auto& node_values = workspace.node_values;
+      node_coords.resize(neighbors.size() + 1);
+      node_values.resize(neighbors.size() + 1);
       mesh_.node_get_coordinates(nodeid, &(node_coords[0]));
       node_values[0] = values_[nodeid];
 
@@ -662,21 +741,14 @@ namespace Portage {
 
       if (apply_limiter) {
         // Min and max vals of function (cell centered vals) among neighbors
-        double minval = values_[nodeid];
-        double maxval = values_[nodeid];
-
-        for (auto const& val : node_values) {
-          minval = std::min(val, minval);
-          maxval = std::max(val, maxval);
-        }
+        // were computed above along with the smoothness indicator.
 
         // Find the min and max of the reconstructed function in the cell
         // Since the reconstruction is linear, this will occur at one of
         // the nodes of the cell. So find the values of the reconstructed
         // function at the nodes of the cell
-        double nodeval = values_[nodeid];
-
-        std::vector<Point<D>> dual_cell_coords;
+        auto& dual_cell_coords = workspace.dual_cell_coords;
+        dual_cell_coords.clear();
         mesh_.dual_cell_get_coordinates(nodeid, &dual_cell_coords);
 
         for (auto&& coord : dual_cell_coords) {
@@ -693,6 +765,13 @@ namespace Portage {
     }
 
   private:
+    // scratch storage of each thread
+    struct Workspace {
+      std::vector<Point<D>> node_coords;
+      std::vector<double> node_values;
+      std::vector<Point<D>> dual_cell_coords;
+    };
+
     Mesh const& mesh_;
     State const& state_;
     double const* values_;
@@ -700,6 +779,7 @@ namespace Portage {
     Limiter_type limiter_type_ = DEFAULT_LIMITER;
     Boundary_Limiter_type boundary_limiter_type_ = DEFAULT_BND_LIMITER;
     Field_type field_type_ = Field_type::UNKNOWN_TYPE_FIELD;
+    double smoothness_threshold_ = 0.;
 
     int material_id_ = 0;
     std::vector<int> cell_ids_;
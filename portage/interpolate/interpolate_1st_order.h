@@ -19,6 +19,7 @@ Please see the license file at the root of this repository, or at:
 #include "portage/intersect/dummy_interface_reconstructor.h"
 #include "portage/support/portage.h"
 #include "portage/driver/parts.h"
+#include "portage/interpolate/material_cell_index.h"
 
 // wonton includes
 #include "wonton/support/CoordinateSystem.h"
@@ -313,6 +314,12 @@ class Interpolate_1stOrder<
     matid_ = m;
   }  // set_material
 
+  /// Set the precomputed offsets of the current material in its data
+
+  void set_material_cell_index(MaterialCellIndex<D> const* index) {
+    material_cell_index_ = index;
+  }  // set_material_cell_index
+
   /// Set the variable name to be interpolated
 
 
@@ -377,10 +384,12 @@ class Interpolate_1stOrder<
     } else if (field_type_ == Field_type::MULTIMATERIAL_FIELD) {
       for (auto const& wt : sources_and_weights) {
         int srccell = wt.entityID;
-        std::vector<double> pair_weights = wt.weights;
+        std::vector<double> const& pair_weights = wt.weights;
         if (fabs(pair_weights[0]) < num_tols_.min_absolute_volume)
           continue;  // skip small intersections
-        int matcell = source_state_.cell_index_in_material(srccell, matid_);
+        int matcell = material_cell_index_
+                      ? material_cell_index_->offset(srccell)
+                      : source_state_.cell_index_in_material(srccell, matid_);
         val += source_vals_[matcell] * pair_weights[0];  // 1st order
         wtsum0 += pair_weights[0];
         nsummed++;
@@ -414,6 +423,7 @@ class Interpolate_1stOrder<
   T const * source_vals_;
   int matid_ = 0;
   Field_type field_type_ = Field_type::UNKNOWN_TYPE_FIELD;
+  MaterialCellIndex<D> const* material_cell_index_ = nullptr;
   NumericTolerances_t num_tols_;
 #ifdef HAVE_TANGRAM
   std::shared_ptr<InterfaceReconstructor> interface_reconstructor_;
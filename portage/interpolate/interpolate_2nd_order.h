@@ -16,7 +16,9 @@ Please see the license file at the root of this repository, or at:
 #include <vector>
 
 #include "portage/support/portage.h"
+#include "portage/support/workspace.h"
 #include "portage/interpolate/gradient.h"
+#include "portage/interpolate/material_cell_index.h"
 #include "portage/intersect/dummy_interface_reconstructor.h"
 #include "portage/driver/fix_mismatch.h"
 #include "portage/driver/parts.h"
@@ -319,6 +321,18 @@ namespace Portage {
      */
     void set_material(int m) { material_id_ = m; }
 
+    /**
+     * @brief Set the precomputed offsets and centroids of the current material.
+     *
+     * Without it, they are retrieved from the source state and the
+     * interface reconstructor for each source cell of each target cell.
+     *
+     * @param[in] index: the material cell index, or nullptr.
+     */
+    void set_material_cell_index(MaterialCellIndex<D> const* index) {
+      material_cell_index_ = index;
+    }
+
 
     /**
      * @brief Set the name of the interpolation variable and the gradient field.
@@ -376,79 +390,92 @@ namespace Portage {
       for (auto&& current : sources_and_weights) {
         // Get source cell and the intersection weights
         int src_cell = current.entityID;
-        auto intersect_weights = current.weights;
+        auto const& intersect_weights = current.weights;
         double intersect_volume = intersect_weights[0];
 
         if (fabs(intersect_volume) <= num_tols_.min_absolute_volume)
           continue;  // no intersection
 
-        // Obtain source cell centroid
-        Point<D> source_centroid;
-        if (field_type_ == Field_type::MESH_FIELD) {
-          source_mesh_.cell_centroid(src_cell, &source_centroid);
-        }
-#ifdef HAVE_TANGRAM
-        else if (field_type_ == Field_type::MULTIMATERIAL_FIELD) {
-          int const nb_mats = source_state_.cell_get_num_mats(src_cell);
-          std::vector<int> cellmats;
-          source_state_.cell_get_mats(src_cell, &cellmats);
+        // retrieve the correct source cell index
+        int const source_index = (field_type_ != Field_type::MULTIMATERIAL_FIELD
+          ? src_cell : material_cell_index_
+          ? material_cell_index_->offset(src_cell)
+          : source_state_.cell_index_in_material(src_cell, material_id_));
 
-          bool is_pure_cell =
-            (nb_mats == 0 or (nb_mats == 1 and cellmats[0] == material_id_));
+        Vector<D> const& gradient = gradient_field[source_index];
+        double value = source_values_[source_index];
+
+        // centroids are not needed where the gradient was skipped
+        bool has_gradient = false;
+        for (int k = 0; k < D; ++k)
+          has_gradient = has_gradient or gradient[k] != 0.;
 
-          if (is_pure_cell) {
+        if (has_gradient) {
+          // Obtain source cell centroid
+          Point<D> source_centroid;
+          if (field_type_ == Field_type::MESH_FIELD) {
             source_mesh_.cell_centroid(src_cell, &source_centroid);
-          } else /* multi-material cell */ {
-            assert(interface_reconstructor_ != nullptr);  // must be defined
-
-            auto pos = std::find(cellmats.begin(), cellmats.end(), material_id_);
-            bool found_material = (pos != cellmats.end());
-
-            if (found_material) /* mixed cell contains this material */ {
-
-              // obtain matpoly's for this material
-              auto const& cellmatpoly = interface_reconstructor_->cell_matpoly_data(src_cell);
-              auto matpolys = cellmatpoly.get_matpolys(material_id_);
-
-              for (int k = 0; k < D; k++)
-                source_centroid[k] = 0;
-
-              /*
-               * compute centroid of all matpoly's by summing all the
-               * first order moments first, and then dividing by the
-               * total volume of all matpolys.
-               */
-              double mvol = 0.;
-              for (auto&& poly : matpolys) {
-                auto moments = poly.moments();
-                mvol += moments[0];
+          } else if (material_cell_index_) {
+            source_centroid = material_cell_index_->centroid(src_cell);
+          }
+#ifdef HAVE_TANGRAM
+          else if (field_type_ == Field_type::MULTIMATERIAL_FIELD) {
+            int const nb_mats = source_state_.cell_get_num_mats(src_cell);
+            auto& cellmats = thread_workspace<Workspace>().cellmats;
+            cellmats.clear();
+            source_state_.cell_get_mats(src_cell, &cellmats);
+
+            bool is_pure_cell =
+              (nb_mats == 0 or (nb_mats == 1 and cellmats[0] == material_id_));
+
+            if (is_pure_cell) {
+              source_mesh_.cell_centroid(src_cell, &source_centroid);
+            } else /* multi-material cell */ {
+              assert(interface_reconstructor_ != nullptr);  // must be defined
+
+              auto pos = std::find(cellmats.begin(), cellmats.end(), material_id_);
+              bool found_material = (pos != cellmats.end());
+
+              if (found_material) /* mixed cell contains this material */ {
+
+                // obtain matpoly's for this material
+                auto const& cellmatpoly = interface_reconstructor_->cell_matpoly_data(src_cell);
+                auto matpolys = cellmatpoly.get_matpolys(material_id_);
+
                 for (int k = 0; k < D; k++)
-                  source_centroid[k] += moments[k + 1];
-              }
+                  source_centroid[k] = 0;
+
+                /*
+                 * compute centroid of all matpoly's by summing all the
+                 * first order moments first, and then dividing by the
+                 * total volume of all matpolys.
+                 */
+                double mvol = 0.;
+                for (auto&& poly : matpolys) {
+                  auto moments = poly.moments();
+                  mvol += moments[0];
+                  for (int k = 0; k < D; k++)
+                    source_centroid[k] += moments[k + 1];
+                }
 
-              for (int k = 0; k < D; k++)
-                source_centroid[k] /= mvol;
+                for (int k = 0; k < D; k++)
+                  source_centroid[k] /= mvol;
+              }
             }
           }
-        }
 #endif
 
-        // compute intersection centroid
-        Point<D> intersect_centroid;
-        // first-moment / volume
-        for (int k = 0; k < D; ++k)
-          intersect_centroid[k] = intersect_weights[1 + k] / intersect_volume;
+          // compute intersection centroid
+          Point<D> intersect_centroid;
+          // first-moment / volume
+          for (int k = 0; k < D; ++k)
+            intersect_centroid[k] = intersect_weights[1 + k] / intersect_volume;
 
-        // retrieve the correct source cell index
-        int const source_index = (field_type_ == Field_type::MULTIMATERIAL_FIELD
-          ? source_state_.cell_index_in_material(src_cell, material_id_)
-          : src_cell);
-
-        Vector<D> gradient = gradient_field[source_index];
-        Vector<D> dr = intersect_centroid - source_centroid;
-        CoordSys::modify_line_element(dr, source_centroid);
+          Vector<D> dr = intersect_centroid - source_centroid;
+          CoordSys::modify_line_element(dr, source_centroid);
+          value += dot(gradient, dr);
+        }
 
-        double value = source_values_[source_index] + dot(gradient, dr);
         value *= intersect_volume;
         total_value += value;
         normalization += intersect_volume;
@@ -469,6 +496,11 @@ namespace Portage {
     constexpr static int order = 2;
 
   private:
+    // scratch storage of each thread
+    struct Workspace {
+      std::vector<int> cellmats;
+    };
+
     SourceMeshType const& source_mesh_;
     TargetMeshType const& target_mesh_;
     SourceStateType const& source_state_;
@@ -478,6 +510,7 @@ namespace Portage {
     int material_id_ = 0;
     Portage::vector<Wonton::Vector<D>> const* gradients_;
     Field_type field_type_ = Field_type::UNKNOWN_TYPE_FIELD;
+    MaterialCellIndex<D> const* material_cell_index_ = nullptr;
 #ifdef HAVE_TANGRAM
     std::shared_ptr<InterfaceReconstructor> interface_reconstructor_;
 #endif
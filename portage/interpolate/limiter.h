@@ -0,0 +1,213 @@
+/*
+This file is part of the Ristra portage project.
+Please see the license file at the root of this repository, or at:
+    https://github.com/laristra/portage/blob/master/LICENSE
+*/
+
+#ifndef PORTAGE_INTERPOLATE_LIMITER_H_
+#define PORTAGE_INTERPOLATE_LIMITER_H_
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include "wonton/support/Point.h"
+#include "wonton/support/Vector.h"
+
+#include "portage/support/portage.h"
+#include "portage/support/workspace.h"
+
+/*!
+  @file limiter.h
+  @brief Barth-Jespersen limiting of the gradients of several cell fields.
+
+  Limiting a gradient requires the range of values among a cell and its
+  neighbors, and the extrapolated values at the vertices of the cell.
+  The vertex offsets from the cell centroid only depend on the mesh, so
+  they are computed once here and shared by all limited fields instead
+  of being fetched again by each Limited_Gradient instance.
+*/
+
+namespace Portage {
+
+using Wonton::Point;
+using Wonton::Vector;
+
+/**
+ * @class Limiter
+ * @brief Barth-Jespersen limiter of cell-centered mesh field gradients.
+ *
+ * Gradients of K fields are limited in a single pass over the cells,
+ * either independently or coupled, in which case all fields share the
+ * most restrictive limiter factor of a cell. The coupled mode suits the
+ * components of a vector field such as velocity, whose direction would
+ * otherwise be altered by limiting each component separately.
+ *
+ * Only mesh fields are supported: material fields are reconstructed
+ * from material centroids which differ from the cell centroids.
+ *
+ * @tparam D: the spatial dimension.
+ * @tparam Mesh: the mesh wrapper type.
+ */
+template<int D, class Mesh>
+class Limiter {
+public:
+  /**
+   * @brief Cache neighbors and vertex offsets of every owned cell.
+   *
+   * @param mesh: the mesh wrapper.
+   */
+  explicit Limiter(Mesh const& mesh) : mesh_(mesh) {
+
+    int const nb_cells = mesh_.num_entities(Entity_kind::CELL,
+                                            Entity_type::PARALLEL_OWNED);
+    boundary_.resize(nb_cells);
+    std::vector<std::vector<int>> adjacent(nb_cells);
+    std::vector<std::vector<Point<D>>> coords(nb_cells);
+
+    Portage::for_each(mesh_.begin(Entity_kind::CELL, Entity_type::PARALLEL_OWNED),
+                      mesh_.end(Entity_kind::CELL, Entity_type::PARALLEL_OWNED),
+                      [&](int c) {
+      mesh_.cell_get_node_adj_cells(c, Entity_type::ALL, &(adjacent[c]));
+      mesh_.cell_get_coordinates(c, &(coords[c]));
+      boundary_[c] = mesh_.on_exterior_boundary(Entity_kind::CELL, c);
+    });
+
+    // store neighbors and vertex offsets contiguously
+    neighbor_offsets_.resize(nb_cells + 1, 0);
+    offsets_.resize(nb_cells + 1, 0);
+    for (int c = 0; c < nb_cells; ++c) {
+      neighbor_offsets_[c + 1] = neighbor_offsets_[c] + adjacent[c].size();
+      offsets_[c + 1] = offsets_[c] + coords[c].size();
+    }
+
+    neighbors_.resize(neighbor_offsets_[nb_cells]);
+    vertices_.resize(offsets_[nb_cells]);
+    Portage::for_each(mesh_.begin(Entity_kind::CELL, Entity_type::PARALLEL_OWNED),
+                      mesh_.end(Entity_kind::CELL, Entity_type::PARALLEL_OWNED),
+                      [&](int c) {
+      std::copy(adjacent[c].begin(), adjacent[c].end(),
+                neighbors_.begin() + neighbor_offsets_[c]);
+
+      Point<D> centroid;
+      mesh_.cell_centroid(c, &centroid);
+      int const start = offsets_[c];
+      int const nb_vertices = coords[c].size();
+      for (int i = 0; i < nb_vertices; ++i)
+        vertices_[start + i] = coords[c][i] - centroid;
+    });
+  }
+
+  /**
+   * @brief Limit the gradients of several fields.
+   *
+   * Owned cells come first in the mesh numbering, so gradients are
+   * indexed by owned cell. Values are indexed by mesh cell, ghosts
+   * included since they may be neighbors of owned cells: these are
+   * mesh fields and not material fields, whose data follow the
+   * material cell list instead.
+   *
+   * @tparam Gradients: the container of the gradients of a field.
+   * @param values: cell values of each field, on owned and ghost cells.
+   * @param gradients: unlimited gradients of each field, limited in place.
+   * @param limiter_type: the limiter to apply on interior cells.
+   * @param boundary_limiter_type: the limiter to apply on boundary cells.
+   * @param coupled: whether all fields share the limiter factor of a cell.
+   */
+  template<class Gradients>
+  void limit(std::vector<double const*> const& values,
+             std::vector<Gradients>& gradients,
+             Limiter_type limiter_type,
+             Boundary_Limiter_type boundary_limiter_type,
+             bool coupled = false) const {
+
+    int const nb_fields = values.size();
+    if (gradients.size() != values.size())
+      throw std::invalid_argument("limiter: mismatched number of fields");
+
+    int const nb_cells = boundary_.size();
+    for (auto const& field_gradients : gradients)
+      if (static_cast<int>(field_gradients.size()) < nb_cells)
+        throw std::invalid_argument("limiter: missing cell gradients");
+
+    Portage::for_each(mesh_.begin(Entity_kind::CELL, Entity_type::PARALLEL_OWNED),
+                      mesh_.end(Entity_kind::CELL, Entity_type::PARALLEL_OWNED),
+                      [&](int c) {
+      // zero gradients on the boundary if requested
+      if (boundary_[c] and boundary_limiter_type == BND_ZERO_GRADIENT) {
+        for (int k = 0; k < nb_fields; ++k)
+          gradients[k][c] = Vector<D>();
+        return;
+      }
+
+      bool const apply_limiter = limiter_type == BARTH_JESPERSEN and
+        (not boundary_[c] or boundary_limiter_type == BND_BARTH_JESPERSEN);
+
+      if (not apply_limiter)
+        return;
+
+      auto& workspace = thread_workspace<Workspace>();
+      auto& cellval = workspace.cellval;
+      auto& minval = workspace.minval;
+      auto& maxval = workspace.maxval;
+      auto& phi = workspace.phi;
+      auto& grad = workspace.grad;
+
+      // range of values among the cell and its neighbors for each field
+      cellval.resize(nb_fields);
+      minval.resize(nb_fields);
+      maxval.resize(nb_fields);
+      for (int k = 0; k < nb_fields; ++k)
+        cellval[k] = minval[k] = maxval[k] = values[k][c];
+
+      for (int j = neighbor_offsets_[c]; j < neighbor_offsets_[c + 1]; ++j)
+        for (int k = 0; k < nb_fields; ++k) {
+          int const n = neighbors_[j];
+          minval[k] = std::min(values[k][n], minval[k]);
+          maxval[k] = std::max(values[k][n], maxval[k]);
+        }
+
+      // the linear reconstruction reaches its extrema at the vertices
+      phi.assign(nb_fields, 1.);
+      grad.resize(nb_fields);
+      for (int k = 0; k < nb_fields; ++k)
+        grad[k] = gradients[k][c];
+
+      for (int i = offsets_[c]; i < offsets_[c + 1]; ++i) {
+        auto const& vec = vertices_[i];
+        for (int k = 0; k < nb_fields; ++k) {
+          double const diff = dot(grad[k], vec);
+          double const extremeval = (diff > 0.) ? maxval[k] : minval[k];
+          double const phi_new = (diff == 0. ? 1. : (extremeval - cellval[k]) / diff);
+          phi[k] = std::min(phi_new, phi[k]);
+        }
+      }
+
+      if (coupled) {
+        double const shared = *std::min_element(phi.begin(), phi.end());
+        std::fill(phi.begin(), phi.end(), shared);
+      }
+
+      for (int k = 0; k < nb_fields; ++k)
+        gradients[k][c] = phi[k] * grad[k];
+    });
+  }
+
+private:
+  // scratch storage of each thread, sized to the number of fields
+  struct Workspace {
+    std::vector<double> cellval, minval, maxval, phi;
+    std::vector<Vector<D>> grad;
+  };
+
+  Mesh const& mesh_;
+  std::vector<int> neighbor_offsets_;         // of the neighbors of each cell
+  std::vector<int> neighbors_;                // node-adjacent cells
+  std::vector<char> boundary_;                // whether cells are on the boundary
+  std::vector<int> offsets_;                  // of the vertices of each cell
+  std::vector<Vector<D>> vertices_;           // vertex offsets from the cell centroid
+};
+
+}  // namespace Portage
+
+#endif  // PORTAGE_INTERPOLATE_LIMITER_H_
@@ -0,0 +1,155 @@
+/*
+This file is part of the Ristra portage project.
+Please see the license file at the root of this repository, or at:
+    https://github.com/laristra/portage/blob/master/LICENSE
+*/
+
+#ifndef PORTAGE_INTERPOLATE_MATERIAL_CELL_INDEX_H_
+#define PORTAGE_INTERPOLATE_MATERIAL_CELL_INDEX_H_
+
+#include <vector>
+
+#include "wonton/support/Point.h"
+
+#include "portage/support/portage.h"
+
+/*!
+  @file material_cell_index.h
+  @brief Precomputed material cell data for multi-material interpolation.
+
+  Interpolating a material field requires, for each source cell of each
+  target cell, its offset in the material data and the centroid of the
+  material within it. Retrieving them requires to query the materials of
+  the cell and to sum the moments of its matpolys for mixed cells, which
+  would be done again for every target cell and every remapped variable.
+  They only depend on the interface reconstruction and are computed once
+  here so that interpolators only have to gather them.
+*/
+
+namespace Portage {
+
+/**
+ * @struct MaterialCellIndex
+ * @brief Offsets and centroids of the source cells of a material.
+ *
+ * @tparam D: the spatial dimension.
+ */
+template<int D>
+struct MaterialCellIndex {
+  std::vector<int> offsets;          // offset of each source cell in material data, or -1
+  std::vector<Wonton::Point<D>> centroids;   // material centroid of each material cell
+
+  /**
+   * @brief Retrieve the offset of a source cell in material data.
+   *
+   * @param c: the source cell.
+   * @return its offset, or -1 if it does not contain the material.
+   */
+  int offset(int c) const { return offsets[c]; }
+
+  /**
+   * @brief Retrieve the material centroid of a source cell.
+   *
+   * @param c: the source cell.
+   * @return its centroid: the cell centroid for pure cells, the
+   *         centroid of all matpolys of the material for mixed ones.
+   */
+  Wonton::Point<D> const& centroid(int c) const { return centroids[offsets[c]]; }
+};
+
+#ifdef HAVE_TANGRAM
+/**
+ * @brief Build the material cell index of every material.
+ *
+ * @tparam D: the spatial dimension.
+ * @tparam Mesh: the source mesh wrapper type.
+ * @tparam State: the source state wrapper type.
+ * @tparam InterfaceReconstructor: the interface reconstructor type.
+ * @param mesh: the source mesh.
+ * @param state: the source state.
+ * @param ir: the interface reconstructor, after reconstruction.
+ * @param reconstructed: whether each mixed cell was reconstructed,
+ *        empty if all of them were. Centroids of skipped cells are
+ *        set to the cell centroid and must not be used.
+ * @return the index of each material.
+ */
+template<int D, class Mesh, class State, class InterfaceReconstructor>
+std::vector<MaterialCellIndex<D>>
+build_material_cell_index(Mesh const& mesh, State const& state,
+                          InterfaceReconstructor const& ir,
+                          std::vector<char> const& reconstructed = {}) {
+
+  int const nb_cells = mesh.num_entities(Entity_kind::CELL, Entity_type::ALL);
+  int const nb_mats = state.num_materials();
+  std::vector<MaterialCellIndex<D>> index(nb_mats);
+
+  for (int m = 0; m < nb_mats; ++m) {
+    std::vector<int> cells;
+    state.mat_get_cells(m, &cells);
+
+    auto& current = index[m];
+    current.offsets.assign(nb_cells, -1);
+    current.centroids.resize(cells.size());
+
+    for (auto const& c : cells) {
+      int const offset = state.cell_index_in_material(c, m);
+      current.offsets[c] = offset;
+
+      bool const skipped = not reconstructed.empty() and not reconstructed[c];
+      if (skipped or state.cell_get_num_mats(c) == 1) {
+        mesh.cell_centroid(c, &(current.centroids[offset]));
+        continue;
+      }
+
+      // sum first-order moments of matpolys and divide by their volume
+      auto const& matpolys = ir.cell_matpoly_data(c).get_matpolys(m);
+      Wonton::Point<D> centroid;
+      double volume = 0.;
+      for (auto&& poly : matpolys) {
+        auto const moments = poly.moments();
+        volume += moments[0];
+        for (int k = 0; k < D; k++)
+          centroid[k] += moments[k + 1];
+      }
+
+      for (int k = 0; k < D; k++)
+        centroid[k] /= volume;
+
+      current.centroids[offset] = centroid;
+    }
+  }
+  return index;
+}
+#endif
+
+namespace detail {
+
+/// Pass the material cell index to interpolators that can use it.
+template<class Interpolator, int D>
+auto set_material_cell_index(Interpolator& interpolator,
+                             MaterialCellIndex<D> const* index, int)
+  -> decltype(interpolator.set_material_cell_index(index), void()) {
+  interpolator.set_material_cell_index(index);
+}
+
+/// Other interpolators keep querying the state themselves.
+template<class Interpolator, int D>
+void set_material_cell_index(Interpolator&, MaterialCellIndex<D> const*, long) {}
+
+}  // namespace detail
+
+/**
+ * @brief Pass the material cell index to an interpolator if supported.
+ *
+ * @param interpolator: the interpolator.
+ * @param index: the index of its current material.
+ */
+template<class Interpolator, int D>
+void set_material_cell_index(Interpolator& interpolator,
+                             MaterialCellIndex<D> const* index) {
+  detail::set_material_cell_index(interpolator, index, 0);
+}
+
+}  // namespace Portage
+
+#endif  // PORTAGE_INTERPOLATE_MATERIAL_CELL_INDEX_H_
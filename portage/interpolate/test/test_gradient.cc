@@ -5,6 +5,7 @@ Please see the license file at the root of this repository, or at:
 */
 
 
+#include <cmath>
 #include <iostream>
 
 #include "gtest/gtest.h"
@@ -139,6 +140,61 @@ TEST(Gradient, Fields_Cell_Ctr) {
   }
 }
 
+/// Test that gradients are skipped where cell centered fields are smooth
+
+TEST(Gradient, Smoothness_Threshold) {
+  // Create a 4 x 4 cell mesh
+  std::shared_ptr<Wonton::Simple_Mesh> mesh1 =
+      std::make_shared<Wonton::Simple_Mesh>(0.0, 0.0, 1.0, 1.0, 4, 4);
+  ASSERT_TRUE(mesh1 != nullptr);
+
+  Wonton::Simple_Mesh_Wrapper meshwrapper(*mesh1);
+  Wonton::Simple_State mystate(mesh1);
+  Wonton::Simple_State_Wrapper statewrapper(mystate);
+
+  const int nc1 = meshwrapper.num_owned_cells();
+
+  // step at x = 0.5 with a slight slope along y
+  std::vector<double> data(nc1);
+  for (int c = 0; c < nc1; c++) {
+    Wonton::Point<2> ccen;
+    meshwrapper.cell_centroid(c, &ccen);
+    data[c] = (ccen[0] < 0.5 ? 1.0 : 2.0) + 1.0e-4 * ccen[1];
+  }
+
+  mystate.add("cellvars", Portage::Entity_kind::CELL, &(data[0]));
+
+  Portage::Limited_Gradient<2, Portage::Entity_kind::CELL, Wonton::Simple_Mesh_Wrapper,
+                            Wonton::Simple_State_Wrapper>
+      gradcalc(meshwrapper, statewrapper, "cellvars",
+               Portage::NOLIMITER, Portage::BND_NOLIMITER);
+
+  gradcalc.set_smoothness_threshold(0.01);
+
+  for (int c = 0; c < nc1; c++) {
+    Wonton::Point<2> ccen;
+    meshwrapper.cell_centroid(c, &ccen);
+    Wonton::Vector<2> grad = gradcalc(c);
+
+    // only cells next to the step have a gradient
+    bool const near_step = std::abs(ccen[0] - 0.5) < 0.25;
+    if (near_step) {
+      ASSERT_GT(std::abs(grad[0]), 1.0);
+    } else {
+      ASSERT_DOUBLE_EQ(0.0, grad[0]);
+      ASSERT_DOUBLE_EQ(0.0, grad[1]);
+    }
+  }
+
+  // a zero threshold disables the check and keeps the slight slope
+  gradcalc.set_smoothness_threshold(0.);
+
+  for (int c = 0; c < nc1; c++) {
+    Wonton::Vector<2> grad = gradcalc(c);
+    ASSERT_NEAR(1.0e-4, grad[1], 1.0e-10);
+  }
+}
+
 // Test gradient computation with node centered fields
 
 TEST(Gradient, Fields_Node_Ctr) {
@@ -0,0 +1,170 @@
+/*
+This file is part of the Ristra portage project.
+Please see the license file at the root of this repository, or at:
+    https://github.com/laristra/portage/blob/master/LICENSE
+*/
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+// portage includes
+#include "portage/driver/coredriver.h"
+#include "portage/interpolate/gradient.h"
+#include "portage/interpolate/limiter.h"
+#include "portage/support/portage.h"
+
+// wonton includes
+#include "wonton/mesh/simple/simple_mesh.h"
+#include "wonton/mesh/simple/simple_mesh_wrapper.h"
+#include "wonton/state/simple/simple_state.h"
+#include "wonton/state/simple/simple_state_wrapper.h"
+#include "wonton/support/Point.h"
+#include "wonton/support/Vector.h"
+
+using Gradient = Portage::Limited_Gradient<2, Portage::Entity_kind::CELL,
+                                           Wonton::Simple_Mesh_Wrapper,
+                                           Wonton::Simple_State_Wrapper>;
+
+/// Test that limiting several fields at once matches Limited_Gradient
+
+TEST(Limiter, Multiple_Fields) {
+  // Create a 5 x 5 cell mesh
+  auto mesh = std::make_shared<Wonton::Simple_Mesh>(0.0, 0.0, 1.0, 1.0, 5, 5);
+  Wonton::Simple_Mesh_Wrapper meshwrapper(*mesh);
+  Wonton::Simple_State mystate(mesh);
+  Wonton::Simple_State_Wrapper statewrapper(mystate);
+
+  int const nb_cells = meshwrapper.num_owned_cells();
+
+  // quadratic field and step field
+  std::vector<double> data1(nb_cells), data2(nb_cells);
+  for (int c = 0; c < nb_cells; c++) {
+    Wonton::Point<2> ccen;
+    meshwrapper.cell_centroid(c, &ccen);
+    data1[c] = ccen[0] * ccen[0] + ccen[1] * ccen[1];
+    data2[c] = ccen[0] < 0.5 ? 1.0 : 2.0;
+  }
+
+  mystate.add("cellvars1", Portage::Entity_kind::CELL, &(data1[0]));
+  mystate.add("cellvars2", Portage::Entity_kind::CELL, &(data2[0]));
+
+  std::vector<std::string> const fields = { "cellvars1", "cellvars2" };
+  std::vector<double const*> values = { data1.data(), data2.data() };
+  std::vector<std::vector<Wonton::Vector<2>>> gradients(2);
+
+  for (int k = 0; k < 2; k++) {
+    Gradient gradcalc(meshwrapper, statewrapper, fields[k],
+                      Portage::NOLIMITER, Portage::BND_BARTH_JESPERSEN);
+    for (int c = 0; c < nb_cells; c++)
+      gradients[k].push_back(gradcalc(c));
+  }
+
+  Portage::Limiter<2, Wonton::Simple_Mesh_Wrapper> limiter(meshwrapper);
+  limiter.limit(values, gradients, Portage::BARTH_JESPERSEN,
+                Portage::BND_BARTH_JESPERSEN);
+
+  for (int k = 0; k < 2; k++) {
+    Gradient gradcalc(meshwrapper, statewrapper, fields[k],
+                      Portage::BARTH_JESPERSEN, Portage::BND_BARTH_JESPERSEN);
+    for (int c = 0; c < nb_cells; c++) {
+      Wonton::Vector<2> expected = gradcalc(c);
+      ASSERT_NEAR(expected[0], gradients[k][c][0], 1.0e-12);
+      ASSERT_NEAR(expected[1], gradients[k][c][1], 1.0e-12);
+    }
+  }
+}
+
+/// Test that coupled fields share the limiter factor of each cell
+
+TEST(Limiter, Coupled_Fields) {
+  // Create a 5 x 5 cell mesh
+  auto mesh = std::make_shared<Wonton::Simple_Mesh>(0.0, 0.0, 1.0, 1.0, 5, 5);
+  Wonton::Simple_Mesh_Wrapper meshwrapper(*mesh);
+
+  int const nb_cells = meshwrapper.num_owned_cells();
+
+  // components of a velocity field: linear along x, step along y
+  std::vector<double> u(nb_cells), v(nb_cells);
+  for (int c = 0; c < nb_cells; c++) {
+    Wonton::Point<2> ccen;
+    meshwrapper.cell_centroid(c, &ccen);
+    u[c] = ccen[0];
+    v[c] = ccen[1] < 0.5 ? 0.0 : 1.0;
+  }
+
+  // give both components the same gradient along x
+  std::vector<double const*> values = { u.data(), v.data() };
+  std::vector<std::vector<Wonton::Vector<2>>> independent(
+    2, std::vector<Wonton::Vector<2>>(nb_cells, Wonton::Vector<2>(1.0, 0.0)));
+  auto coupled = independent;
+
+  Portage::Limiter<2, Wonton::Simple_Mesh_Wrapper> limiter(meshwrapper);
+  limiter.limit(values, independent, Portage::BARTH_JESPERSEN,
+                Portage::BND_NOLIMITER);
+  limiter.limit(values, coupled, Portage::BARTH_JESPERSEN,
+                Portage::BND_NOLIMITER, true);
+
+  for (int c = 0; c < nb_cells; c++) {
+    if (meshwrapper.on_exterior_boundary(Portage::Entity_kind::CELL, c))
+      continue;
+
+    // the gradient of u is exact so it is left untouched when
+    // limited alone, the one of v is spurious and limited
+    ASSERT_NEAR(1.0, independent[0][c][0], 1.0e-12);
+
+    double const phi = coupled[1][c][0];
+    ASSERT_NEAR(independent[1][c][0], phi, 1.0e-12);
+    ASSERT_NEAR(phi, coupled[0][c][0], 1.0e-12);
+    ASSERT_LE(phi, 1.0);
+  }
+}
+
+/// Test that the driver limits several fields like it limits each of them
+
+TEST(Limiter, Driver_Gradients) {
+  // Create a 5 x 5 cell mesh
+  auto mesh = std::make_shared<Wonton::Simple_Mesh>(0.0, 0.0, 1.0, 1.0, 5, 5);
+  Wonton::Simple_Mesh_Wrapper meshwrapper(*mesh);
+  Wonton::Simple_State mystate(mesh);
+  Wonton::Simple_State_Wrapper statewrapper(mystate);
+
+  int const nb_cells = meshwrapper.num_owned_cells();
+
+  // quadratic field and step field
+  std::vector<double> data1(nb_cells), data2(nb_cells);
+  for (int c = 0; c < nb_cells; c++) {
+    Wonton::Point<2> ccen;
+    meshwrapper.cell_centroid(c, &ccen);
+    data1[c] = ccen[0] * ccen[0] + ccen[1] * ccen[1];
+    data2[c] = ccen[0] < 0.5 ? 1.0 : 2.0;
+  }
+
+  mystate.add("cellvars1", Portage::Entity_kind::CELL, &(data1[0]));
+  mystate.add("cellvars2", Portage::Entity_kind::CELL, &(data2[0]));
+
+  Portage::CoreDriver<2, Portage::Entity_kind::CELL,
+                      Wonton::Simple_Mesh_Wrapper,
+                      Wonton::Simple_State_Wrapper>
+      driver(meshwrapper, statewrapper, meshwrapper, statewrapper);
+
+  std::vector<std::string> const fields = { "cellvars1", "cellvars2" };
+  auto gradients = driver.compute_source_gradients(fields,
+                                                   Portage::BARTH_JESPERSEN,
+                                                   Portage::BND_ZERO_GRADIENT);
+  ASSERT_EQ(fields.size(), gradients.size());
+
+  for (int k = 0; k < 2; k++) {
+    auto expected = driver.compute_source_gradient(fields[k],
+                                                   Portage::BARTH_JESPERSEN,
+                                                   Portage::BND_ZERO_GRADIENT);
+    for (int c = 0; c < nb_cells; c++) {
+      Wonton::Vector<2> const grad = gradients[k][c];
+      Wonton::Vector<2> const reference = expected[c];
+      ASSERT_NEAR(reference[0], grad[0], 1.0e-12);
+      ASSERT_NEAR(reference[1], grad[1], 1.0e-12);
+    }
+  }
+}
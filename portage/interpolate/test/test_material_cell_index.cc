@@ -0,0 +1,121 @@
+/*
+This file is part of the Ristra portage project.
+Please see the license file at the root of this repository, or at:
+    https://github.com/laristra/portage/blob/master/LICENSE
+*/
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "wonton/mesh/simple/simple_mesh.h"
+#include "wonton/mesh/simple/simple_mesh_wrapper.h"
+#include "wonton/support/Point.h"
+
+#include "portage/interpolate/material_cell_index.h"
+#include "portage/support/portage.h"
+
+#ifdef HAVE_TANGRAM
+
+namespace {
+
+// Two materials on a 2x2 mesh: material 0 in cells 0, 1 and 2, and
+// material 1 in cells 3, 1 and 2, listed in this order so that material
+// offsets differ from cell indices. Cells 1 and 2 are mixed.
+struct MixedState {
+  int num_materials() const { return 2; }
+
+  void mat_get_cells(int m, std::vector<int>* cells) const {
+    *cells = mat_cells[m];
+  }
+
+  int cell_get_num_mats(int c) const { return (c == 1 or c == 2) ? 2 : 1; }
+
+  int cell_index_in_material(int c, int m) const {
+    auto const& cells = mat_cells[m];
+    auto const it = std::find(cells.begin(), cells.end(), c);
+    return it == cells.end() ? -1 : std::distance(cells.begin(), it);
+  }
+
+  std::vector<std::vector<int>> mat_cells = {{0, 1, 2}, {3, 1, 2}};
+};
+
+// Material polygon described by its moments only
+struct MomentsPoly {
+  std::vector<double> moments() const { return values; }
+  std::vector<double> values;
+};
+
+// polygon of a given volume and centroid
+MomentsPoly poly(double volume, double x, double y) {
+  return MomentsPoly{{volume, volume * x, volume * y}};
+}
+
+struct CellPolys {
+  std::vector<MomentsPoly> const& get_matpolys(int m) const { return polys[m]; }
+  std::vector<std::vector<MomentsPoly>> polys;
+};
+
+// Cell 1 holds two polygons of material 0 and one of material 1.
+// Cell 2 is left out of the reconstruction.
+struct MixedReconstructor {
+  CellPolys const& cell_matpoly_data(int c) const {
+    if (c != 1)
+      throw std::runtime_error("matpolys of an unreconstructed cell queried");
+    return cell;
+  }
+
+  CellPolys cell = {{{poly(0.1, 0.6, 0.1), poly(0.05, 0.9, 0.2)},
+                     {poly(0.1, 0.75, 0.4)}}};
+};
+
+}  // namespace
+
+TEST(MaterialCellIndex, Mixed_Cells) {
+  Wonton::Simple_Mesh mesh(0.0, 0.0, 1.0, 1.0, 2, 2);
+  Wonton::Simple_Mesh_Wrapper mesh_wrapper(mesh);
+  MixedState state;
+  MixedReconstructor ir;
+
+  // the reconstruction of cell 2 was skipped
+  std::vector<char> const reconstructed = {1, 1, 0, 1};
+
+  auto const index = Portage::build_material_cell_index<2>(mesh_wrapper, state,
+                                                           ir, reconstructed);
+  ASSERT_EQ(2u, index.size());
+
+  for (int m = 0; m < 2; m++) {
+    for (int c = 0; c < 4; c++) {
+      ASSERT_EQ(state.cell_index_in_material(c, m), index[m].offset(c));
+      if (index[m].offset(c) < 0)
+        continue;
+
+      // pure and skipped cells fall back to the cell centroid
+      Wonton::Point<2> expected;
+      if (c == 1) {
+        double volume = 0.;
+        for (auto const& poly : ir.cell.get_matpolys(m)) {
+          auto const moments = poly.moments();
+          volume += moments[0];
+          expected[0] += moments[1];
+          expected[1] += moments[2];
+        }
+        for (int k = 0; k < 2; k++)
+          expected[k] /= volume;
+      } else
+        mesh_wrapper.cell_centroid(c, &expected);
+
+      for (int k = 0; k < 2; k++)
+        ASSERT_NEAR(expected[k], index[m].centroid(c)[k], 1.e-12);
+    }
+  }
+
+  // the centroid of material 0 in cell 1 weighs both of its polygons
+  ASSERT_NEAR(0.7, index[0].centroid(1)[0], 1.e-12);
+  ASSERT_NEAR(0.4 / 3., index[0].centroid(1)[1], 1.e-12);
+}
+
+#endif  // HAVE_TANGRAM
@@ -22,6 +22,7 @@ extern "C" {
 
 
 #include "portage/support/portage.h"
+#include "portage/support/workspace.h"
 #include "wonton/support/Point.h"
 #include "wonton/support/Vector.h"
 
@@ -63,56 +64,58 @@ facetedpoly_t get_faceted_matpoly(const Tangram::MatPoly<3>& matpoly) {
 #endif
 
 
-// Intersect one source polyhedron (possibly non-convex but with
-// triangular facets only) with a bunch of tets forming a target
-// polyhedron
+// Scratch storage of init_source_poly_r3d for each thread
+struct SourcePolyR3DWorkspace {
+  std::vector<r3d_rvec3> verts;
+  std::vector<r3d_int> face_num_verts;
+  std::vector<r3d_int> face_vert_list;     // vertices of all faces
+  std::vector<r3d_int *> face_vert_ids;    // into face_vert_list
+};
+
+// Initialize the r3d description of a source polyhedron (possibly
+// non-convex but with triangular facets only) and compute its bounds
 
-std::vector<double>
 inline
-intersect_polys_r3d(const facetedpoly_t &srcpoly,
-                    const std::vector<std::array<Point<3>, 4>> &target_tet_coords,
-                    NumericTolerances_t num_tols) {
+void init_source_poly_r3d(const facetedpoly_t &srcpoly,
+                          r3d_poly *src_r3dpoly,
+                          std::array<double, 6> *source_cell_bounds) {
 
-  // Bounding box of the target cell - will be used to compute
-  // epsilon for bounding box check. We could use the source cell
-  // coordinates to find the bounds as well but its probably an
-  // unnecessary computation (EVEN if the target cell is much
-  // smaller than the source cell)
+  auto& workspace = thread_workspace<SourcePolyR3DWorkspace>();
 
-  std::vector<double> source_cell_bounds =  {1e99, -1e99, 1e99, -1e99,
-                                             1e99, -1e99};
+  *source_cell_bounds = {1e99, -1e99, 1e99, -1e99, 1e99, -1e99};
 
   // Initialize the source polyhedron description in a form R3D wants
   // Simultaneously compute the bounding box
-  r3d_poly src_r3dpoly;
   int num_verts = srcpoly.points.size();
-  r3d_rvec3 *verts = new r3d_rvec3[num_verts];
+  workspace.verts.resize(num_verts);
+  r3d_rvec3 *verts = workspace.verts.data();
   for (int i = 0; i < num_verts; i++) {
     for (int j = 0; j < 3; j++) {
       verts[i].xyz[j] = srcpoly.points[i][j];
 
-      if (source_cell_bounds[2*j] > verts[i].xyz[j])
-        source_cell_bounds[2*j] = verts[i].xyz[j];
-      if (source_cell_bounds[2*j+1] < verts[i].xyz[j])
-        source_cell_bounds[2*j+1] = verts[i].xyz[j];
+      if ((*source_cell_bounds)[2*j] > verts[i].xyz[j])
+        (*source_cell_bounds)[2*j] = verts[i].xyz[j];
+      if ((*source_cell_bounds)[2*j+1] < verts[i].xyz[j])
+        (*source_cell_bounds)[2*j+1] = verts[i].xyz[j];
     }
   }
 
-  // used only for bounding box check not for intersections
-  double bbeps = num_tols.min_absolute_distance;
-
   int num_faces = srcpoly.facetpoints.size();
-  r3d_int *face_num_verts = new r3d_int[num_faces];
-  for (int i = 0; i < num_faces; i++)
+  workspace.face_num_verts.resize(num_faces);
+  r3d_int *face_num_verts = workspace.face_num_verts.data();
+  workspace.face_vert_list.clear();
+  for (int i = 0; i < num_faces; i++) {
     face_num_verts[i] = srcpoly.facetpoints[i].size();
+    workspace.face_vert_list.insert(workspace.face_vert_list.end(),
+                                    srcpoly.facetpoints[i].begin(),
+                                    srcpoly.facetpoints[i].end());
+  }
 
-  r3d_int **face_vert_ids = new r3d_int *[num_faces];
-  for (int i = 0; i < num_faces; i++)
-    face_vert_ids[i] = new r3d_int[face_num_verts[i]];
-
-  for (int i = 0; i < num_faces; i++)
-    std::copy(srcpoly.facetpoints[i].begin(), srcpoly.facetpoints[i].end(),
-              face_vert_ids[i]);
+  // face pointers are set once the list is complete
+  workspace.face_vert_ids.resize(num_faces);
+  r3d_int **face_vert_ids = workspace.face_vert_ids.data();
+  for (int i = 0, offset = 0; i < num_faces; offset += face_num_verts[i++])
+    face_vert_ids[i] = workspace.face_vert_list.data() + offset;
 
 #ifdef DEBUG
   // Lets check the volume of the source polygon - If its convex or
@@ -147,17 +150,65 @@ intersect_polys_r3d(const facetedpoly_t &srcpoly,
     throw std::runtime_error("Source polyhedron has negative volume");
 #endif
 
-  r3d_init_poly(&src_r3dpoly, verts, num_verts, face_vert_ids, face_num_verts,
+  r3d_init_poly(src_r3dpoly, verts, num_verts, face_vert_ids, face_num_verts,
                 num_faces);
+}
+
+
+// Clip a source polyhedron with a set of planes and return the
+// moments of the result
+
+inline
+std::vector<double> clip_poly_r3d(const r3d_poly &src_r3dpoly,
+                                  r3d_plane *planes, int num_planes,
+                                  NumericTolerances_t num_tols) {
+
+  // make a copy of src_r3dpoly first because it will get modified
+  // in the process of clipping
+  r3d_poly src_r3dpoly_copy = src_r3dpoly;
+  r3d_clip(&src_r3dpoly_copy, planes, num_planes);
+
+  // find the moments (up to quadratic order) of the clipped poly
+  const int POLY_ORDER = 1;
+  r3d_real om[R3D_NUM_MOMENTS(POLY_ORDER)];
+  r3d_reduce(&src_r3dpoly_copy, om, POLY_ORDER);
+
+  // Check that the returned volume is positive (if the volume is
+  // zero, i.e. abs(om[0]) < eps, then it can sometimes be
+  // slightly negative, like om[0] == -1.24811e-16.
+  // @todo multiply by domain or element size
+  if (om[0] < num_tols.minimal_intersection_volume)
+    throw std::runtime_error("Negative volume");
+
+  return std::vector<double>(om, om + 4);
+}
+
+
+// Intersect one source polyhedron (possibly non-convex but with
+// triangular facets only) with a bunch of tets forming a target
+// polyhedron
+
+std::vector<double>
+inline
+intersect_polys_r3d(const facetedpoly_t &srcpoly,
+                    const std::vector<std::array<Point<3>, 4>> &target_tet_coords,
+                    NumericTolerances_t num_tols) {
+
+  r3d_poly src_r3dpoly;
+  std::array<double, 6> source_cell_bounds;
+  init_source_poly_r3d(srcpoly, &src_r3dpoly, &source_cell_bounds);
+
+  // used only for bounding box check not for intersections
+  double bbeps = num_tols.min_absolute_distance;
 
   // Finished building source poly; now intersect with tets of target cell
 
   std::vector<double> moments(4, 0);
   for (auto const & target_cell_tet : target_tet_coords) {
-    std::vector<r3d_plane> faces(4);
+    r3d_plane faces[4];
 
-    std::vector<double> target_tet_bounds = {1e99, -1e99, 1e99,
-                                             -1e99, 1e99, -1e99};
+    double target_tet_bounds[6] = {1e99, -1e99, 1e99,
+                                   -1e99, 1e99, -1e99};
     r3d_rvec3 verts2[4];
     for (int i = 0; i < 4; i++)
       for (int j = 0; j < 3; j++) {
@@ -187,40 +238,56 @@ intersect_polys_r3d(const facetedpoly_t &srcpoly,
       throw std::runtime_error("target_wedge has negative volume");
 #endif
 
-    r3d_tet_faces_from_verts(&faces[0], verts2);
-
-    // clip the source poly against the faces of the target tet - but
-    // make a copy of src_r3dpoly first because it will get modified
-    // in the process of clipping
-    r3d_poly src_r3dpoly_copy = src_r3dpoly;
-    r3d_clip(&src_r3dpoly_copy, &faces[0], 4);
+    r3d_tet_faces_from_verts(faces, verts2);
 
-    // find the moments (up to quadratic order) of the clipped poly
-    const int POLY_ORDER = 1;
-    r3d_real om[R3D_NUM_MOMENTS(POLY_ORDER)];
-    r3d_reduce(&src_r3dpoly_copy, om, POLY_ORDER);
-
-    // Check that the returned volume is positive (if the volume is
-    // zero, i.e. abs(om[0]) < eps, then it can sometimes be
-    // slightly negative, like om[0] == -1.24811e-16.
-    // @todo multiply by domain or element size
-    if (om[0] < num_tols.minimal_intersection_volume)
-      throw std::runtime_error("Negative volume");
+    // clip the source poly against the faces of the target tet
+    std::vector<double> om = clip_poly_r3d(src_r3dpoly, faces, 4, num_tols);
 
     // Accumulate moments:
     for (int i = 0; i < 4; i++)
       moments[i] += om[i];
   }
 
-  delete [] verts;
-  delete [] face_num_verts;
-  for (int i = 0; i < num_faces; i++)
-    delete [] face_vert_ids[i];
-  delete [] face_vert_ids;
-
   return moments;
 }  // intersect_polys_3D
 
+
+// Scratch storage of the planes of a convex target polyhedron for each thread
+struct TargetPlanesR3DWorkspace {
+  std::vector<r3d_plane> planes;
+};
+
+// Intersect one source polyhedron (possibly non-convex but with
+// triangular facets only) with a convex target polyhedron given by
+// the planes of its faces, whose normals point into the polyhedron,
+// and its bounds. This requires a single clip instead of one per tet
+// of a decomposition of the target polyhedron.
+
+std::vector<double>
+inline
+intersect_polys_r3d(const facetedpoly_t &srcpoly,
+                    const std::vector<r3d_plane> &target_planes,
+                    const std::array<double, 6> &target_cell_bounds,
+                    NumericTolerances_t num_tols) {
+
+  r3d_poly src_r3dpoly;
+  std::array<double, 6> source_cell_bounds;
+  init_source_poly_r3d(srcpoly, &src_r3dpoly, &source_cell_bounds);
+
+  // used only for bounding box check not for intersections
+  double bbeps = num_tols.min_absolute_distance;
+
+  for (int j = 0; j < 3; ++j)
+    if (target_cell_bounds[2*j] > source_cell_bounds[2*j+1]+bbeps ||
+        target_cell_bounds[2*j+1] < source_cell_bounds[2*j]-bbeps)
+      return std::vector<double>(4, 0.0);
+
+  // r3d_clip takes non-const planes
+  auto& planes = thread_workspace<TargetPlanesR3DWorkspace>().planes;
+  planes.assign(target_planes.begin(), target_planes.end());
+  return clip_poly_r3d(src_r3dpoly, planes.data(), planes.size(), num_tols);
+}
+
 }  // namespace Portage
 
 #endif  // INTERSECT_POLYS_R3D_H
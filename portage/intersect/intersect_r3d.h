@@ -8,6 +8,7 @@ Please see the license file at the root of this repository, or at:
 #define PORTAGE_INTERSECT_INTERSECT_R3D_H_
 
 #include <array>
+#include <cmath>
 #include <stdexcept>
 #include <vector>
 #include <algorithm>
@@ -17,6 +18,7 @@ extern "C" {
 #include "wonton/intersect/r3d/r3d.h"
 }
 #include "portage/support/portage.h"
+#include "portage/support/workspace.h"
 #include "portage/intersect/dummy_interface_reconstructor.h"
 #include "portage/intersect/intersect_polys_r3d.h"
 
@@ -28,6 +30,111 @@ extern "C" {
 
 namespace Portage {
 
+/// Scratch storage of get_convex_cell_planes for each thread
+struct ConvexCellPlanesWorkspace {
+  std::vector<int> faces, dirs, nodes;
+  std::vector<Point<3>> cell_coords, face_coords;
+};
+
+///
+/// \brief Get the face planes of a convex cell with planar faces
+///
+/// Faces are considered planar if all their nodes lie within a small
+/// fraction of the cell extent from the plane through their centroid,
+/// and the cell convex if all its nodes lie behind each face plane
+/// within the same tolerance. Such cells can be intersected by a single
+/// clip against their face planes instead of a tet decomposition.
+///
+/// \param[in]  mesh     mesh wrapper
+/// \param[in]  cell     cell to check
+/// \param[out] planes   face planes with normals pointing into the cell,
+///                      as expected by r3d
+/// \param[out] bounds   bounds of the cell (xmin, xmax, ymin, ...)
+/// \return whether the cell is convex with planar faces
+///
+
+template <class MeshType>
+bool get_convex_cell_planes(MeshType const& mesh, int cell,
+                            std::vector<r3d_plane>* planes,
+                            std::array<double, 6>* bounds) {
+
+  // tolerance on distances relative to the cell extent
+  double const relative_tolerance = 1.e-12;
+
+  auto& workspace = thread_workspace<ConvexCellPlanesWorkspace>();
+  auto& faces = workspace.faces;
+  auto& dirs = workspace.dirs;
+  auto& nodes = workspace.nodes;
+  auto& cell_coords = workspace.cell_coords;
+  auto& face_coords = workspace.face_coords;
+
+  faces.clear();
+  dirs.clear();
+  cell_coords.clear();
+  mesh.cell_get_faces_and_dirs(cell, &faces, &dirs);
+  mesh.cell_get_coordinates(cell, &cell_coords);
+
+  double extent = 0.0;
+  for (int d = 0; d < 3; d++) {
+    auto minmax = std::minmax_element(cell_coords.begin(), cell_coords.end(),
+                                      [d](Point<3> const& a, Point<3> const& b) {
+                                        return a[d] < b[d];
+                                      });
+    (*bounds)[2*d] = (*minmax.first)[d];
+    (*bounds)[2*d+1] = (*minmax.second)[d];
+    extent = std::max(extent, (*bounds)[2*d+1] - (*bounds)[2*d]);
+  }
+  double const tolerance = relative_tolerance * extent;
+
+  int const nfaces = faces.size();
+  planes->resize(nfaces);
+
+  for (int f = 0; f < nfaces; f++) {
+    nodes.clear();
+    mesh.face_get_nodes(faces[f], &nodes);
+    int const nnodes = nodes.size();
+    if (nnodes < 3)
+      return false;
+
+    face_coords.resize(nnodes);
+    Point<3> centroid;
+    for (int i = 0; i < nnodes; i++) {
+      mesh.node_get_coordinates(nodes[i], &face_coords[i]);
+      centroid += face_coords[i] / nnodes;
+    }
+
+    // Newell's normal is well-defined even for non-planar faces
+    Vector<3> normal(0.0, 0.0, 0.0);
+    for (int i = 0; i < nnodes; i++) {
+      Point<3> const& p = face_coords[i];
+      Point<3> const& q = face_coords[(i + 1) % nnodes];
+      normal[0] += (p[1] - q[1]) * (p[2] + q[2]);
+      normal[1] += (p[2] - q[2]) * (p[0] + q[0]);
+      normal[2] += (p[0] - q[0]) * (p[1] + q[1]);
+    }
+    double const norm = normal.norm();
+    if (norm <= 0.0)
+      return false;
+    normal /= (dirs[f] > 0 ? norm : -norm);  // outward
+
+    for (auto const& p : face_coords)
+      if (std::fabs(dot(normal, p - centroid)) > tolerance)
+        return false;
+
+    for (auto const& p : cell_coords)
+      if (dot(normal, p - centroid) > tolerance)
+        return false;
+
+    r3d_plane& plane = (*planes)[f];
+    plane.d = 0.0;
+    for (int d = 0; d < 3; d++) {
+      plane.n.xyz[d] = -normal[d];
+      plane.d += normal[d] * centroid[d];
+    }
+  }
+  return true;
+}
+
 ///
 /// \class IntersectR3D  3-D intersection algorithm
 ///
@@ -38,7 +145,10 @@ namespace Portage {
 /// faces to be intersected with a list of source polyhedra again with
 /// possibly non-planar faces. We will convert the target polyhedron
 /// into a set of convex polyhedra using a symmetric tetrahedral
-/// decomposition (24 tets for a hex). We will convert each source
+/// decomposition (24 tets for a hex), or the minimal decomposition
+/// (5 tets) for hexes of rectangular meshes. Convex target polyhedra
+/// with planar faces are not decomposed at all: source polyhedra are
+/// clipped directly against their face planes. We will convert each source
 /// polyhedron into a faceted non-convex polyhedron where each facet is
 /// a triangle and therefore planar.
 ///
@@ -182,13 +292,31 @@ class IntersectR3D<Entity_kind::CELL, SourceMeshType, SourceStateType, TargetMes
   std::vector<Weights_t> operator() (const int tgt_cell,
                                      const std::vector<int>& src_cells) const {
 
-    std::vector<std::array<Point<3>, 4>> target_tet_coords;
-
-    // We should avoid any decomposition for cells of a rectangular
-    // mesh but for now we will decompose the target all the time
+    auto& workspace = thread_workspace<Workspace>();
+    auto& target_tet_coords = workspace.target_tet_coords;
+    auto& target_planes = workspace.target_planes;
+    auto& srcpoly = workspace.srcpoly;
+    std::array<double, 6> target_bounds;
+
+    // Clip source cells directly against the face planes of convex
+    // target cells with planar faces. Decompose other target cells
+    // into tets, using the minimal decomposition for cells of a
+    // rectangular mesh
+
+    bool const convex = get_convex_cell_planes(targetMeshWrapper, tgt_cell,
+                                               &target_planes, &target_bounds);
+    if (!convex) {
+      target_tet_coords.clear();
+      targetMeshWrapper.decompose_cell_into_tets(tgt_cell, &target_tet_coords,
+                                                 rectangular_mesh_);
+    }
 
-    targetMeshWrapper.decompose_cell_into_tets(tgt_cell, &target_tet_coords,
-                                               rectangular_mesh_);
+    auto intersect = [&](facetedpoly_t const& srcpoly) {
+      return convex ? intersect_polys_r3d(srcpoly, target_planes,
+                                          target_bounds, num_tols_)
+                    : intersect_polys_r3d(srcpoly, target_tet_coords,
+                                          num_tols_);
+    };
 
     // CAN MAKE THIS INTO A THRUST::TRANSFORM CALL
     int nsrc = src_cells.size();
@@ -202,7 +330,8 @@ class IntersectR3D<Entity_kind::CELL, SourceMeshType, SourceStateType, TargetMes
 
 #ifdef HAVE_TANGRAM
       int nmats = sourceStateWrapper.cell_get_num_mats(s);
-      std::vector<int> cellmats;
+      auto& cellmats = workspace.cellmats;
+      cellmats.clear();
       sourceStateWrapper.cell_get_mats(s, &cellmats);
 
       if (!nmats || (matid_ == -1) || (nmats == 1 && cellmats[0] == matid_)) {
@@ -212,12 +341,12 @@ class IntersectR3D<Entity_kind::CELL, SourceMeshType, SourceStateType, TargetMes
         // nmats == 1 && cellmats[0] == matid -- intersection with pure cell
         //                                       containing matid
 
-        facetedpoly_t srcpoly;
+        srcpoly.facetpoints.clear();
+        srcpoly.points.clear();
         sourceMeshWrapper.cell_get_facetization(s, &srcpoly.facetpoints,
                                                 &srcpoly.points);
 
-        this_wt.weights = intersect_polys_r3d(srcpoly, target_tet_coords,
-                                              num_tols_);
+        this_wt.weights = intersect(srcpoly);
 
       } else if (std::find(cellmats.begin(), cellmats.end(), matid_) !=
                  cellmats.end()) {
@@ -232,22 +361,21 @@ class IntersectR3D<Entity_kind::CELL, SourceMeshType, SourceStateType, TargetMes
 
         this_wt.weights.resize(4,0.0);
         for (const auto& matpoly : matpolys) {
-          facetedpoly_t srcpoly = get_faceted_matpoly(matpoly);
+          facetedpoly_t matpoly_faceted = get_faceted_matpoly(matpoly);
 
-          std::vector<double> momvec = intersect_polys_r3d(srcpoly,
-                                          target_tet_coords, num_tols_);
+          std::vector<double> momvec = intersect(matpoly_faceted);
           for (int k = 0; k < 4; k++)
             this_wt.weights[k] += momvec[k];
         }
 
       }
 #else
-      facetedpoly_t srcpoly;
+      srcpoly.facetpoints.clear();
+      srcpoly.points.clear();
       sourceMeshWrapper.cell_get_facetization(s, &srcpoly.facetpoints,
                                               &srcpoly.points);
 
-      this_wt.weights = intersect_polys_r3d(srcpoly, target_tet_coords,
-                                            num_tols_);
+      this_wt.weights = intersect(srcpoly);
 #endif
       // Increment if vol of intersection > 0; otherwise, allow overwrite
       if (!this_wt.weights.empty() && this_wt.weights[0] > 0.0)
@@ -258,6 +386,26 @@ class IntersectR3D<Entity_kind::CELL, SourceMeshType, SourceStateType, TargetMes
     return sources_and_weights;
   }
 
+  /// \brief Number of convex pieces a target cell is clipped as
+  /// \param[in] tgt_cell cell of target mesh
+  /// \return 1 for convex cells with planar faces, else the number of
+  ///         tets of the decomposition of the cell
+  ///
+
+  int num_target_pieces(const int tgt_cell) const {
+    auto& workspace = thread_workspace<Workspace>();
+    std::array<double, 6> target_bounds;
+    if (get_convex_cell_planes(targetMeshWrapper, tgt_cell,
+                               &workspace.target_planes, &target_bounds))
+      return 1;
+
+    workspace.target_tet_coords.clear();
+    targetMeshWrapper.decompose_cell_into_tets(tgt_cell,
+                                               &workspace.target_tet_coords,
+                                               rectangular_mesh_);
+    return workspace.target_tet_coords.size();
+  }
+
 
   IntersectR3D() = delete;
 
@@ -265,6 +413,14 @@ class IntersectR3D<Entity_kind::CELL, SourceMeshType, SourceStateType, TargetMes
   IntersectR3D & operator = (const IntersectR3D &) = delete;
 
  private:
+  // scratch storage of each thread
+  struct Workspace {
+    std::vector<std::array<Point<3>, 4>> target_tet_coords;
+    std::vector<r3d_plane> target_planes;
+    facetedpoly_t srcpoly;
+    std::vector<int> cellmats;
+  };
+
   SourceMeshType const & sourceMeshWrapper;
   SourceStateType const & sourceStateWrapper;
   TargetMeshType const & targetMeshWrapper;
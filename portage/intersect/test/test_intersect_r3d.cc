@@ -441,3 +441,64 @@ TEST(intersectR3D, cube_0_1) {
     ASSERT_NEAR(moments[3], 0.0, eps);
   }
 }
+
+// cells of a box mesh are convex with planar faces, so that they are
+// clipped directly against their face planes, with the same moments as
+// the generic decomposition
+TEST(intersectR3D, convex_cell_planes) {
+
+  auto sourcemesh = std::make_shared<Wonton::Simple_Mesh>(0, 0, 0, 1, 1, 1, 2, 2, 2);
+  auto targetmesh = std::make_shared<Wonton::Simple_Mesh>(0.2, 0.1, 0.3, 1, 1, 1, 1, 1, 1);
+  const Wonton::Simple_Mesh_Wrapper sm(*sourcemesh);
+  const Wonton::Simple_Mesh_Wrapper tm(*targetmesh);
+
+  auto sourcestate = std::make_shared<Wonton::Simple_State>(sourcemesh);
+  const Wonton::Simple_State_Wrapper ss(*sourcestate);
+
+  std::vector<r3d_plane> planes;
+  std::array<double, 6> bounds;
+  for (int c = 0; c < sm.num_owned_cells(); c++)
+    ASSERT_TRUE(Portage::get_convex_cell_planes(sm, c, &planes, &bounds));
+
+  // the target cell centroid is on the inner side of all face planes
+  ASSERT_TRUE(Portage::get_convex_cell_planes(tm, 0, &planes, &bounds));
+  ASSERT_EQ(unsigned(6), planes.size());
+
+  Wonton::Point<3> centroid;
+  tm.cell_centroid(0, &centroid);
+  for (auto const& plane : planes) {
+    double const distance = plane.d + plane.n.xyz[0] * centroid[0]
+                                    + plane.n.xyz[1] * centroid[1]
+                                    + plane.n.xyz[2] * centroid[2];
+    ASSERT_GE(distance, 0.35 - 1.E-12);  // smallest half-width
+  }
+
+  const double eps = 1.E-12;
+
+  Portage::NumericTolerances_t num_tols = Portage::DEFAULT_NUMERIC_TOLERANCES<3>;
+
+  const Portage::IntersectR3D<Portage::Entity_kind::CELL,
+                              Wonton::Simple_Mesh_Wrapper,
+                              Wonton::Simple_State_Wrapper,
+                              Wonton::Simple_Mesh_Wrapper> isect{sm, ss, tm, num_tols};
+
+  std::vector<int> srccells({0, 1, 2, 3, 4, 5, 6, 7});
+  const std::vector<Portage::Weights_t> srcwts = isect(0, srccells);
+
+  // reference moments from the generic decomposition
+  std::vector<std::array<Wonton::Point<3>, 4>> tets;
+  tm.decompose_cell_into_tets(0, &tets, false);
+
+  double volume = 0.0;
+  for (auto const& wt : srcwts) {
+    Portage::facetedpoly_t srcpoly;
+    sm.cell_get_facetization(wt.entityID, &srcpoly.facetpoints, &srcpoly.points);
+    auto const expected = Portage::intersect_polys_r3d(srcpoly, tets, num_tols);
+
+    ASSERT_EQ(expected.size(), wt.weights.size());
+    for (unsigned j = 0; j < expected.size(); j++)
+      ASSERT_NEAR(expected[j], wt.weights[j], eps);
+    volume += wt.weights[0];
+  }
+  ASSERT_NEAR(0.8 * 0.9 * 0.7, volume, eps);
+}
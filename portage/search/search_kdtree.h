@@ -14,6 +14,7 @@ Please see the license file at the root of this repository, or at:
 #include "portage/support/portage.h"
 #include "portage/search/BoundBox.h"
 #include "portage/search/kdtree.h"
+#include "portage/support/workspace.h"
 #include "wonton/support/Point.h"
 
 namespace Portage {
@@ -134,25 +135,33 @@ class SearchKDTree<D, Entity_kind::CELL, SourceMeshType, TargetMeshType> {
     cells in the source mesh.
   */
   std::vector<int> operator() (const int cellId) const {
+    auto& workspace = thread_workspace<Workspace>();
+
     // find bounding box for target cell
-    std::vector<Wonton::Point<D>> cell_coord;
-    targetMesh_.cell_get_coordinates(cellId, &cell_coord);
+    workspace.cell_coord.clear();
+    targetMesh_.cell_get_coordinates(cellId, &workspace.cell_coord);
     Portage::IsotheticBBox<D> bb;
-    for (const auto& cc : cell_coord)
+    for (const auto& cc : workspace.cell_coord)
       bb.add(cc);
 
     // now see which sourceMesh cells have bounding boxes overlapping
     // with target cell, using the kdtree - since Portage::Intersect does
     // not take a shared_ptr, we have have to dereference and take
     // address of tree_
-    std::vector<int> lcandidates;
-    Portage::Intersect(bb, &(*tree_), lcandidates);
+    Portage::Intersect(bb, &(*tree_), workspace.lcandidates);
 
-    std::vector<int> candidates(lcandidates.begin(), lcandidates.end());
+    std::vector<int> candidates(workspace.lcandidates.begin(),
+                                workspace.lcandidates.end());
     return candidates;
   }  // SearchKDTree::operator()
 
  private:
+  // scratch storage of each thread
+  struct Workspace {
+    std::vector<Wonton::Point<D>> cell_coord;
+    std::vector<int> lcandidates;
+  };
+
   const SourceMeshType & sourceMesh_;
   const TargetMeshType & targetMesh_;
   std::shared_ptr<Portage::KDTree<D>> tree_;
@@ -226,25 +235,33 @@ class SearchKDTree<D, Entity_kind::NODE, SourceMeshType, TargetMeshType> {
     nodes in the source mesh.
   */
   std::vector<int> operator() (const int nodeId) const {
+    auto& workspace = thread_workspace<Workspace>();
+
     // find bounding box for dual cell of target node
-    std::vector<Wonton::Point<D>> dual_cell_coord;
-    targetMesh_.dual_cell_get_coordinates(nodeId, &dual_cell_coord);
+    workspace.dual_cell_coord.clear();
+    targetMesh_.dual_cell_get_coordinates(nodeId, &workspace.dual_cell_coord);
     Portage::IsotheticBBox<D> bb;
-    for (const auto& cc : dual_cell_coord)
+    for (const auto& cc : workspace.dual_cell_coord)
       bb.add(cc);
 
     // now see which sourceMesh dual cells have bounding boxes
     // overlapping with dual cell of targetMesh, using the kdtree -
     // since Portage::Intersect does not take a shared_ptr, we have have to
     // dereference and take address of tree_
-    std::vector<int> lcandidates;
-    Portage::Intersect(bb, &(*tree_), lcandidates);
+    Portage::Intersect(bb, &(*tree_), workspace.lcandidates);
 
-    std::vector<int> candidates(lcandidates.begin(), lcandidates.end());
+    std::vector<int> candidates(workspace.lcandidates.begin(),
+                                workspace.lcandidates.end());
     return candidates;
   }  // SearchKDTree::operator()
 
  private:
+  // scratch storage of each thread
+  struct Workspace {
+    std::vector<Wonton::Point<D>> dual_cell_coord;
+    std::vector<int> lcandidates;
+  };
+
   const SourceMeshType & sourceMesh_;
   const TargetMeshType & targetMesh_;
   std::shared_ptr<Portage::KDTree<D>> tree_;
@@ -0,0 +1,158 @@
+/*
+This file is part of the Ristra portage project.
+Please see the license file at the root of this repository, or at:
+    https://github.com/laristra/portage/blob/master/LICENSE
+*/
+
+#ifndef PORTAGE_SUPPORT_CORNER_GEOMETRY_CACHE_H_
+#define PORTAGE_SUPPORT_CORNER_GEOMETRY_CACHE_H_
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "wonton/support/Point.h"
+
+#include "portage/support/first_touch.h"
+#include "portage/support/portage.h"
+
+/*!
+  @file corner_geometry_cache.h
+  @brief Precomputed corner geometry of a mesh wrapper.
+
+  Staggered schemes store masses on corners and velocities on nodes, so
+  their remap walks corners of cells and of nodes repeatedly. Wrappers
+  expose corner volumes but not corner centroids, which have to be
+  assembled from the wedges of each corner on every query.
+*/
+
+namespace Portage {
+
+using Wonton::Point;
+
+/**
+ * @class CornerGeometryCache
+ * @brief Corner centroids, volumes and adjacencies of a mesh.
+ *
+ * Unlike MeshGeometryCache, it does not stand in for the wrapper since
+ * corner centroids are not part of the wrapper interface: it is built
+ * from a wrapper and queried alongside it. Corners of each cell and of
+ * each node are stored in compressed rows, the latter in increasing
+ * corner order so that sums over the corners of a node are reproducible.
+ *
+ * @tparam D: the spatial dimension.
+ * @tparam Mesh: the mesh wrapper type.
+ */
+template<int D, class Mesh>
+class CornerGeometryCache {
+public:
+  /**
+   * @brief Compute the geometry of all corners of a mesh.
+   *
+   * @param mesh: the mesh wrapper.
+   */
+  explicit CornerGeometryCache(Mesh const& mesh) {
+    int const nb_cells = mesh.num_entities(Entity_kind::CELL, Entity_type::ALL);
+    int const nb_nodes = mesh.num_entities(Entity_kind::NODE, Entity_type::ALL);
+    int const nb_corners = mesh.num_entities(Entity_kind::CORNER, Entity_type::ALL);
+
+    centroids_.resize(nb_corners);
+    volumes_.resize(nb_corners);
+    nodes_.resize(nb_corners);
+    cells_.resize(nb_corners);
+
+    std::vector<std::vector<int>> corners(nb_cells);
+    Portage::for_each(Portage::make_counting_iterator(0),
+                      Portage::make_counting_iterator(nb_cells),
+                      [&](int c) { mesh.cell_get_corners(c, &(corners[c])); });
+
+    cell_offsets_.assign(nb_cells + 1, 0);
+    for (int c = 0; c < nb_cells; ++c)
+      cell_offsets_[c + 1] = cell_offsets_[c] + corners[c].size();
+
+    cell_corners_.resize(cell_offsets_[nb_cells]);
+    Portage::for_each(Portage::make_counting_iterator(0),
+                      Portage::make_counting_iterator(nb_cells),
+                      [&](int c) {
+      std::copy(corners[c].begin(), corners[c].end(),
+                cell_corners_.begin() + cell_offsets_[c]);
+      for (auto const& cn : corners[c])
+        cells_[cn] = c;
+    });
+
+    // the centroid of a corner is the volume-weighted
+    // average of the centroids of its wedges
+    Portage::for_each(Portage::make_counting_iterator(0),
+                      Portage::make_counting_iterator(nb_corners),
+                      [&](int cn) {
+      std::vector<int> wedges;
+      std::array<Point<D>, D + 1> coords;
+
+      nodes_[cn] = mesh.corner_get_node(cn);
+      volumes_[cn] = mesh.corner_volume(cn);
+      mesh.corner_get_wedges(cn, &wedges);
+
+      Point<D> centroid;
+      for (auto const& w : wedges) {
+        double const fraction = mesh.wedge_volume(w) / volumes_[cn];
+        mesh.wedge_get_coordinates(w, &coords);
+        for (auto const& p : coords)
+          centroid += fraction * p / (D + 1);
+      }
+      centroids_[cn] = centroid;
+    });
+
+    // invert the corner-node map by counting sort
+    node_offsets_.assign(nb_nodes + 1, 0);
+    for (int cn = 0; cn < nb_corners; ++cn)
+      node_offsets_[nodes_[cn] + 1]++;
+    for (int n = 0; n < nb_nodes; ++n)
+      node_offsets_[n + 1] += node_offsets_[n];
+
+    node_corners_.resize(nb_corners);
+    std::vector<int> position(node_offsets_.begin(), node_offsets_.end() - 1);
+    for (int cn = 0; cn < nb_corners; ++cn)
+      node_corners_[position[nodes_[cn]]++] = cn;
+  }
+
+  /// Number of corners, owned and ghost.
+  int num_corners() const { return volumes_.size(); }
+
+  /// Centroid of a corner.
+  Point<D> const& centroid(int cn) const { return centroids_[cn]; }
+
+  /// Volume of a corner.
+  double volume(int cn) const { return volumes_[cn]; }
+
+  /// Node of a corner.
+  int node(int cn) const { return nodes_[cn]; }
+
+  /// Cell of a corner.
+  int cell(int cn) const { return cells_[cn]; }
+
+  /// Offsets of the corners of each cell, with a trailing total.
+  first_touch_vector<int> const& cell_offsets() const { return cell_offsets_; }
+
+  /// Corners of all cells.
+  first_touch_vector<int> const& cell_corners() const { return cell_corners_; }
+
+  /// Offsets of the corners of each node, with a trailing total.
+  first_touch_vector<int> const& node_offsets() const { return node_offsets_; }
+
+  /// Corners of all nodes.
+  first_touch_vector<int> const& node_corners() const { return node_corners_; }
+
+private:
+  first_touch_vector<Point<D>> centroids_;
+  first_touch_vector<double> volumes_;
+  first_touch_vector<int> nodes_;
+  first_touch_vector<int> cells_;
+  first_touch_vector<int> cell_offsets_;
+  first_touch_vector<int> cell_corners_;
+  first_touch_vector<int> node_offsets_;
+  first_touch_vector<int> node_corners_;
+};
+
+}  // namespace Portage
+
+#endif  // PORTAGE_SUPPORT_CORNER_GEOMETRY_CACHE_H_
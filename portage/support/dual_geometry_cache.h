@@ -0,0 +1,270 @@
+/*
+This file is part of the Ristra portage project.
+Please see the license file at the root of this repository, or at:
+    https://github.com/laristra/portage/blob/master/LICENSE
+*/
+
+#ifndef PORTAGE_SUPPORT_DUAL_GEOMETRY_CACHE_H_
+#define PORTAGE_SUPPORT_DUAL_GEOMETRY_CACHE_H_
+
+#include <algorithm>
+#include <array>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "wonton/support/Point.h"
+
+#include "portage/support/first_touch.h"
+#include "portage/support/portage.h"
+
+/*!
+  @file dual_geometry_cache.h
+  @brief Precomputed dual cell geometry of a mesh wrapper.
+
+  Node remaps work on the control volumes of nodes, i.e. the dual cells
+  of the mesh, which wrappers assemble on the fly from the corners and
+  wedges of the adjacent cells on every query. This is particularly
+  expensive in 3D where the search, the intersector and the gradient
+  all query the same dual cells again for every target node.
+*/
+
+namespace Portage {
+
+using Wonton::Point;
+
+/**
+ * @class DualGeometryCache
+ * @brief A mesh wrapper serving dual cell queries from a cache.
+ *
+ * Like MeshGeometryCache, it derives from the actual wrapper so that it
+ * can be passed to any node-centered component in place of it. Both can
+ * be combined, e.g. DualGeometryCache<3, MeshGeometryCache<3, Wrapper>>.
+ *
+ * Dual cell vertices and bounding boxes are cached for every node along
+ * with its node-adjacent nodes. In 3D, the wedge tets and facetization
+ * of dual cells used by the intersector are cached as well. All of them
+ * are stored in compressed rows.
+ *
+ * Node remaps use it by instantiating their driver with it as mesh type,
+ * as the node examples of simple_mesh_app do: SearchKDTree, IntersectR2D,
+ * IntersectR3D and Limited_Gradient on nodes then read the cached dual
+ * cells. As with MeshGeometryCache, calls internal to the wrapper still
+ * reach the wrapper.
+ *
+ * @tparam D: the spatial dimension.
+ * @tparam Mesh: the mesh wrapper type.
+ */
+template<int D, class Mesh>
+class DualGeometryCache : public Mesh {
+public:
+  /**
+   * @brief Create the wrapper and compute dual cell geometry.
+   *
+   * @param args: arguments of the wrapper constructor.
+   */
+  template<class... Args>
+  explicit DualGeometryCache(Args&&... args) : Mesh(std::forward<Args>(args)...) {
+    build();
+  }
+
+  // keep other overloads of the wrapper
+  using Mesh::dual_cell_get_coordinates;
+  using Mesh::dual_cell_get_node_adj_cells;
+
+  /**
+   * @brief Retrieve the vertex coordinates of a dual cell.
+   *
+   * @param n: the node.
+   * @param coords: coordinates of the vertices of its dual cell.
+   */
+  void dual_cell_get_coordinates(int n, std::vector<Point<D>>* coords) const {
+    coords->assign(vertices_.begin() + vertex_offsets_[n],
+                   vertices_.begin() + vertex_offsets_[n + 1]);
+  }
+
+  /**
+   * @brief Retrieve the bounding box of a dual cell.
+   *
+   * @param n: the node.
+   * @param lo: the lower corner of its dual cell.
+   * @param hi: the upper corner of its dual cell.
+   */
+  void dual_cell_get_bounds(int n, Point<D>* lo, Point<D>* hi) const {
+    for (int d = 0; d < D; ++d) {
+      (*lo)[d] = lower_[d][n];
+      (*hi)[d] = upper_[d][n];
+    }
+  }
+
+  /**
+   * @brief Retrieve the nodes whose dual cells are adjacent to a given one.
+   *
+   * @param n: the node.
+   * @param type: the type of neighbors to retrieve.
+   * @param adjnodes: the neighbors.
+   */
+  void dual_cell_get_node_adj_cells(int n, Entity_type type,
+                                    std::vector<int>* adjnodes) const {
+    if (type != Entity_type::ALL) {
+      Mesh::dual_cell_get_node_adj_cells(n, type, adjnodes);
+      return;
+    }
+    adjnodes->assign(neighbors_.begin() + neighbor_offsets_[n],
+                     neighbors_.begin() + neighbor_offsets_[n + 1]);
+  }
+
+  /**
+   * @brief Retrieve the wedge tets of a dual cell in 3D.
+   *
+   * @param n: the node.
+   * @param tets: coordinates of each tet.
+   */
+  void dual_wedges_get_coordinates(int n,
+                                   std::vector<std::array<Point<3>, 4>>* tets) const {
+    static_assert(D == 3, "wedge tets are only cached in 3D");
+    tets->assign(wedges_.begin() + wedge_offsets_[n],
+                 wedges_.begin() + wedge_offsets_[n + 1]);
+  }
+
+  /**
+   * @brief Retrieve the facetization of a dual cell in 3D.
+   *
+   * @param n: the node.
+   * @param facetpoints: indices of the points of each facet.
+   * @param points: coordinates of the points.
+   */
+  void dual_cell_get_facetization(int n,
+                                  std::vector<std::vector<int>>* facetpoints,
+                                  std::vector<Point<3>>* points) const {
+    static_assert(D == 3, "facetizations are only cached in 3D");
+    points->assign(facet_coords_.begin() + facet_coord_offsets_[n],
+                   facet_coords_.begin() + facet_coord_offsets_[n + 1]);
+
+    int const first = facet_offsets_[n];
+    int const last = facet_offsets_[n + 1];
+    facetpoints->resize(last - first);
+    for (int f = first; f < last; ++f)
+      (*facetpoints)[f - first].assign(facet_points_.begin() + facet_point_offsets_[f],
+                                       facet_points_.begin() + facet_point_offsets_[f + 1]);
+  }
+
+  /// Lower bounds of all dual cells along a given axis.
+  double const* dual_lower_bounds(int d) const { return lower_[d].data(); }
+
+  /// Upper bounds of all dual cells along a given axis.
+  double const* dual_upper_bounds(int d) const { return upper_[d].data(); }
+
+private:
+  /**
+   * @brief Fill compressed rows from per-node lists.
+   *
+   * @param lists: the list of each node.
+   * @param offsets: offsets of each list, with a trailing total.
+   * @param flat: concatenated lists.
+   */
+  template<class T>
+  static void compress(std::vector<std::vector<T>> const& lists,
+                       first_touch_vector<int>& offsets,
+                       first_touch_vector<T>& flat) {
+    int const nb_lists = lists.size();
+    offsets.assign(nb_lists + 1, 0);
+    for (int i = 0; i < nb_lists; ++i)
+      offsets[i + 1] = offsets[i] + lists[i].size();
+
+    flat.resize(offsets[nb_lists]);
+    Portage::for_each(Portage::make_counting_iterator(0),
+                      Portage::make_counting_iterator(nb_lists),
+                      [&](int i) {
+      std::copy(lists[i].begin(), lists[i].end(), flat.begin() + offsets[i]);
+    });
+  }
+
+  /// Compute the geometry of every dual cell.
+  void build() {
+    Mesh const& mesh = *this;
+    int const nb_nodes = mesh.num_entities(Entity_kind::NODE, Entity_type::ALL);
+
+    for (int d = 0; d < D; ++d) {
+      lower_[d].resize(nb_nodes);
+      upper_[d].resize(nb_nodes);
+    }
+
+    std::vector<std::vector<Point<D>>> coords(nb_nodes);
+    std::vector<std::vector<int>> neighbors(nb_nodes);
+
+    Portage::for_each(Portage::make_counting_iterator(0),
+                      Portage::make_counting_iterator(nb_nodes),
+                      [&](int n) {
+      mesh.dual_cell_get_coordinates(n, &(coords[n]));
+      mesh.dual_cell_get_node_adj_cells(n, Entity_type::ALL, &(neighbors[n]));
+
+      Point<D> node;
+      mesh.node_get_coordinates(n, &node);
+      for (int d = 0; d < D; ++d) {
+        lower_[d][n] = upper_[d][n] = node[d];
+        for (auto const& p : coords[n]) {
+          lower_[d][n] = std::min(p[d], lower_[d][n]);
+          upper_[d][n] = std::max(p[d], upper_[d][n]);
+        }
+      }
+    });
+
+    compress(coords, vertex_offsets_, vertices_);
+    compress(neighbors, neighbor_offsets_, neighbors_);
+    build_polytopes(std::integral_constant<bool, D == 3>());
+  }
+
+  /// Compute wedge tets and facetizations of 3D dual cells.
+  void build_polytopes(std::true_type) {
+    Mesh const& mesh = *this;
+    int const nb_nodes = mesh.num_entities(Entity_kind::NODE, Entity_type::ALL);
+
+    std::vector<std::vector<std::array<Point<3>, 4>>> wedges(nb_nodes);
+    std::vector<std::vector<std::vector<int>>> facets(nb_nodes);
+    std::vector<std::vector<Point<3>>> points(nb_nodes);
+
+    Portage::for_each(Portage::make_counting_iterator(0),
+                      Portage::make_counting_iterator(nb_nodes),
+                      [&](int n) {
+      mesh.dual_wedges_get_coordinates(n, &(wedges[n]));
+      mesh.dual_cell_get_facetization(n, &(facets[n]), &(points[n]));
+    });
+
+    compress(wedges, wedge_offsets_, wedges_);
+    compress(points, facet_coord_offsets_, facet_coords_);
+
+    // flatten facets of all nodes, then their points
+    std::vector<std::vector<int>> all_facets;
+    facet_offsets_.assign(nb_nodes + 1, 0);
+    for (int n = 0; n < nb_nodes; ++n) {
+      facet_offsets_[n + 1] = facet_offsets_[n] + facets[n].size();
+      for (auto& facet : facets[n])
+        all_facets.emplace_back(std::move(facet));
+    }
+    compress(all_facets, facet_point_offsets_, facet_points_);
+  }
+
+  /// Nothing more to cache in 2D.
+  void build_polytopes(std::false_type) {}
+
+  std::array<first_touch_vector<double>, D> lower_;
+  std::array<first_touch_vector<double>, D> upper_;
+  first_touch_vector<int> vertex_offsets_;
+  first_touch_vector<Point<D>> vertices_;
+  first_touch_vector<int> neighbor_offsets_;
+  first_touch_vector<int> neighbors_;
+
+  // 3D only
+  first_touch_vector<int> wedge_offsets_;
+  first_touch_vector<std::array<Point<3>, 4>> wedges_;
+  first_touch_vector<int> facet_coord_offsets_;
+  first_touch_vector<Point<3>> facet_coords_;
+  first_touch_vector<int> facet_offsets_;         // of the facets of each node
+  first_touch_vector<int> facet_point_offsets_;   // of the points of each facet
+  first_touch_vector<int> facet_points_;
+};
+
+}  // namespace Portage
+
+#endif  // PORTAGE_SUPPORT_DUAL_GEOMETRY_CACHE_H_
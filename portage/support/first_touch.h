@@ -0,0 +1,153 @@
+/*
+This file is part of the Ristra portage project.
+Please see the license file at the root of this repository, or at:
+    https://github.com/laristra/portage/blob/master/LICENSE
+*/
+
+#ifndef PORTAGE_SUPPORT_FIRST_TOUCH_H_
+#define PORTAGE_SUPPORT_FIRST_TOUCH_H_
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "portage/support/portage.h"
+
+/*!
+  @file first_touch.h
+  @brief Placement of large arrays on the memory of the threads using them.
+
+  Memory pages are placed on the NUMA node of the thread first writing
+  to them. Arrays sized and zero-filled by a std::vector on the calling
+  thread thus end up on a single socket, and threads running on other
+  sockets then access them remotely in every parallel loop.
+*/
+
+namespace Portage {
+
+/**
+ * @class FirstTouchAllocator
+ * @brief An allocator touching the pages of large blocks in parallel.
+ *
+ * Large blocks are freshly mapped and one byte of each page is written
+ * by a Portage::for_each loop over the pages before the container
+ * constructs its elements. With the static partition of the OpenMP
+ * backend of Thrust, each page is then placed on the node of the thread
+ * processing the matching entities in loops over the whole array.
+ * With PORTAGE_ENABLE_HUGE_PAGES, these blocks are also advised for
+ * transparent huge pages, which coarsens placement to the huge page.
+ *
+ * Small blocks, and all blocks when not on Linux, are served by
+ * std::allocator. Without Thrust, loops are serial and pages are not
+ * touched in advance.
+ *
+ * @tparam T: the element type.
+ */
+template<class T>
+class FirstTouchAllocator {
+public:
+  using value_type = T;
+
+  /// size in bytes from which blocks are mapped and touched in parallel
+  static constexpr std::size_t min_bytes = std::size_t(1) << 20;
+
+  FirstTouchAllocator() = default;
+
+  template<class U>
+  FirstTouchAllocator(FirstTouchAllocator<U> const&) {}
+
+  /**
+   * @brief Allocate storage for some elements.
+   *
+   * @param n: number of elements.
+   * @return the uninitialized storage.
+   */
+  T* allocate(std::size_t n) {
+    if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+      throw std::bad_array_new_length();
+
+#ifdef __linux__
+    std::size_t const bytes = n * sizeof(T);
+    if (bytes >= min_bytes) {
+      void* block = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (block == MAP_FAILED)
+        throw std::bad_alloc();
+#if defined(PORTAGE_ENABLE_HUGE_PAGES) && defined(MADV_HUGEPAGE)
+      madvise(block, bytes, MADV_HUGEPAGE);  // only a hint, may fail
+#endif
+      touch_pages(static_cast<char*>(block), bytes);
+      return static_cast<T*>(block);
+    }
+#endif
+    return std::allocator<T>().allocate(n);
+  }
+
+  /**
+   * @brief Release storage.
+   *
+   * @param p: the storage.
+   * @param n: number of elements it was allocated for.
+   */
+  void deallocate(T* p, std::size_t n) {
+#ifdef __linux__
+    if (n * sizeof(T) >= min_bytes) {
+      munmap(p, n * sizeof(T));
+      return;
+    }
+#endif
+    std::allocator<T>().deallocate(p, n);
+  }
+
+private:
+  /**
+   * @brief Write one byte of each page of a block in parallel.
+   *
+   * @param block: the block.
+   * @param bytes: its size.
+   */
+  static void touch_pages(char* block, std::size_t bytes) {
+#if defined(__linux__) && defined(PORTAGE_ENABLE_THRUST)
+    std::size_t const page = sysconf(_SC_PAGESIZE);
+    unsigned const nb_pages = (bytes + page - 1) / page;
+    Portage::for_each(Portage::make_counting_iterator(0),
+                      Portage::make_counting_iterator(nb_pages),
+                      [=](unsigned i) { block[i * page] = 0; });
+#else
+    (void) block;
+    (void) bytes;
+#endif
+  }
+};
+
+template<class T>
+constexpr std::size_t FirstTouchAllocator<T>::min_bytes;
+
+template<class T, class U>
+bool operator==(FirstTouchAllocator<T> const&, FirstTouchAllocator<U> const&) {
+  return true;
+}
+
+template<class T, class U>
+bool operator!=(FirstTouchAllocator<T> const&, FirstTouchAllocator<U> const&) {
+  return false;
+}
+
+/**
+ * @brief A std::vector whose large storage is placed by parallel first touch.
+ *
+ * @tparam T: the element type.
+ */
+template<class T>
+using first_touch_vector = std::vector<T, FirstTouchAllocator<T>>;
+
+}  // namespace Portage
+
+#endif  // PORTAGE_SUPPORT_FIRST_TOUCH_H_
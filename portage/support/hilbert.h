@@ -0,0 +1,95 @@
+/*
+This file is part of the Ristra portage project.
+Please see the license file at the root of this repository, or at:
+    https://github.com/laristra/portage/blob/master/LICENSE
+*/
+
+#ifndef PORTAGE_SUPPORT_HILBERT_H_
+#define PORTAGE_SUPPORT_HILBERT_H_
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+
+/*!
+  @file hilbert.h
+  @brief Hilbert space-filling curve keys.
+
+  Sorting entities by their position along a Hilbert curve numbers them
+  so that entities close in space are mostly close in memory, which is
+  what the geometric kernels walking neighboring entities benefit from.
+*/
+
+namespace Portage {
+
+/**
+ * @brief Position of a point along the Hilbert curve of a box.
+ *
+ * The box is divided into a grid of 2^b cells per axis, with b = 31 in
+ * 2D and b = 21 in 3D so that keys fit in 64 bits, and the key is the
+ * index of the grid cell containing the point along the curve. Points
+ * outside the box are clamped to it. Uses the transposition algorithm
+ * of J. Skilling, "Programming the Hilbert curve", AIP Conf. Proc. 707
+ * (2004).
+ *
+ * @param x: coordinates of the point.
+ * @param dim: spatial dimension, from 1 to 3.
+ * @param lo: lower corner of the box.
+ * @param hi: upper corner of the box.
+ * @return the key of the point.
+ */
+inline std::uint64_t hilbert_key(double const* x, int dim,
+                                 double const* lo, double const* hi) {
+  assert(dim > 0 and dim < 4);
+
+  int const bits = std::min(63 / dim, 32);
+  double const max_coord = double((std::uint64_t(1) << bits) - 1);
+
+  // grid coordinates of the point
+  std::array<std::uint32_t, 3> X {};
+  for (int d = 0; d < dim; ++d) {
+    double const extent = hi[d] - lo[d];
+    double const t = extent > 0. ? (x[d] - lo[d]) / extent : 0.;
+    X[d] = static_cast<std::uint32_t>(std::max(0., std::min(t, 1.)) * max_coord);
+  }
+
+  // inverse undo excess work
+  std::uint32_t const M = std::uint32_t(1) << (bits - 1);
+  for (std::uint32_t Q = M; Q > 1; Q >>= 1) {
+    std::uint32_t const P = Q - 1;
+    for (int d = 0; d < dim; ++d) {
+      if (X[d] & Q)
+        X[0] ^= P;
+      else {
+        std::uint32_t const t = (X[0] ^ X[d]) & P;
+        X[0] ^= t;
+        X[d] ^= t;
+      }
+    }
+  }
+
+  // gray encode
+  for (int d = 1; d < dim; ++d)
+    X[d] ^= X[d - 1];
+
+  std::uint32_t t = 0;
+  for (std::uint32_t Q = M; Q > 1; Q >>= 1)
+    if (X[dim - 1] & Q)
+      t ^= Q - 1;
+
+  for (int d = 0; d < dim; ++d)
+    X[d] ^= t;
+
+  // interleave the bits of the transposed key, most significant first
+  std::uint64_t key = 0;
+  for (int b = bits - 1; b >= 0; --b)
+    for (int d = 0; d < dim; ++d)
+      key = (key << 1) | ((X[d] >> b) & 1);
+
+  return key;
+}
+
+}  // namespace Portage
+
+#endif  // PORTAGE_SUPPORT_HILBERT_H_
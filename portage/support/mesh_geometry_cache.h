@@ -0,0 +1,265 @@
+/*
+This file is part of the Ristra portage project.
+Please see the license file at the root of this repository, or at:
+    https://github.com/laristra/portage/blob/master/LICENSE
+*/
+
+#ifndef PORTAGE_SUPPORT_MESH_GEOMETRY_CACHE_H_
+#define PORTAGE_SUPPORT_MESH_GEOMETRY_CACHE_H_
+
+#include <algorithm>
+#include <array>
+#include <utility>
+#include <vector>
+
+#include "wonton/support/Point.h"
+
+#include "portage/support/first_touch.h"
+#include "portage/support/portage.h"
+
+/*!
+  @file mesh_geometry_cache.h
+  @brief Precomputed cell geometry of a mesh wrapper.
+
+  Search, intersection, gradient and interpolation query the same cell
+  geometry repeatedly, and most wrappers compute it on the fly and fill
+  a fresh vector on each call. The cache computes it once for all cells
+  (owned and ghost) and serves subsequent queries from flat arrays.
+*/
+
+namespace Portage {
+
+using Wonton::Point;
+
+/**
+ * @class MeshGeometryCache
+ * @brief A mesh wrapper serving cell geometry queries from a cache.
+ *
+ * It derives from the actual wrapper so that it can be passed to any
+ * component in place of it: topological queries are forwarded to the
+ * wrapper while cell centroids, volumes, bounding boxes, vertices and
+ * faces along with node coordinates are read from the cache.
+ * Centroids, volumes and bounding boxes are stored per coordinate
+ * (structure of arrays) and vertices and faces in compressed rows.
+ * Arrays are filled by parallel loops over cells and their pages are
+ * placed by parallel first touch (see first_touch.h).
+ *
+ * The cache only serves the queries made through its own type, i.e.
+ * by components instantiated with it such as CoreDriver and the search,
+ * intersect, gradient and interpolate kernels it runs. Calls that the
+ * wrapper makes internally (e.g. its AuxMeshTopology helpers building
+ * sides or wedges) are not virtual and still reach the wrapper, which
+ * returns the same geometry only without the cache speedup.
+ *
+ * The geometry is computed at construction from a built wrapper, or by
+ * update() for wrappers filled after default construction such as flat
+ * mesh wrappers. The mesh must not be modified afterwards unless the
+ * cache is updated again.
+ *
+ * @tparam D: the spatial dimension.
+ * @tparam Mesh: the mesh wrapper type.
+ */
+template<int D, class Mesh>
+class MeshGeometryCache : public Mesh {
+public:
+  /**
+   * @brief Create the wrapper and compute cell geometry.
+   *
+   * A default-constructed wrapper is still empty, so its geometry is
+   * only computed by a later call to update().
+   *
+   * @param args: arguments of the wrapper constructor.
+   */
+  template<class... Args>
+  explicit MeshGeometryCache(Args&&... args) : Mesh(std::forward<Args>(args)...) {
+    if (sizeof...(Args) > 0)
+      update();
+  }
+
+  /**
+   * @brief Compute the geometry of every cell and node again.
+   *
+   * To be called once the wrapper has been filled or modified.
+   */
+  void update() { build(); }
+
+  // keep other overloads of the wrapper
+  using Mesh::cell_get_coordinates;
+  using Mesh::cell_get_faces_and_dirs;
+  using Mesh::node_get_coordinates;
+
+  /**
+   * @brief Retrieve the centroid of a cell.
+   *
+   * @param c: the cell.
+   * @param centroid: its centroid.
+   */
+  void cell_centroid(int c, Point<D>* centroid) const {
+    for (int d = 0; d < D; ++d)
+      (*centroid)[d] = centroids_[d][c];
+  }
+
+  /**
+   * @brief Retrieve the volume of a cell.
+   *
+   * @param c: the cell.
+   * @return its volume.
+   */
+  double cell_volume(int c) const { return volumes_[c]; }
+
+  /**
+   * @brief Retrieve the bounding box of a cell.
+   *
+   * @param c: the cell.
+   * @param lo: its lower corner.
+   * @param hi: its upper corner.
+   */
+  void cell_get_bounds(int c, Point<D>* lo, Point<D>* hi) const {
+    for (int d = 0; d < D; ++d) {
+      (*lo)[d] = lower_[d][c];
+      (*hi)[d] = upper_[d][c];
+    }
+  }
+
+  /**
+   * @brief Retrieve the vertex coordinates of a cell.
+   *
+   * @param c: the cell.
+   * @param coords: coordinates of its vertices.
+   */
+  void cell_get_coordinates(int c, std::vector<Point<D>>* coords) const {
+    coords->assign(vertices_.begin() + vertex_offsets_[c],
+                   vertices_.begin() + vertex_offsets_[c + 1]);
+  }
+
+  /**
+   * @brief Retrieve the faces of a cell and their orientations.
+   *
+   * @param c: the cell.
+   * @param faces: its faces.
+   * @param dirs: whether the normal of each face points outwards (1) or not (-1).
+   */
+  void cell_get_faces_and_dirs(int c, std::vector<int>* faces,
+                               std::vector<int>* dirs) const {
+    faces->assign(faces_.begin() + face_offsets_[c],
+                  faces_.begin() + face_offsets_[c + 1]);
+    dirs->assign(face_dirs_.begin() + face_offsets_[c],
+                 face_dirs_.begin() + face_offsets_[c + 1]);
+  }
+
+  /**
+   * @brief Retrieve the coordinates of a node.
+   *
+   * @param n: the node.
+   * @param coord: its coordinates.
+   */
+  void node_get_coordinates(int n, Point<D>* coord) const {
+    *coord = nodes_[n];
+  }
+
+  /// Centroid coordinates of all cells along a given axis.
+  double const* centroids(int d) const { return centroids_[d].data(); }
+
+  /// Volumes of all cells.
+  double const* volumes() const { return volumes_.data(); }
+
+  /// Lower bounds of all cells along a given axis.
+  double const* lower_bounds(int d) const { return lower_[d].data(); }
+
+  /// Upper bounds of all cells along a given axis.
+  double const* upper_bounds(int d) const { return upper_[d].data(); }
+
+  /// Offsets of the vertices of each cell, with a trailing total.
+  first_touch_vector<int> const& vertex_offsets() const { return vertex_offsets_; }
+
+  /// Vertex coordinates of all cells.
+  first_touch_vector<Point<D>> const& vertices() const { return vertices_; }
+
+  /// Offsets of the faces of each cell, with a trailing total.
+  first_touch_vector<int> const& face_offsets() const { return face_offsets_; }
+
+private:
+  /**
+   * @brief Compute the geometry of every cell and node.
+   *
+   * Per-cell data is gathered in parallel, then the compressed rows
+   * are sized by a prefix sum and filled in parallel.
+   */
+  void build() {
+    Mesh const& mesh = *this;
+    int const nb_cells = mesh.num_entities(Entity_kind::CELL, Entity_type::ALL);
+    int const nb_nodes = mesh.num_entities(Entity_kind::NODE, Entity_type::ALL);
+
+    for (int d = 0; d < D; ++d) {
+      centroids_[d].resize(nb_cells);
+      lower_[d].resize(nb_cells);
+      upper_[d].resize(nb_cells);
+    }
+    volumes_.resize(nb_cells);
+    nodes_.resize(nb_nodes);
+
+    std::vector<std::vector<Point<D>>> coords(nb_cells);
+    std::vector<std::vector<int>> faces(nb_cells);
+    std::vector<std::vector<int>> dirs(nb_cells);
+
+    Portage::for_each(Portage::make_counting_iterator(0),
+                      Portage::make_counting_iterator(nb_cells),
+                      [&](int c) {
+      Point<D> centroid;
+      mesh.cell_centroid(c, &centroid);
+      mesh.cell_get_coordinates(c, &(coords[c]));
+      mesh.cell_get_faces_and_dirs(c, &(faces[c]), &(dirs[c]));
+      volumes_[c] = mesh.cell_volume(c);
+
+      for (int d = 0; d < D; ++d) {
+        centroids_[d][c] = centroid[d];
+        lower_[d][c] = upper_[d][c] = coords[c].empty() ? centroid[d] : coords[c][0][d];
+        for (auto const& p : coords[c]) {
+          lower_[d][c] = std::min(p[d], lower_[d][c]);
+          upper_[d][c] = std::max(p[d], upper_[d][c]);
+        }
+      }
+    });
+
+    Portage::for_each(Portage::make_counting_iterator(0),
+                      Portage::make_counting_iterator(nb_nodes),
+                      [&](int n) { mesh.node_get_coordinates(n, &(nodes_[n])); });
+
+    vertex_offsets_.assign(nb_cells + 1, 0);
+    face_offsets_.assign(nb_cells + 1, 0);
+    for (int c = 0; c < nb_cells; ++c) {
+      vertex_offsets_[c + 1] = vertex_offsets_[c] + coords[c].size();
+      face_offsets_[c + 1] = face_offsets_[c] + faces[c].size();
+    }
+
+    vertices_.resize(vertex_offsets_[nb_cells]);
+    faces_.resize(face_offsets_[nb_cells]);
+    face_dirs_.resize(face_offsets_[nb_cells]);
+
+    Portage::for_each(Portage::make_counting_iterator(0),
+                      Portage::make_counting_iterator(nb_cells),
+                      [&](int c) {
+      std::copy(coords[c].begin(), coords[c].end(),
+                vertices_.begin() + vertex_offsets_[c]);
+      std::copy(faces[c].begin(), faces[c].end(),
+                faces_.begin() + face_offsets_[c]);
+      std::copy(dirs[c].begin(), dirs[c].end(),
+                face_dirs_.begin() + face_offsets_[c]);
+    });
+  }
+
+  std::array<first_touch_vector<double>, D> centroids_;
+  std::array<first_touch_vector<double>, D> lower_;
+  std::array<first_touch_vector<double>, D> upper_;
+  first_touch_vector<double> volumes_;
+  first_touch_vector<Point<D>> nodes_;
+  first_touch_vector<int> vertex_offsets_;
+  first_touch_vector<Point<D>> vertices_;
+  first_touch_vector<int> face_offsets_;
+  first_touch_vector<int> faces_;
+  first_touch_vector<int> face_dirs_;
+};
+
+}  // namespace Portage
+
+#endif  // PORTAGE_SUPPORT_MESH_GEOMETRY_CACHE_H_
@@ -11,7 +11,10 @@ Please see the license file at the root of this repository, or at:
 #ifdef PORTAGE_ENABLE_MPI
 
 #include <algorithm>
+#include <cstdio>
 #include <numeric>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 #include <mpi.h>
@@ -84,6 +87,169 @@ namespace Portage {
     x = y;
   }
 
+  // Sorts (key, value) pairs distributed over all ranks without gathering
+  // them: on return, keys of each rank are sorted and precede those of the
+  // next rank, i.e. the concatenation of all local vectors in rank order
+  // is globally sorted. Pairs sharing a key end up on the same rank.
+  //
+  // This is a sample sort: local keys are sorted, then regularly sampled
+  // to select numpe-1 splitters that determine the destination rank of
+  // each pair, and pairs are exchanged in a single all-to-all.
+  template <typename T>
+  void distributed_sort_type(MPI_Comm comm, const int numpe,
+                             const MPI_Datatype mpi_type,
+                             std::vector<int> &keys, std::vector<T> &values) {
+
+    if (keys.size() != values.size())
+      throw std::invalid_argument("distributed_sort: mismatched sizes");
+
+    // sort local pairs
+    std::vector<int> idx(keys.size());
+    std::iota(idx.begin(), idx.end(), 0);
+    std::stable_sort(idx.begin(), idx.end(),
+                     [&keys](int a, int b) { return keys[a] < keys[b]; });
+    reorder(keys, idx);
+    reorder(values, idx);
+
+    if (numpe == 1)
+      return;
+
+    int const nb_local = keys.size();
+
+    // pick regular samples of local keys
+    std::vector<int> samples;
+    if (nb_local > 0)
+      for (int i = 1; i < numpe; i++)
+        samples.push_back(keys[static_cast<long>(i) * nb_local / numpe]);
+
+    int nb_samples = samples.size();
+    std::vector<int> sample_counts(numpe), sample_displs(numpe, 0);
+    MPI_Allgather(&nb_samples, 1, MPI_INT, sample_counts.data(), 1, MPI_INT, comm);
+    for (int i = 1; i < numpe; i++)
+      sample_displs[i] = sample_displs[i-1] + sample_counts[i-1];
+
+    int const nb_all_samples = sample_displs[numpe-1] + sample_counts[numpe-1];
+    std::vector<int> all_samples(std::max(nb_all_samples, 1));
+    MPI_Allgatherv(samples.data(), nb_samples, MPI_INT, all_samples.data(),
+                   sample_counts.data(), sample_displs.data(), MPI_INT, comm);
+    all_samples.resize(nb_all_samples);
+    std::sort(all_samples.begin(), all_samples.end());
+
+    // send pairs with keys in (splitter[r-1], splitter[r]] to rank r
+    std::vector<int> send_counts(numpe, 0), send_displs(numpe, 0);
+    int start = 0;
+    for (int r = 0; r < numpe; r++) {
+      int end = nb_local;
+      if (r < numpe - 1 and nb_all_samples > 0) {
+        int const splitter = all_samples[static_cast<long>(r + 1) * nb_all_samples / numpe];
+        end = std::upper_bound(keys.begin() + start, keys.end(), splitter) - keys.begin();
+      }
+      send_displs[r] = start;
+      send_counts[r] = end - start;
+      start = end;
+    }
+
+    std::vector<int> recv_counts(numpe), recv_displs(numpe, 0);
+    MPI_Alltoall(send_counts.data(), 1, MPI_INT, recv_counts.data(), 1, MPI_INT, comm);
+    for (int r = 1; r < numpe; r++)
+      recv_displs[r] = recv_displs[r-1] + recv_counts[r-1];
+
+    int const nb_received = recv_displs[numpe-1] + recv_counts[numpe-1];
+    std::vector<int> received_keys(std::max(nb_received, 1));
+    std::vector<T> received_values(std::max(nb_received, 1));
+
+    // keep valid buffers even when empty
+    if (keys.empty()) {
+      keys.resize(1);
+      values.resize(1);
+    }
+
+    MPI_Alltoallv(keys.data(), send_counts.data(), send_displs.data(), MPI_INT,
+                  received_keys.data(), recv_counts.data(), recv_displs.data(),
+                  MPI_INT, comm);
+    MPI_Alltoallv(values.data(), send_counts.data(), send_displs.data(), mpi_type,
+                  received_values.data(), recv_counts.data(), recv_displs.data(),
+                  mpi_type, comm);
+
+    received_keys.resize(nb_received);
+    received_values.resize(nb_received);
+
+    // merge the sorted runs received from each rank
+    idx.resize(nb_received);
+    std::iota(idx.begin(), idx.end(), 0);
+    for (int r = 1; r < numpe; r++) {
+      auto const middle = idx.begin() + recv_displs[r];
+      std::inplace_merge(idx.begin(), middle, middle + recv_counts[r],
+                         [&received_keys](int a, int b) {
+                           return received_keys[a] < received_keys[b];
+                         });
+    }
+
+    keys = std::move(received_keys);
+    values = std::move(received_values);
+    reorder(keys, idx);
+    reorder(values, idx);
+  }
+
+  inline
+  void distributed_sort(MPI_Comm comm, const int numpe,
+                        std::vector<int> &keys, std::vector<int> &values) {
+    distributed_sort_type(comm, numpe, MPI_INT, keys, values);
+  }
+
+  inline
+  void distributed_sort(MPI_Comm comm, const int numpe,
+                        std::vector<int> &keys, std::vector<double> &values) {
+    distributed_sort_type(comm, numpe, MPI_DOUBLE, keys, values);
+  }
+
+  // Writes (key, value) pairs of all ranks to a single text file of
+  // 'key value' lines, in rank order, using collective MPI-IO. Lines have
+  // a fixed width so that each rank writes at an offset given by the
+  // number of lines of the preceding ranks, without any gather. Values
+  // are printed in scientific notation with 17 digits as the apps do.
+  // Combined with distributed_sort, the file is globally sorted by key.
+  inline
+  void write_ordered(MPI_Comm comm, std::string const& filename,
+                     std::vector<int> const &keys,
+                     std::vector<double> const &values) {
+
+    int constexpr line_width = 38;   // 11 + 1 + 25 + 1
+    long const nb_local = keys.size();
+
+    std::vector<char> buffer(nb_local * line_width + 1);
+    for (long i = 0; i < nb_local; i++)
+      std::snprintf(buffer.data() + i * line_width, line_width + 1,
+                    "%11d %25.17e\n", keys[i], values[i]);
+
+    long first_line = 0;
+    MPI_Exscan(&nb_local, &first_line, 1, MPI_LONG, MPI_SUM, comm);
+    int rank;
+    MPI_Comm_rank(comm, &rank);
+    if (rank == 0)
+      first_line = 0;
+
+    MPI_File file;
+    int const mode = MPI_MODE_CREATE | MPI_MODE_WRONLY;
+    if (MPI_File_open(comm, filename.data(), mode, MPI_INFO_NULL, &file) != MPI_SUCCESS)
+      throw std::runtime_error("write_ordered: cannot open " + filename);
+
+    long total = 0;
+    MPI_Allreduce(&nb_local, &total, 1, MPI_LONG, MPI_SUM, comm);
+    MPI_File_set_size(file, static_cast<MPI_Offset>(total) * line_width);
+
+    // write whole lines to avoid overflowing counts
+    MPI_Datatype line_type;
+    MPI_Type_contiguous(line_width, MPI_CHAR, &line_type);
+    MPI_Type_commit(&line_type);
+
+    MPI_Offset const offset = static_cast<MPI_Offset>(first_line) * line_width;
+    MPI_File_write_at_all(file, offset, buffer.data(), static_cast<int>(nb_local),
+                          line_type, MPI_STATUS_IGNORE);
+    MPI_File_close(&file);
+    MPI_Type_free(&line_type);
+  }
+
 } // namespace Portage
 
 #endif
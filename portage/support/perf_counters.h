@@ -0,0 +1,277 @@
+/*
+This file is part of the Ristra portage project.
+Please see the license file at the root of this repository, or at:
+    https://github.com/laristra/portage/blob/master/LICENSE
+*/
+
+#ifndef PORTAGE_SUPPORT_PERF_COUNTERS_H_
+#define PORTAGE_SUPPORT_PERF_COUNTERS_H_
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+  #include <linux/perf_event.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
+
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
+
+/*!
+  @file perf_counters.h
+  @brief Hardware performance counters sampled at remap phase boundaries.
+
+  Counters are opened through perf_event_open on each OpenMP thread of the
+  calling process only, excluding kernel and hypervisor events, so that no
+  special privileges are required with the default 'perf_event_paranoid'
+  settings. When counters cannot be opened (non-Linux system, restricted
+  kernel settings, virtual machines without a PMU), every count reads as
+  zero and available() returns false: callers do not need to special-case
+  the lack of hardware support.
+*/
+
+namespace Portage {
+
+/*!
+  @class PerfCounters perf_counters.h
+  @brief Per-thread and per-phase hardware counters.
+
+  Usage mirrors the phase timers: call start() when entering the first
+  phase, then checkpoint(name) at the end of each phase to accumulate
+  counts since the previous checkpoint under that phase name. Counts of
+  repeated phases add up until reset() is called.
+
+  Counters are attached to the threads of the OpenMP pool at construction,
+  so threads spawned afterwards (e.g. by raising the number of threads)
+  are not measured.
+*/
+class PerfCounters {
+
+public:
+  /// Measured hardware events
+  enum Event { CYCLES, INSTRUCTIONS, LLC_MISSES, BRANCH_MISSES, NUM_EVENTS };
+
+  /// Counts of each event (scaled if counters were multiplexed)
+  using Counts = std::array<double, NUM_EVENTS>;
+
+  /// Open counters on every thread of the OpenMP pool.
+  PerfCounters() {
+#ifdef _OPENMP
+    nthreads_ = omp_get_max_threads();
+#endif
+    fds_.resize(nthreads_);
+    for (auto& fds : fds_)
+      fds.fill(-1);
+
+#ifdef _OPENMP
+    #pragma omp parallel num_threads(nthreads_)
+    open_thread_counters(omp_get_thread_num());
+#else
+    open_thread_counters(0);
+#endif
+    last_.resize(nthreads_);
+    reset();
+  }
+
+  /// Close all counters.
+  ~PerfCounters() {
+#ifdef __linux__
+    for (auto const& fds : fds_)
+      for (int const& fd : fds)
+        if (fd >= 0)
+          close(fd);
+#endif
+  }
+
+  PerfCounters(PerfCounters const&) = delete;
+  PerfCounters& operator=(PerfCounters const&) = delete;
+
+  /// Whether at least one counter could be opened.
+  bool available() const {
+    for (int e = 0; e < NUM_EVENTS; ++e)
+      if (available(static_cast<Event>(e)))
+        return true;
+    return false;
+  }
+
+  /// Whether the given event is measured on the master thread.
+  bool available(Event event) const { return fds_[0][event] >= 0; }
+
+  /// Number of measured threads.
+  int num_threads() const { return nthreads_; }
+
+  /// Restart counting from now and clear all phases.
+  void reset() {
+    start();
+    phases_.clear();
+    counts_.clear();
+  }
+
+  /// Restart counting from now, keeping recorded phases.
+  void start() {
+    for (int t = 0; t < nthreads_; ++t)
+      last_[t] = read(t);
+  }
+
+  /**
+   * @brief Accumulate counts since the last checkpoint into a phase.
+   *
+   * @param phase: the phase name.
+   */
+  void checkpoint(std::string const& phase) {
+    auto& counts = counts_[phase];
+    if (counts.empty()) {
+      counts.resize(nthreads_, Counts{});
+      phases_.push_back(phase);
+    }
+
+    for (int t = 0; t < nthreads_; ++t) {
+      Counts const current = read(t);
+      for (int e = 0; e < NUM_EVENTS; ++e)
+        counts[t][e] += current[e] - last_[t][e];
+      last_[t] = current;
+    }
+  }
+
+  /// Names of the recorded phases in order of first checkpoint.
+  std::vector<std::string> const& phases() const { return phases_; }
+
+  /**
+   * @brief Counts of a phase on a given thread.
+   *
+   * @param phase: the phase name.
+   * @param thread: the thread index.
+   * @return counts of each event, zero if the phase is unknown.
+   */
+  Counts counts(std::string const& phase, int thread) const {
+    auto const it = counts_.find(phase);
+    return it != counts_.end() ? it->second[thread] : Counts{};
+  }
+
+  /**
+   * @brief Counts of a phase summed over all threads.
+   *
+   * @param phase: the phase name.
+   * @return counts of each event, zero if the phase is unknown.
+   */
+  Counts counts(std::string const& phase) const {
+    Counts total {};
+    for (int t = 0; t < nthreads_; ++t) {
+      Counts const local = counts(phase, t);
+      for (int e = 0; e < NUM_EVENTS; ++e)
+        total[e] += local[e];
+    }
+    return total;
+  }
+
+  /**
+   * @brief Print counts of each phase and thread.
+   *
+   * Instructions per cycle tell whether a phase is compute-bound, while
+   * cache misses per thousand instructions tell whether it is memory-bound.
+   *
+   * @param per_thread: whether to detail counts per thread.
+   */
+  void dump(bool per_thread = false) const {
+    if (not available()) {
+      std::printf("\nHardware counters unavailable "
+                  "(check /proc/sys/kernel/perf_event_paranoid).\n");
+      return;
+    }
+
+    std::printf("\nHardware counters:\n");
+    std::printf(" %-12s %6s %14s %14s %6s %12s %12s\n",
+                "phase", "thread", "cycles", "instructions", "IPC",
+                "LLC/kinstr", "branch/kinstr");
+    for (auto const& phase : phases_) {
+      print_line(phase, "all", counts(phase));
+      if (per_thread and nthreads_ > 1)
+        for (int t = 0; t < nthreads_; ++t)
+          print_line("", std::to_string(t), counts(phase, t));
+    }
+    std::fflush(stdout);
+  }
+
+private:
+  /**
+   * @brief Open counters attached to the calling thread.
+   *
+   * @param thread: index of the calling thread.
+   */
+  void open_thread_counters(int thread) {
+#ifdef __linux__
+    uint64_t const config[NUM_EVENTS] = {
+      PERF_COUNT_HW_CPU_CYCLES,
+      PERF_COUNT_HW_INSTRUCTIONS,
+      PERF_COUNT_HW_CACHE_MISSES,
+      PERF_COUNT_HW_BRANCH_MISSES
+    };
+
+    for (int e = 0; e < NUM_EVENTS; ++e) {
+      perf_event_attr attr;
+      std::memset(&attr, 0, sizeof(attr));
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.size = sizeof(attr);
+      attr.config = config[e];
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED
+                       | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+      // calling thread only, on any cpu, no group
+      fds_[thread][e] = static_cast<int>(syscall(__NR_perf_event_open,
+                                                 &attr, 0, -1, -1, 0));
+    }
+#endif
+  }
+
+  /**
+   * @brief Read current counts of a thread.
+   *
+   * @param thread: the thread index.
+   * @return counts of each event, scaled for multiplexing.
+   */
+  Counts read(int thread) const {
+    Counts counts {};
+#ifdef __linux__
+    for (int e = 0; e < NUM_EVENTS; ++e) {
+      int const fd = fds_[thread][e];
+      uint64_t data[3] = {0, 0, 0};  // value, time enabled, time running
+      if (fd >= 0 and ::read(fd, data, sizeof(data)) == sizeof(data)
+          and data[2] > 0)
+        counts[e] = static_cast<double>(data[0]) * data[1] / data[2];
+    }
+#endif
+    return counts;
+  }
+
+  /// Print a line of the counts table.
+  void print_line(std::string const& phase, std::string const& thread,
+                  Counts const& counts) const {
+    double const kinstr = counts[INSTRUCTIONS] / 1.E3;
+    std::printf(" %-12s %6s %14.0f %14.0f %6.2f %12.3f %12.3f\n",
+                phase.data(), thread.data(),
+                counts[CYCLES], counts[INSTRUCTIONS],
+                counts[CYCLES] > 0 ? counts[INSTRUCTIONS] / counts[CYCLES] : 0.,
+                kinstr > 0 ? counts[LLC_MISSES] / kinstr : 0.,
+                kinstr > 0 ? counts[BRANCH_MISSES] / kinstr : 0.);
+  }
+
+  int nthreads_ = 1;
+  std::vector<std::array<int, NUM_EVENTS>> fds_;
+  std::vector<Counts> last_;
+  std::vector<std::string> phases_;
+  std::map<std::string, std::vector<Counts>> counts_;
+};
+
+}  // namespace Portage
+
+#endif  // PORTAGE_SUPPORT_PERF_COUNTERS_H_
@@ -0,0 +1,79 @@
+/*
+This file is part of the Ristra portage project.
+Please see the license file at the root of this repository, or at:
+    https://github.com/laristra/portage/blob/master/LICENSE
+*/
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "wonton/mesh/simple/simple_mesh.h"
+#include "wonton/mesh/simple/simple_mesh_wrapper.h"
+#include "wonton/support/Point.h"
+#include "portage/support/portage.h"
+#include "portage/support/corner_geometry_cache.h"
+
+template<int D>
+void check_corners(Wonton::Simple_Mesh const& mesh) {
+
+  Wonton::Simple_Mesh_Wrapper wrapper(mesh);
+  Portage::CornerGeometryCache<D, Wonton::Simple_Mesh_Wrapper> cache(wrapper);
+
+  int const nb_cells = wrapper.num_entities(Portage::Entity_kind::CELL,
+                                            Portage::Entity_type::ALL);
+  int const nb_nodes = wrapper.num_entities(Portage::Entity_kind::NODE,
+                                            Portage::Entity_type::ALL);
+  ASSERT_EQ(wrapper.num_entities(Portage::Entity_kind::CORNER,
+                                 Portage::Entity_type::ALL),
+            cache.num_corners());
+
+  // corners of a cell tile it, and on a uniform mesh the centroid
+  // of a corner lies halfway between its node and the cell centroid
+  for (int c = 0; c < nb_cells; c++) {
+    std::vector<int> corners;
+    wrapper.cell_get_corners(c, &corners);
+
+    auto const& offsets = cache.cell_offsets();
+    ASSERT_EQ(corners.size(), unsigned(offsets[c + 1] - offsets[c]));
+
+    Wonton::Point<D> xc;
+    wrapper.cell_centroid(c, &xc);
+
+    double volume = 0.;
+    for (unsigned k = 0; k < corners.size(); k++) {
+      int const cn = corners[k];
+      ASSERT_EQ(cn, cache.cell_corners()[offsets[c] + k]);
+      ASSERT_EQ(c, cache.cell(cn));
+      ASSERT_EQ(wrapper.corner_get_node(cn), cache.node(cn));
+      ASSERT_DOUBLE_EQ(wrapper.corner_volume(cn), cache.volume(cn));
+      volume += cache.volume(cn);
+
+      Wonton::Point<D> xn;
+      wrapper.node_get_coordinates(cache.node(cn), &xn);
+      for (int d = 0; d < D; d++)
+        ASSERT_NEAR(0.5 * (xn[d] + xc[d]), cache.centroid(cn)[d], 1.e-12);
+    }
+    ASSERT_NEAR(wrapper.cell_volume(c), volume, 1.e-12);
+  }
+
+  // corners of a node are sorted and point back to it
+  auto const& offsets = cache.node_offsets();
+  ASSERT_EQ(cache.num_corners(), offsets[nb_nodes]);
+  for (int n = 0; n < nb_nodes; n++)
+    for (int k = offsets[n]; k < offsets[n + 1]; k++) {
+      ASSERT_EQ(n, cache.node(cache.node_corners()[k]));
+      if (k > offsets[n])
+        ASSERT_LT(cache.node_corners()[k - 1], cache.node_corners()[k]);
+    }
+}
+
+TEST(CornerGeometryCache, Simple2D) {
+  Wonton::Simple_Mesh mesh(0., 0., 1., 2., 4, 5);
+  check_corners<2>(mesh);
+}
+
+TEST(CornerGeometryCache, Simple3D) {
+  Wonton::Simple_Mesh mesh(0., 0., 0., 1., 2., 3., 3, 4, 5);
+  check_corners<3>(mesh);
+}
@@ -0,0 +1,148 @@
+/*
+This file is part of the Ristra portage project.
+Please see the license file at the root of this repository, or at:
+    https://github.com/laristra/portage/blob/master/LICENSE
+*/
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "wonton/mesh/simple/simple_mesh.h"
+#include "wonton/mesh/simple/simple_mesh_wrapper.h"
+#include "wonton/state/simple/simple_state.h"
+#include "wonton/state/simple/simple_state_wrapper.h"
+#include "wonton/support/Point.h"
+#include "portage/support/portage.h"
+#include "portage/support/dual_geometry_cache.h"
+#include "portage/search/search_kdtree.h"
+#include "portage/intersect/intersect_r3d.h"
+#include "portage/interpolate/interpolate_2nd_order.h"
+#include "portage/driver/coredriver.h"
+
+template<int D>
+void check_dual_cells(Wonton::Simple_Mesh_Wrapper const& wrapper,
+                      Portage::DualGeometryCache<D, Wonton::Simple_Mesh_Wrapper> const& cache) {
+
+  int const nb_nodes = wrapper.num_entities(Portage::Entity_kind::NODE,
+                                            Portage::Entity_type::ALL);
+
+  for (int n = 0; n < nb_nodes; n++) {
+    std::vector<Wonton::Point<D>> expected, cached;
+    wrapper.dual_cell_get_coordinates(n, &expected);
+    cache.dual_cell_get_coordinates(n, &cached);
+    ASSERT_EQ(expected.size(), cached.size());
+
+    Wonton::Point<D> lo, hi;
+    cache.dual_cell_get_bounds(n, &lo, &hi);
+    for (unsigned i = 0; i < expected.size(); i++)
+      for (int d = 0; d < D; d++) {
+        ASSERT_DOUBLE_EQ(expected[i][d], cached[i][d]);
+        ASSERT_LE(lo[d], cached[i][d]);
+        ASSERT_GE(hi[d], cached[i][d]);
+      }
+
+    std::vector<int> expected_adj, cached_adj;
+    wrapper.dual_cell_get_node_adj_cells(n, Portage::Entity_type::ALL, &expected_adj);
+    cache.dual_cell_get_node_adj_cells(n, Portage::Entity_type::ALL, &cached_adj);
+    ASSERT_EQ(expected_adj, cached_adj);
+  }
+}
+
+TEST(DualGeometryCache, Simple2D) {
+  Wonton::Simple_Mesh mesh(0., 0., 1., 2., 4, 5);
+  Wonton::Simple_Mesh_Wrapper wrapper(mesh);
+  Portage::DualGeometryCache<2, Wonton::Simple_Mesh_Wrapper> cache(mesh);
+  check_dual_cells<2>(wrapper, cache);
+}
+
+TEST(DualGeometryCache, Simple3D) {
+  Wonton::Simple_Mesh mesh(0., 0., 0., 1., 2., 3., 2, 3, 4);
+  Wonton::Simple_Mesh_Wrapper wrapper(mesh);
+  Portage::DualGeometryCache<3, Wonton::Simple_Mesh_Wrapper> cache(mesh);
+  check_dual_cells<3>(wrapper, cache);
+
+  int const nb_nodes = wrapper.num_entities(Portage::Entity_kind::NODE,
+                                            Portage::Entity_type::ALL);
+
+  for (int n = 0; n < nb_nodes; n++) {
+    std::vector<std::array<Wonton::Point<3>, 4>> expected_tets, cached_tets;
+    wrapper.dual_wedges_get_coordinates(n, &expected_tets);
+    cache.dual_wedges_get_coordinates(n, &cached_tets);
+    ASSERT_EQ(expected_tets.size(), cached_tets.size());
+    for (unsigned t = 0; t < expected_tets.size(); t++)
+      for (int i = 0; i < 4; i++)
+        for (int d = 0; d < 3; d++)
+          ASSERT_DOUBLE_EQ(expected_tets[t][i][d], cached_tets[t][i][d]);
+
+    std::vector<std::vector<int>> expected_facets, cached_facets;
+    std::vector<Wonton::Point<3>> expected_points, cached_points;
+    wrapper.dual_cell_get_facetization(n, &expected_facets, &expected_points);
+    cache.dual_cell_get_facetization(n, &cached_facets, &cached_points);
+    ASSERT_EQ(expected_facets, cached_facets);
+    ASSERT_EQ(expected_points.size(), cached_points.size());
+    for (unsigned i = 0; i < expected_points.size(); i++)
+      for (int d = 0; d < 3; d++)
+        ASSERT_DOUBLE_EQ(expected_points[i][d], cached_points[i][d]);
+  }
+}
+
+// Remaps a linear node field in 3D through the core driver on a mesh type.
+template<class Mesh>
+std::vector<double> remap_nodes(std::shared_ptr<Wonton::Simple_Mesh> const& source,
+                                std::shared_ptr<Wonton::Simple_Mesh> const& target) {
+
+  Mesh source_mesh(*source);
+  Mesh target_mesh(*target);
+  Wonton::Simple_State source_state(source);
+  Wonton::Simple_State target_state(target);
+
+  int const nb_source_nodes = source_mesh.num_owned_nodes();
+  int const nb_target_nodes = target_mesh.num_owned_nodes();
+
+  std::vector<double> data(nb_source_nodes);
+  for (int n = 0; n < nb_source_nodes; n++) {
+    Wonton::Point<3> coord;
+    source_mesh.node_get_coordinates(n, &coord);
+    data[n] = coord[0] + 2 * coord[1] + 3 * coord[2];
+  }
+
+  std::vector<double> zeros(nb_target_nodes, 0.);
+  source_state.add("nodevars", Portage::Entity_kind::NODE, data.data());
+  target_state.add("nodevars", Portage::Entity_kind::NODE, zeros.data());
+
+  Wonton::Simple_State_Wrapper source_state_wrapper(source_state);
+  Wonton::Simple_State_Wrapper target_state_wrapper(target_state);
+
+  Portage::CoreDriver<3, Portage::Entity_kind::NODE,
+                      Mesh, Wonton::Simple_State_Wrapper>
+    driver(source_mesh, source_state_wrapper, target_mesh, target_state_wrapper);
+
+  auto candidates = driver.template search<Portage::SearchKDTree>();
+  auto weights = driver.template intersect_meshes<Portage::IntersectR3D>(candidates);
+  auto gradients = driver.compute_source_gradient("nodevars", Portage::BARTH_JESPERSEN);
+  driver.template interpolate_mesh_var<double, Portage::Interpolate_2ndOrder>(
+    "nodevars", "nodevars", weights, &gradients);
+
+  double* remapped = nullptr;
+  target_state_wrapper.mesh_get_data(Portage::Entity_kind::NODE, "nodevars", &remapped);
+  return std::vector<double>(remapped, remapped + nb_target_nodes);
+}
+
+// Checks that a node remap gives the same results on the cache.
+TEST(DualGeometryCache, Driver) {
+
+  auto source = std::make_shared<Wonton::Simple_Mesh>(0., 0., 0., 1., 1., 1., 3, 3, 3);
+  auto target = std::make_shared<Wonton::Simple_Mesh>(0., 0., 0., 1., 1., 1., 4, 4, 4);
+
+  using Cache = Portage::DualGeometryCache<3, Wonton::Simple_Mesh_Wrapper>;
+  auto const expected = remap_nodes<Wonton::Simple_Mesh_Wrapper>(source, target);
+  auto const cached = remap_nodes<Cache>(source, target);
+
+  ASSERT_EQ(expected.size(), cached.size());
+  for (unsigned n = 0; n < expected.size(); n++) {
+    ASSERT_DOUBLE_EQ(expected[n], cached[n]);
+  }
+}
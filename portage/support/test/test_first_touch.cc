@@ -0,0 +1,47 @@
+/*
+This file is part of the Ristra portage project.
+Please see the license file at the root of this repository, or at:
+    https://github.com/laristra/portage/blob/master/LICENSE
+*/
+
+#include <numeric>
+#include <utility>
+
+#include "gtest/gtest.h"
+
+#include "portage/support/first_touch.h"
+
+// both small blocks from std::allocator and large mapped blocks
+TEST(FirstTouch, Sizes) {
+  std::size_t const large = Portage::FirstTouchAllocator<double>::min_bytes;
+
+  for (std::size_t n : {std::size_t(0), std::size_t(10), large / 8, large}) {
+    Portage::first_touch_vector<double> values(n, 1.);
+    ASSERT_EQ(n, values.size());
+    for (auto const& v : values)
+      ASSERT_EQ(1., v);
+
+    Portage::first_touch_vector<int> ids(n);
+    for (auto const& i : ids)
+      ASSERT_EQ(0, i);
+  }
+}
+
+// storage moves between blocks of either kind when growing
+TEST(FirstTouch, Growth) {
+  Portage::first_touch_vector<int> ids;
+  int const n = Portage::FirstTouchAllocator<int>::min_bytes;
+  for (int i = 0; i < n; ++i)
+    ids.push_back(i);
+
+  for (int i = 0; i < n; ++i)
+    ASSERT_EQ(i, ids[i]);
+
+  Portage::first_touch_vector<int> copy(ids);
+  Portage::first_touch_vector<int> moved(std::move(ids));
+  ASSERT_EQ(copy, moved);
+
+  moved.resize(10);
+  moved.shrink_to_fit();
+  ASSERT_EQ(45, std::accumulate(moved.begin(), moved.end(), 0));
+}
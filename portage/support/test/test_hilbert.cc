@@ -0,0 +1,75 @@
+/*
+This file is part of the Ristra portage project.
+Please see the license file at the root of this repository, or at:
+    https://github.com/laristra/portage/blob/master/LICENSE
+*/
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <numeric>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "portage/support/hilbert.h"
+
+// Sort the centers of a regular grid of 2^k cells per axis along the
+// curve: each cell must then be face-adjacent to the previous one.
+template<int D>
+void check_curve(int k) {
+  int const n = 1 << k;
+  int nb_cells = 1;
+  for (int d = 0; d < D; ++d)
+    nb_cells *= n;
+
+  double const lo[3] = {-1., 0., 2.};
+  double const hi[3] = {1., 3., 3.};
+
+  std::vector<std::array<int, D>> cells(nb_cells);
+  std::vector<std::uint64_t> keys(nb_cells);
+  for (int c = 0; c < nb_cells; ++c) {
+    double x[D];
+    for (int d = 0, r = c; d < D; ++d, r /= n) {
+      cells[c][d] = r % n;
+      x[d] = lo[d] + (cells[c][d] + 0.5) / n * (hi[d] - lo[d]);
+    }
+    keys[c] = Portage::hilbert_key(x, D, lo, hi);
+  }
+
+  std::vector<int> order(nb_cells);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(),
+            [&](int i, int j) { return keys[i] < keys[j]; });
+
+  // the curve starts in the lower corner and keys are distinct
+  for (int d = 0; d < D; ++d)
+    ASSERT_EQ(0, cells[order[0]][d]);
+
+  for (int i = 1; i < nb_cells; ++i) {
+    ASSERT_LT(keys[order[i - 1]], keys[order[i]]);
+    int distance = 0;
+    for (int d = 0; d < D; ++d)
+      distance += std::abs(cells[order[i]][d] - cells[order[i - 1]][d]);
+    ASSERT_EQ(1, distance);
+  }
+}
+
+TEST(Hilbert, Curve2D) { check_curve<2>(4); }
+
+TEST(Hilbert, Curve3D) { check_curve<3>(3); }
+
+TEST(Hilbert, Clamped) {
+  double const lo[2] = {0., 0.};
+  double const hi[2] = {1., 1.};
+  double const inside[2] = {0., 0.};
+  double const outside[2] = {-5., -1.};
+  double const flat_hi[2] = {1., 0.};
+
+  // points outside the box and degenerate boxes are clamped
+  ASSERT_EQ(Portage::hilbert_key(inside, 2, lo, hi),
+            Portage::hilbert_key(outside, 2, lo, hi));
+  ASSERT_EQ(Portage::hilbert_key(inside, 2, lo, flat_hi),
+            Portage::hilbert_key(outside, 2, lo, flat_hi));
+}
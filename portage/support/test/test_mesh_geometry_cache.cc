@@ -0,0 +1,176 @@
+/*
+This file is part of the Ristra portage project.
+Please see the license file at the root of this repository, or at:
+    https://github.com/laristra/portage/blob/master/LICENSE
+*/
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "wonton/mesh/simple/simple_mesh.h"
+#include "wonton/mesh/simple/simple_mesh_wrapper.h"
+#include "wonton/state/simple/simple_state.h"
+#include "wonton/state/simple/simple_state_wrapper.h"
+#include "wonton/support/Point.h"
+#include "portage/support/portage.h"
+#include "portage/support/mesh_geometry_cache.h"
+#include "portage/interpolate/gradient.h"
+#include "portage/interpolate/interpolate_2nd_order.h"
+#include "portage/search/search_kdtree.h"
+#include "portage/intersect/intersect_r2d.h"
+#include "portage/driver/coredriver.h"
+
+template<int D>
+void check_geometry(Wonton::Simple_Mesh const& mesh) {
+
+  Wonton::Simple_Mesh_Wrapper wrapper(mesh);
+  Portage::MeshGeometryCache<D, Wonton::Simple_Mesh_Wrapper> cache(mesh);
+
+  int const nb_cells = wrapper.num_entities(Portage::Entity_kind::CELL,
+                                            Portage::Entity_type::ALL);
+  ASSERT_EQ(nb_cells, cache.num_entities(Portage::Entity_kind::CELL,
+                                         Portage::Entity_type::ALL));
+
+  for (int c = 0; c < nb_cells; c++) {
+    Wonton::Point<D> expected, cached, lo, hi;
+    wrapper.cell_centroid(c, &expected);
+    cache.cell_centroid(c, &cached);
+    cache.cell_get_bounds(c, &lo, &hi);
+    for (int d = 0; d < D; d++) {
+      ASSERT_DOUBLE_EQ(expected[d], cached[d]);
+      ASSERT_DOUBLE_EQ(expected[d], cache.centroids(d)[c]);
+      ASSERT_LT(lo[d], cached[d]);
+      ASSERT_GT(hi[d], cached[d]);
+    }
+    ASSERT_DOUBLE_EQ(wrapper.cell_volume(c), cache.cell_volume(c));
+
+    std::vector<Wonton::Point<D>> expected_coords, cached_coords;
+    wrapper.cell_get_coordinates(c, &expected_coords);
+    cache.cell_get_coordinates(c, &cached_coords);
+    ASSERT_EQ(expected_coords.size(), cached_coords.size());
+    for (unsigned i = 0; i < expected_coords.size(); i++)
+      for (int d = 0; d < D; d++) {
+        ASSERT_DOUBLE_EQ(expected_coords[i][d], cached_coords[i][d]);
+        ASSERT_LE(lo[d], cached_coords[i][d]);
+        ASSERT_GE(hi[d], cached_coords[i][d]);
+      }
+
+    std::vector<int> expected_faces, expected_dirs, cached_faces, cached_dirs;
+    wrapper.cell_get_faces_and_dirs(c, &expected_faces, &expected_dirs);
+    cache.cell_get_faces_and_dirs(c, &cached_faces, &cached_dirs);
+    ASSERT_EQ(expected_faces, cached_faces);
+    ASSERT_EQ(expected_dirs, cached_dirs);
+  }
+}
+
+TEST(MeshGeometryCache, Simple2D) {
+  Wonton::Simple_Mesh mesh(0., 0., 1., 2., 4, 5);
+  check_geometry<2>(mesh);
+}
+
+TEST(MeshGeometryCache, Simple3D) {
+  Wonton::Simple_Mesh mesh(0., 0., 0., 1., 2., 3., 3, 4, 5);
+  check_geometry<3>(mesh);
+}
+
+// Checks that the cache can be used in place of the wrapper.
+TEST(MeshGeometryCache, Gradient) {
+
+  using Cache = Portage::MeshGeometryCache<2, Wonton::Simple_Mesh_Wrapper>;
+
+  auto mesh = std::make_shared<Wonton::Simple_Mesh>(0., 0., 1., 1., 4, 4);
+  Cache cache(*mesh);
+  Wonton::Simple_State state(mesh);
+  Wonton::Simple_State_Wrapper state_wrapper(state);
+
+  int const nb_cells = cache.num_owned_cells();
+  std::vector<double> data(nb_cells);
+  for (int c = 0; c < nb_cells; c++) {
+    Wonton::Point<2> centroid;
+    cache.cell_centroid(c, &centroid);
+    data[c] = centroid[0] + 2 * centroid[1];
+  }
+  state.add("cellvars", Portage::Entity_kind::CELL, data.data());
+
+  Portage::Limited_Gradient<2, Portage::Entity_kind::CELL,
+                            Cache, Wonton::Simple_State_Wrapper>
+    gradient(cache, state_wrapper, "cellvars",
+             Portage::NOLIMITER, Portage::BND_NOLIMITER);
+
+  for (int c = 0; c < nb_cells; c++) {
+    Wonton::Vector<2> grad = gradient(c);
+    ASSERT_NEAR(1.0, grad[0], 1.e-10);
+    ASSERT_NEAR(2.0, grad[1], 1.e-10);
+  }
+}
+
+// Remaps a linear field through the core driver on a source mesh type.
+template<class SourceMesh>
+std::vector<double> remap(SourceMesh const& source_mesh,
+                          std::shared_ptr<Wonton::Simple_Mesh> const& source,
+                          std::shared_ptr<Wonton::Simple_Mesh> const& target) {
+
+  Wonton::Simple_Mesh_Wrapper target_mesh(*target);
+  Wonton::Simple_State source_state(source);
+  Wonton::Simple_State target_state(target);
+
+  int const nb_source_cells = source_mesh.num_owned_cells();
+  int const nb_target_cells = target_mesh.num_owned_cells();
+
+  std::vector<double> data(nb_source_cells);
+  for (int c = 0; c < nb_source_cells; c++) {
+    Wonton::Point<2> centroid;
+    source_mesh.cell_centroid(c, &centroid);
+    data[c] = centroid[0] + 2 * centroid[1];
+  }
+
+  std::vector<double> zeros(nb_target_cells, 0.);
+  source_state.add("cellvars", Portage::Entity_kind::CELL, data.data());
+  target_state.add("cellvars", Portage::Entity_kind::CELL, zeros.data());
+
+  Wonton::Simple_State_Wrapper source_state_wrapper(source_state);
+  Wonton::Simple_State_Wrapper target_state_wrapper(target_state);
+
+  Portage::CoreDriver<2, Portage::Entity_kind::CELL,
+                      SourceMesh, Wonton::Simple_State_Wrapper,
+                      Wonton::Simple_Mesh_Wrapper, Wonton::Simple_State_Wrapper>
+    driver(source_mesh, source_state_wrapper, target_mesh, target_state_wrapper);
+
+  auto candidates = driver.template search<Portage::SearchKDTree>();
+  auto weights = driver.template intersect_meshes<Portage::IntersectR2D>(candidates);
+  auto gradients = driver.compute_source_gradient("cellvars", Portage::BARTH_JESPERSEN);
+  driver.template interpolate_mesh_var<double, Portage::Interpolate_2ndOrder>(
+    "cellvars", "cellvars", weights, &gradients);
+
+  double* remapped = nullptr;
+  target_state_wrapper.mesh_get_data(Portage::Entity_kind::CELL, "cellvars", &remapped);
+  return std::vector<double>(remapped, remapped + nb_target_cells);
+}
+
+// Checks that the core driver gives the same results on the cache.
+TEST(MeshGeometryCache, Driver) {
+
+  auto source = std::make_shared<Wonton::Simple_Mesh>(0., 0., 1., 1., 5, 5);
+  auto target = std::make_shared<Wonton::Simple_Mesh>(0., 0., 1., 1., 7, 6);
+
+  Wonton::Simple_Mesh_Wrapper wrapper(*source);
+  Portage::MeshGeometryCache<2, Wonton::Simple_Mesh_Wrapper> cache(*source);
+
+  auto const expected = remap(wrapper, source, target);
+  auto const cached = remap(cache, source, target);
+
+  ASSERT_EQ(expected.size(), cached.size());
+  for (unsigned c = 0; c < expected.size(); c++) {
+    ASSERT_DOUBLE_EQ(expected[c], cached[c]);
+  }
+
+  // linear fields are remapped exactly
+  Wonton::Simple_Mesh_Wrapper target_mesh(*target);
+  for (unsigned c = 0; c < cached.size(); c++) {
+    Wonton::Point<2> centroid;
+    target_mesh.cell_centroid(c, &centroid);
+    ASSERT_NEAR(centroid[0] + 2 * centroid[1], cached[c], 1.e-10);
+  }
+}
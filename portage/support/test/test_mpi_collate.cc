@@ -0,0 +1,98 @@
+/*
+This file is part of the Ristra portage project.
+Please see the license file at the root of this repository, or at:
+    https://github.com/laristra/portage/blob/master/LICENSE
+*/
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "mpi.h"
+
+#include "portage/support/mpi_collate.h"
+
+// Sorts keys distributed over ranks, including an empty rank, and checks
+// that every rank holds a sorted slice of the global sequence.
+TEST(MPI_Collate, DistributedSort) {
+
+  int rank, nb_ranks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &nb_ranks);
+
+  // keys overlap across ranks and are duplicated within ranks
+  int const nb_local = (rank == 1 ? 0 : 20 + 7 * rank);
+  std::vector<int> keys(nb_local);
+  std::vector<double> values(nb_local);
+  for (int i = 0; i < nb_local; i++) {
+    keys[i] = (37 * i + 11 * rank) % 50;
+    values[i] = 0.5 * keys[i];
+  }
+
+  long local_count = nb_local, initial_count = 0, final_count = 0;
+  MPI_Allreduce(&local_count, &initial_count, 1, MPI_LONG, MPI_SUM, MPI_COMM_WORLD);
+
+  Portage::distributed_sort(MPI_COMM_WORLD, nb_ranks, keys, values);
+
+  // local slice is sorted and values followed their keys
+  ASSERT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+  int const nb_sorted = keys.size();
+  for (int i = 0; i < nb_sorted; i++)
+    ASSERT_DOUBLE_EQ(0.5 * keys[i], values[i]);
+
+  // no pair was lost
+  local_count = nb_sorted;
+  MPI_Allreduce(&local_count, &final_count, 1, MPI_LONG, MPI_SUM, MPI_COMM_WORLD);
+  ASSERT_EQ(initial_count, final_count);
+
+  // slices are ordered by rank
+  int const first = keys.empty() ? -1 : keys.front();
+  int const last = keys.empty() ? -1 : keys.back();
+  std::vector<int> firsts(nb_ranks), lasts(nb_ranks);
+  MPI_Allgather(&first, 1, MPI_INT, firsts.data(), 1, MPI_INT, MPI_COMM_WORLD);
+  MPI_Allgather(&last, 1, MPI_INT, lasts.data(), 1, MPI_INT, MPI_COMM_WORLD);
+
+  int previous = -1;
+  for (int r = 0; r < nb_ranks; r++) {
+    if (firsts[r] < 0)
+      continue;
+    ASSERT_GT(firsts[r], previous);
+    previous = lasts[r];
+  }
+}
+
+// Writes sorted keys with MPI-IO and reads the file back.
+TEST(MPI_Collate, WriteOrdered) {
+
+  int rank, nb_ranks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &nb_ranks);
+
+  int const nb_local = 10;
+  std::vector<int> keys(nb_local);
+  std::vector<double> values(nb_local);
+  for (int i = 0; i < nb_local; i++) {
+    keys[i] = i * nb_ranks + rank;
+    values[i] = -1.5 * keys[i];
+  }
+
+  Portage::distributed_sort(MPI_COMM_WORLD, nb_ranks, keys, values);
+  Portage::write_ordered(MPI_COMM_WORLD, "mpi_collate.txt", keys, values);
+
+  if (rank == 0) {
+    std::ifstream file("mpi_collate.txt");
+    int key, expected = 0;
+    double value;
+    while (file >> key >> value) {
+      ASSERT_EQ(expected, key);
+      ASSERT_DOUBLE_EQ(-1.5 * key, value);
+      expected++;
+    }
+    ASSERT_EQ(nb_local * nb_ranks, expected);
+    std::remove("mpi_collate.txt");
+  }
+  MPI_Barrier(MPI_COMM_WORLD);
+}
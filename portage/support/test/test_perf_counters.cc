@@ -0,0 +1,65 @@
+/*
+This file is part of the Ristra portage project.
+Please see the license file at the root of this repository, or at:
+    https://github.com/laristra/portage/blob/master/LICENSE
+*/
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "portage/support/perf_counters.h"
+
+using Portage::PerfCounters;
+
+// Some work for the counters to measure.
+double workload(int n) {
+  std::vector<double> values(n);
+  double sum = 0.;
+  for (int i = 0; i < n; ++i) {
+    values[i] = std::sqrt(static_cast<double>(i));
+    sum += values[i];
+  }
+  return sum;
+}
+
+TEST(PerfCounters, Phases) {
+  PerfCounters counters;
+  ASSERT_GE(counters.num_threads(), 1);
+
+  counters.start();
+  ASSERT_GT(workload(100000), 0.);
+  counters.checkpoint("first");
+  ASSERT_GT(workload(10), 0.);
+  counters.checkpoint("second");
+  ASSERT_GT(workload(100000), 0.);
+  counters.checkpoint("first");
+
+  // phases are listed once in order of first checkpoint
+  auto const& phases = counters.phases();
+  ASSERT_EQ(phases.size(), unsigned(2));
+  ASSERT_EQ(phases[0], "first");
+  ASSERT_EQ(phases[1], "second");
+
+  // counts are zero if unavailable, monotonic otherwise
+  auto const first = counters.counts("first");
+  auto const second = counters.counts("second");
+  for (int e = 0; e < PerfCounters::NUM_EVENTS; ++e) {
+    ASSERT_GE(first[e], 0.);
+    ASSERT_GE(second[e], 0.);
+  }
+
+  if (counters.available(PerfCounters::INSTRUCTIONS))
+    ASSERT_GT(first[PerfCounters::INSTRUCTIONS], second[PerfCounters::INSTRUCTIONS]);
+  else
+    ASSERT_EQ(first[PerfCounters::INSTRUCTIONS], 0.);
+
+  // unknown phases have no counts
+  auto const unknown = counters.counts("unknown");
+  for (int e = 0; e < PerfCounters::NUM_EVENTS; ++e)
+    ASSERT_EQ(unknown[e], 0.);
+
+  counters.reset();
+  ASSERT_TRUE(counters.phases().empty());
+  counters.dump(true);
+}
@@ -0,0 +1,57 @@
+/*
+This file is part of the Ristra portage project.
+Please see the license file at the root of this repository, or at:
+    https://github.com/laristra/portage/blob/master/LICENSE
+*/
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "portage/support/workspace.h"
+
+namespace {
+
+struct FirstWorkspace { std::vector<int> list; };
+struct SecondWorkspace { std::vector<int> list; };
+
+}  // namespace
+
+TEST(Workspace, ReusedOnThread) {
+  auto& workspace = Portage::thread_workspace<FirstWorkspace>();
+  workspace.list.assign(100, 1);
+  int const* data = workspace.list.data();
+
+  // the same storage is retrieved with its capacity on the next call
+  auto& again = Portage::thread_workspace<FirstWorkspace>();
+  ASSERT_EQ(&workspace, &again);
+  again.list.clear();
+  again.list.resize(50, 2);
+  ASSERT_EQ(data, again.list.data());
+
+  // distinct workspace types do not share storage
+  auto& other = Portage::thread_workspace<SecondWorkspace>();
+  ASSERT_NE(static_cast<void*>(&workspace), static_cast<void*>(&other));
+  ASSERT_TRUE(other.list.empty());
+}
+
+TEST(Workspace, DistinctPerThread) {
+  auto& workspace = Portage::thread_workspace<FirstWorkspace>();
+  workspace.list.assign(10, 1);
+
+  FirstWorkspace* thread_ptr = nullptr;
+  std::size_t thread_size = 1;
+  std::thread thread([&]() {
+    auto& own = Portage::thread_workspace<FirstWorkspace>();
+    thread_ptr = &own;
+    thread_size = own.list.size();
+    own.list.assign(20, 3);
+  });
+  thread.join();
+
+  ASSERT_NE(&workspace, thread_ptr);
+  ASSERT_EQ(0u, thread_size);
+  ASSERT_EQ(10u, workspace.list.size());
+  ASSERT_EQ(1, workspace.list[0]);
+}
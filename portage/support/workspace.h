@@ -0,0 +1,47 @@
+/*
+This file is part of the Ristra portage project.
+Please see the license file at the root of this repository, or at:
+    https://github.com/laristra/portage/blob/master/LICENSE
+*/
+
+#ifndef PORTAGE_SUPPORT_WORKSPACE_H_
+#define PORTAGE_SUPPORT_WORKSPACE_H_
+
+/*!
+  @file workspace.h
+  @brief Per-thread scratch storage of entity functors.
+
+  Search, intersect and interpolate functors are called once per entity
+  from parallel loops, and used to build their temporary lists in local
+  vectors: every call then allocated and freed them, and all threads
+  went through the allocator for it.
+*/
+
+namespace Portage {
+
+/**
+ * @brief Scratch storage of the calling thread for a workspace type.
+ *
+ * A functor declares a workspace type gathering its temporary vectors
+ * and retrieves the instance of the calling thread on each call instead
+ * of declaring local vectors. Vectors keep their capacity from one call
+ * to the next, so that a thread stops allocating once it has processed
+ * its largest entity. Contents are left over from the previous call and
+ * must be cleared or overwritten before use.
+ *
+ * Each functor should declare its own workspace type so that no two
+ * functors share storage: a workspace must not be used by a nested call
+ * to a functor with the same workspace type.
+ *
+ * @tparam Workspace: the workspace type, default-constructible.
+ * @return the workspace of the calling thread.
+ */
+template<class Workspace>
+Workspace& thread_workspace() {
+  static thread_local Workspace workspace;
+  return workspace;
+}
+
+}  // namespace Portage
+
+#endif  // PORTAGE_SUPPORT_WORKSPACE_H_